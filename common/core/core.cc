@@ -273,6 +273,43 @@ Core::initiateMemoryAccess(UInt64 time,
    continueMemoryAccess(*memory_access_status);
 }
 
+bool
+Core::tryFastMemoryAccess(UInt64 time,
+                          MemComponent::component_t mem_component,
+                          lock_signal_t lock_signal,
+                          mem_op_t mem_op_type,
+                          IntPtr address,
+                          Byte* data_buffer,
+                          UInt32 bytes,
+                          bool modeled,
+                          UInt64& completion_time)
+{
+   // Atomic (locked) accesses take the event-driven path
+   if ((lock_signal != NONE) || (getMemoryManager() == NULL))
+      return false;
+
+   UInt32 cache_block_size = getMemoryManager()->getCacheBlockSize();
+   IntPtr address_aligned = (address / cache_block_size) * cache_block_size;
+   UInt32 offset = address - address_aligned;
+   if ((offset + bytes) > cache_block_size)
+      return false;
+
+   if (!getMemoryManager()->tryL1CacheAccess(time, mem_component, mem_op_type,
+                                             address_aligned, offset, data_buffer, bytes,
+                                             modeled, completion_time))
+   {
+      return false;
+   }
+
+   LOG_PRINT("Fast Memory Access [Core Id(%i), Time(%llu), Mem Component(%u), Mem Op Type(%u), Address(0x%llx), Bytes(%u), Completion Time(%llu)]",
+         m_core_id, time, mem_component, mem_op_type, address, bytes, completion_time);
+
+   // Same as completeMemoryAccess()
+   if (modeled)
+      getShmemPerfModel()->incrTotalMemoryAccessLatency(completion_time - time);
+   return true;
+}
+
 void
 Core::completeCacheAccess(UInt64 time, UInt32 memory_access_id)
 {
@@ -311,16 +348,16 @@ Core::continueMemoryAccess(MemoryAccessStatus& memory_access_status)
    // If it is a WRITE operation,
    // 'accessL1Cache' reads the data
    // from data_buffer
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << getMemoryManager()
-                 << memory_access_status._mem_component
-                 << memory_access_status._access_id
-                 << memory_access_status._lock_signal << memory_access_status._mem_op_type
-                 << address_aligned << offset
-                 << memory_access_status._data_buffer << memory_access_status._curr_bytes
-                 << memory_access_status._modeled;
-
-   EventInitiateCacheAccess* event = new EventInitiateCacheAccess(memory_access_status._curr_time, event_args);
+   EventInitiateCacheAccess* event = new EventInitiateCacheAccess(memory_access_status._curr_time,
+                                                                  getMemoryManager(),
+                                                                  memory_access_status._mem_component,
+                                                                  memory_access_status._access_id,
+                                                                  memory_access_status._lock_signal,
+                                                                  memory_access_status._mem_op_type,
+                                                                  address_aligned, offset,
+                                                                  memory_access_status._data_buffer,
+                                                                  memory_access_status._curr_bytes,
+                                                                  memory_access_status._modeled);
    Event::processInOrder(event, m_core_id, EventQueue::ORDERED);
 }
 
@@ -337,10 +374,8 @@ Core::completeMemoryAccess(MemoryAccessStatus& memory_access_status)
       
       getShmemPerfModel()->incrTotalMemoryAccessLatency(memory_latency);
       
-      UnstructuredBuffer* event_args = new UnstructuredBuffer();
-      (*event_args) << this << memory_access_status._access_id; 
       EventCompleteMemoryAccess* event = new EventCompleteMemoryAccess(memory_access_status._curr_time,
-                                                                       event_args);
+                                                                       this, memory_access_status._access_id);
       Event::processInOrder(event, m_core_id, EventQueue::ORDERED);
    }
 
@@ -68,6 +68,12 @@ public:
          lock_signal_t lock_signal, mem_op_t mem_op_type,
          IntPtr address, Byte* data_buffer, UInt32 bytes, bool modeled = false);
    void completeCacheAccess(UInt64 time, UInt32 memory_access_id);
+   // Models the access right away (without any events) if it is within a single cache line
+   // and hits in the L1 cache. Returns false (and changes nothing) otherwise
+   bool tryFastMemoryAccess(UInt64 time, MemComponent::component_t mem_component,
+         lock_signal_t lock_signal, mem_op_t mem_op_type,
+         IntPtr address, Byte* data_buffer, UInt32 bytes, bool modeled,
+         UInt64& completion_time);
 
    // network accessor since network is private
    int getId() { return m_core_id; }
@@ -10,16 +10,22 @@ Cache::Cache(string name,
       UInt32 cache_size,
       UInt32 associativity, UInt32 cache_block_size,
       string replacement_policy,
-      cache_t cache_type) :
+      cache_t cache_type,
+      bool data_modeled) :
       
    CacheBase(name, cache_size, associativity, cache_block_size),
    m_enabled(false),
-   m_cache_type(cache_type)
+   m_cache_type(cache_type),
+   m_data_modeled(data_modeled)
 {
+   m_set_dueling = (CacheSet::parsePolicyType(replacement_policy) == DRRIP) ?
+                   new RRIPSetDueling(m_num_sets) : NULL;
+
    m_sets = new CacheSet*[m_num_sets];
    for (UInt32 i = 0; i < m_num_sets; i++)
    {
-      m_sets[i] = CacheSet::createCacheSet(replacement_policy, m_cache_type, m_associativity, m_blocksize);
+      m_sets[i] = CacheSet::createCacheSet(replacement_policy, m_cache_type, m_associativity, m_blocksize, m_data_modeled,
+            i, m_set_dueling);
    }
 
    // Initialize Cache Counters
@@ -31,6 +37,7 @@ Cache::~Cache()
    for (SInt32 i = 0; i < (SInt32) m_num_sets; i++)
       delete m_sets[i];
    delete [] m_sets;
+   delete m_set_dueling;
 }
 
 bool 
@@ -24,7 +24,11 @@ class Cache : public CacheBase
 
       // Generic Cache Info
       cache_t m_cache_type;
+      // Timing-only caches keep the tags & state but not the data of the lines
+      bool m_data_modeled;
       CacheSet** m_sets;
+      // Shared by the sets with the DRRIP policy
+      RRIPSetDueling* m_set_dueling;
       
    public:
 
@@ -33,7 +37,8 @@ class Cache : public CacheBase
             UInt32 cache_size, 
             UInt32 associativity, UInt32 cache_block_size,
             std::string replacement_policy,
-            cache_t cache_type);
+            cache_t cache_type,
+            bool data_modeled);
       ~Cache();
 
       bool invalidateSingleLine(IntPtr addr);
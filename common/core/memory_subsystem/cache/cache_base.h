@@ -41,6 +41,10 @@ class CacheBase
       {
          ROUND_ROBIN = 0,
          LRU,
+         TREE_PLRU,
+         SRRIP,
+         BRRIP,
+         DRRIP,
          NUM_REPLACEMENT_POLICIES
       };
 
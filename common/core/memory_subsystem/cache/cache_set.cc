@@ -1,19 +1,24 @@
 #include "cache_set.h"
 #include "cache_base.h"
+#include "tag_search.h"
 #include "log.h"
 
 CacheSet::CacheSet(CacheBase::cache_t cache_type,
-      UInt32 associativity, UInt32 blocksize):
-      m_associativity(associativity), m_blocksize(blocksize)
+      UInt32 associativity, UInt32 blocksize, bool data_modeled):
+      m_blocks(NULL), m_associativity(associativity), m_blocksize(blocksize)
 {
    m_cache_block_info_array = new CacheBlockInfo*[m_associativity];
+   m_tags = new IntPtr[m_associativity];
    for (UInt32 i = 0; i < m_associativity; i++)
    {
       m_cache_block_info_array[i] = CacheBlockInfo::create(cache_type);
+      m_tags[i] = m_cache_block_info_array[i]->getTag();
+   }
+   if (data_modeled)
+   {
+      m_blocks = new char[m_associativity * m_blocksize];
+      memset(m_blocks, 0x00, m_associativity * m_blocksize);
    }
-   m_blocks = new char[m_associativity * m_blocksize];
-   
-   memset(m_blocks, 0x00, m_associativity * m_blocksize);
 }
 
 CacheSet::~CacheSet()
@@ -21,6 +26,7 @@ CacheSet::~CacheSet()
    for (UInt32 i = 0; i < m_associativity; i++)
       delete m_cache_block_info_array[i];
    delete [] m_cache_block_info_array;
+   delete [] m_tags;
    delete [] m_blocks;
 }
 
@@ -30,7 +36,7 @@ CacheSet::read_line(UInt32 line_index, UInt32 offset, Byte *out_buff, UInt32 byt
    assert(offset + bytes <= m_blocksize);
    assert((out_buff == NULL) == (bytes == 0));
 
-   if (out_buff != NULL)
+   if ((out_buff != NULL) && (m_blocks != NULL))
       memcpy((void*) out_buff, &m_blocks[line_index * m_blocksize + offset], bytes);
 
    updateReplacementIndex(line_index);
@@ -42,7 +48,7 @@ CacheSet::write_line(UInt32 line_index, UInt32 offset, Byte *in_buff, UInt32 byt
    assert(offset + bytes <= m_blocksize);
    assert((in_buff == NULL) == (bytes == 0));
 
-   if (in_buff != NULL)
+   if ((in_buff != NULL) && (m_blocks != NULL))
       memcpy(&m_blocks[line_index * m_blocksize + offset], (void*) in_buff, bytes);
 
    updateReplacementIndex(line_index);
@@ -51,38 +57,33 @@ CacheSet::write_line(UInt32 line_index, UInt32 offset, Byte *in_buff, UInt32 byt
 CacheBlockInfo* 
 CacheSet::find(IntPtr tag, UInt32* line_index)
 {
-   for (SInt32 index = m_associativity-1; index >= 0; index--)
-   {
-      if (m_cache_block_info_array[index]->getTag() == tag)
-      {
-         if (line_index != NULL)
-            *line_index = index;
-         return (m_cache_block_info_array[index]);
-      }
-   }
-   return NULL;
+   SInt32 index = findLastTag(m_tags, m_associativity, tag);
+   if (index < 0)
+      return NULL;
+
+   if (line_index != NULL)
+      *line_index = index;
+   return (m_cache_block_info_array[index]);
 }
 
 bool 
 CacheSet::invalidate(IntPtr& tag)
 {
-   for (SInt32 index = m_associativity-1; index >= 0; index--)
-   {
-      if (m_cache_block_info_array[index]->getTag() == tag)
-      {
-         m_cache_block_info_array[index]->invalidate();
-         return true;
-      }
-   }
-   return false;
+   SInt32 index = findLastTag(m_tags, m_associativity, tag);
+   if (index < 0)
+      return false;
+
+   m_cache_block_info_array[index]->invalidate();
+   m_tags[index] = m_cache_block_info_array[index]->getTag();
+   return true;
 }
 
 void 
 CacheSet::insert(CacheBlockInfo* cache_block_info, Byte* fill_buff, bool* eviction, CacheBlockInfo* evict_block_info, Byte* evict_buff)
 {
-   // This replacement strategy does not take into account the fact that
-   // cache blocks can be voluntarily flushed or invalidated due to another write request
-   const UInt32 index = getReplacementIndex();
+   // Fill an invalid (e.g., flushed or invalidated) way if there is one
+   SInt32 invalid_index = findFirstTag(m_tags, m_associativity, (IntPtr) ~0);
+   const UInt32 index = (invalid_index >= 0) ? ((UInt32) invalid_index) : getReplacementIndex();
    assert(index < m_associativity);
 
    assert(eviction != NULL);
@@ -92,7 +93,7 @@ CacheSet::insert(CacheBlockInfo* cache_block_info, Byte* fill_buff, bool* evicti
       *eviction = true;
       // FIXME: This is a hack. I dont know if this is the best way to do
       evict_block_info->clone(m_cache_block_info_array[index]);
-      if (evict_buff != NULL)
+      if ((evict_buff != NULL) && (m_blocks != NULL))
          memcpy((void*) evict_buff, &m_blocks[index * m_blocksize], m_blocksize);
    }
    else
@@ -102,24 +103,42 @@ CacheSet::insert(CacheBlockInfo* cache_block_info, Byte* fill_buff, bool* evicti
 
    // FIXME: This is a hack. I dont know if this is the best way to do
    m_cache_block_info_array[index]->clone(cache_block_info);
+   m_tags[index] = cache_block_info->getTag();
+   insertReplacementIndex(index);
    
-   if (fill_buff != NULL)
+   if ((fill_buff != NULL) && (m_blocks != NULL))
       memcpy(&m_blocks[index * m_blocksize], (void*) fill_buff, m_blocksize);
 }
 
 CacheSet* 
 CacheSet::createCacheSet (std::string replacement_policy,
       CacheBase::cache_t cache_type,
-      UInt32 associativity, UInt32 blocksize)
+      UInt32 associativity, UInt32 blocksize, bool data_modeled,
+      UInt32 set_index, RRIPSetDueling* set_dueling)
 {
    CacheBase::ReplacementPolicy policy = parsePolicyType(replacement_policy);
    switch(policy)
    {
       case CacheBase::ROUND_ROBIN:
-         return new CacheSetRoundRobin(cache_type, associativity, blocksize);
+         return new CacheSetRoundRobin(cache_type, associativity, blocksize, data_modeled);
 
       case CacheBase::LRU:
-         return new CacheSetLRU(cache_type, associativity, blocksize);
+         return new CacheSetLRU(cache_type, associativity, blocksize, data_modeled);
+
+      case CacheBase::TREE_PLRU:
+         return new CacheSetTreePLRU(cache_type, associativity, blocksize, data_modeled);
+
+      case CacheBase::SRRIP:
+         return new CacheSetRRIP(cache_type, associativity, blocksize, data_modeled,
+               CacheSetRRIP::SRRIP, set_index, NULL);
+
+      case CacheBase::BRRIP:
+         return new CacheSetRRIP(cache_type, associativity, blocksize, data_modeled,
+               CacheSetRRIP::BRRIP, set_index, NULL);
+
+      case CacheBase::DRRIP:
+         return new CacheSetRRIP(cache_type, associativity, blocksize, data_modeled,
+               CacheSetRRIP::DRRIP, set_index, set_dueling);
 
       default:
          LOG_PRINT_ERROR("Unrecognized Cache Replacement Policy: %i",
@@ -137,6 +156,14 @@ CacheSet::parsePolicyType(string policy)
       return CacheBase::ROUND_ROBIN;
    if (policy == "lru")
       return CacheBase::LRU;
+   if (policy == "tree_plru")
+      return CacheBase::TREE_PLRU;
+   if (policy == "srrip")
+      return CacheBase::SRRIP;
+   if (policy == "brrip")
+      return CacheBase::BRRIP;
+   if (policy == "drrip")
+      return CacheBase::DRRIP;
    else
       return (CacheBase::ReplacementPolicy) -1;
 }
@@ -7,16 +7,23 @@
 #include "cache_block_info.h"
 #include "cache_base.h"
 
+class RRIPSetDueling;
+
 // Everything related to cache sets
 class CacheSet
 {
    public:
       
-      static CacheSet* createCacheSet(std::string replacement_policy, CacheBase::cache_t cache_type, UInt32 associativity, UInt32 blocksize);
+      // 'set_dueling' is shared by the sets of a cache with the DRRIP policy (NULL otherwise)
+      static CacheSet* createCacheSet(std::string replacement_policy, CacheBase::cache_t cache_type, UInt32 associativity, UInt32 blocksize, bool data_modeled,
+            UInt32 set_index, RRIPSetDueling* set_dueling);
       static CacheBase::ReplacementPolicy parsePolicyType(std::string policy);
 
    protected:
       CacheBlockInfo** m_cache_block_info_array;
+      // Tags of the ways, packed for find() (same as the tags in m_cache_block_info_array)
+      IntPtr* m_tags;
+      // NULL if the data is not modeled (timing-only caches)
       char* m_blocks;
       UInt32 m_associativity;
       UInt32 m_blocksize;
@@ -24,7 +31,7 @@ class CacheSet
    public:
 
       CacheSet(CacheBase::cache_t cache_type,
-            UInt32 associativity, UInt32 blocksize);
+            UInt32 associativity, UInt32 blocksize, bool data_modeled);
       virtual ~CacheSet();
 
       UInt32 getBlockSize() { return m_blocksize; }
@@ -37,15 +44,19 @@ class CacheSet
       bool invalidate(IntPtr& tag);
       void insert(CacheBlockInfo* cache_block_info, Byte* fill_buff, bool* eviction, CacheBlockInfo* evict_block_info, Byte* evict_buff);
 
+      // Victim among the valid ways (insert() fills the invalid ways first)
       virtual UInt32 getReplacementIndex() = 0;
+      // On a hit
       virtual void updateReplacementIndex(UInt32) = 0;
+      // On a fill
+      virtual void insertReplacementIndex(UInt32 inserted_index) {}
 };
 
 class CacheSetRoundRobin : public CacheSet
 {
    public:
       CacheSetRoundRobin(CacheBase::cache_t cache_type, 
-            UInt32 associativity, UInt32 blocksize);
+            UInt32 associativity, UInt32 blocksize, bool data_modeled);
       ~CacheSetRoundRobin();
 
       UInt32 getReplacementIndex();
@@ -59,14 +70,102 @@ class CacheSetLRU : public CacheSet
 {
    public:
       CacheSetLRU(CacheBase::cache_t cache_type,
-            UInt32 associativity, UInt32 blocksize);
+            UInt32 associativity, UInt32 blocksize, bool data_modeled);
       ~CacheSetLRU();
 
       UInt32 getReplacementIndex();
       void updateReplacementIndex(UInt32 accessed_index);
 
    private:
-      UInt8* m_lru_bits;
+      // Recency list of the ways, from the MRU (head) to the LRU (tail) way
+      UInt8* m_lru_prev;
+      UInt8* m_lru_next;
+      UInt8 m_lru_head;
+      UInt8 m_lru_tail;
+};
+
+// Tree pseudo-LRU: one bit per node of a binary tree over the ways (power of 2, <= 64),
+// pointing to the half that holds the next victim
+class CacheSetTreePLRU : public CacheSet
+{
+   public:
+      CacheSetTreePLRU(CacheBase::cache_t cache_type,
+            UInt32 associativity, UInt32 blocksize, bool data_modeled);
+      ~CacheSetTreePLRU();
+
+      UInt32 getReplacementIndex();
+      void updateReplacementIndex(UInt32 accessed_index);
+
+   private:
+      UInt32 m_log_associativity;
+      // Bit 'n' is node 'n' (root = 1, children of 'n' = 2n, 2n+1); set means right
+      UInt64 m_plru_bits;
+};
+
+// Set dueling of DRRIP: a few leader sets always use SRRIP or BRRIP and count their
+// misses in a saturating counter (PSEL), which picks the policy of the other sets
+class RRIPSetDueling
+{
+   public:
+      enum Role
+      {
+         FOLLOWER = 0,
+         SRRIP_LEADER,
+         BRRIP_LEADER
+      };
+
+      RRIPSetDueling(UInt32 num_sets);
+      ~RRIPSetDueling() {}
+
+      Role getRole(UInt32 set_index);
+      void recordMiss(Role role);
+      bool isBRRIPSelected() { return (m_psel > (MAX_PSEL / 2)); }
+
+   private:
+      static const UInt32 NUM_LEADER_SETS = 32;
+      static const UInt32 MAX_PSEL = 1023;
+
+      // A SRRIP and a BRRIP leader set every 'm_leader_period' sets
+      UInt32 m_leader_period;
+      UInt32 m_psel;
+};
+
+// Re-Reference Interval Prediction with 2-bit RRPVs (Jaleel et al., ISCA 2010)
+// Re-references set the RRPV to 0 and the victim is a way with the max RRPV. SRRIP fills
+// with a 'long' interval (MAX_RRPV-1), BRRIP with a 'distant' one (MAX_RRPV) except
+// for every BRRIP_LONG_PERIOD'th fill. DRRIP picks one of them with set dueling
+class CacheSetRRIP : public CacheSet
+{
+   public:
+      enum InsertionPolicy
+      {
+         SRRIP = 0,
+         BRRIP,
+         DRRIP
+      };
+
+      CacheSetRRIP(CacheBase::cache_t cache_type,
+            UInt32 associativity, UInt32 blocksize, bool data_modeled,
+            InsertionPolicy insertion_policy,
+            UInt32 set_index, RRIPSetDueling* set_dueling);
+      ~CacheSetRRIP();
+
+      UInt32 getReplacementIndex();
+      void updateReplacementIndex(UInt32 accessed_index);
+      void insertReplacementIndex(UInt32 inserted_index);
+
+   private:
+      static const UInt8 MAX_RRPV = 3;
+      static const UInt32 BRRIP_LONG_PERIOD = 32;
+
+      UInt8* m_rrpv;
+      // The cache controllers access a line right after filling it: that access
+      // is part of the miss and is not a re-reference
+      bool* m_fill_access_pending;
+      InsertionPolicy m_insertion_policy;
+      RRIPSetDueling* m_set_dueling;
+      RRIPSetDueling::Role m_set_dueling_role;
+      UInt32 m_num_brrip_fills;
 };
 
 
@@ -3,42 +3,50 @@
 
 CacheSetLRU::CacheSetLRU(
       CacheBase::cache_t cache_type,
-      UInt32 associativity, UInt32 blocksize) :
-   CacheSet(cache_type, associativity, blocksize)
+      UInt32 associativity, UInt32 blocksize, bool data_modeled) :
+   CacheSet(cache_type, associativity, blocksize, data_modeled)
 {
-   m_lru_bits = new UInt8[m_associativity];
+   LOG_ASSERT_ERROR(m_associativity <= 256, "Associativity(%u) > 256", m_associativity);
+
+   // Way 0 is the MRU way, way (m_associativity-1) the LRU way
+   m_lru_prev = new UInt8[m_associativity];
+   m_lru_next = new UInt8[m_associativity];
    for (UInt32 i = 0; i < m_associativity; i++)
-      m_lru_bits[i] = i;
+   {
+      m_lru_prev[i] = i-1;
+      m_lru_next[i] = i+1;
+   }
+   m_lru_head = 0;
+   m_lru_tail = m_associativity-1;
 }
 
 CacheSetLRU::~CacheSetLRU()
 {
-   delete [] m_lru_bits;
+   delete [] m_lru_prev;
+   delete [] m_lru_next;
 }
 
 UInt32 
 CacheSetLRU::getReplacementIndex()
 {
-   // Invalidations may mess up the LRU bits
-   UInt32 index = m_associativity;
-   for (UInt32 i = 0; i < m_associativity; i++)
-   {
-      if (!m_cache_block_info_array[i]->isValid())
-         return i;
-      else if (m_lru_bits[i] == (m_associativity-1))
-         index = i;
-   }
-   LOG_ASSERT_ERROR(index < m_associativity, "Error Finding LRU bits");
-   return index;
+   return m_lru_tail;
 }
 
 void
 CacheSetLRU::updateReplacementIndex(UInt32 accessed_index)
 {
-   for (UInt32 i = 0; i < m_associativity; i++)
-   {
-      if (m_lru_bits[i] < m_lru_bits[accessed_index])
-         m_lru_bits[i] ++;
-   }
-   m_lru_bits[accessed_index] = 0;
+   if (accessed_index == m_lru_head)
+      return;
+
+   // Unlink the way (it is not the head) and make it the head
+   UInt8 prev = m_lru_prev[accessed_index];
+   if (accessed_index == m_lru_tail)
+      m_lru_tail = prev;
+   else
+      m_lru_prev[m_lru_next[accessed_index]] = prev;
+   m_lru_next[prev] = m_lru_next[accessed_index];
+
+   m_lru_next[accessed_index] = m_lru_head;
+   m_lru_prev[m_lru_head] = accessed_index;
+   m_lru_head = accessed_index;
 }
@@ -0,0 +1,137 @@
+#include "cache_set.h"
+#include "log.h"
+
+RRIPSetDueling::RRIPSetDueling(UInt32 num_sets):
+   m_psel(MAX_PSEL / 2)
+{
+   m_leader_period = num_sets / NUM_LEADER_SETS;
+   if (m_leader_period < 2)
+      m_leader_period = 2;
+}
+
+RRIPSetDueling::Role
+RRIPSetDueling::getRole(UInt32 set_index)
+{
+   UInt32 offset = set_index % m_leader_period;
+   if (offset == 0)
+      return SRRIP_LEADER;
+   else if (offset == (m_leader_period - 1))
+      return BRRIP_LEADER;
+   else
+      return FOLLOWER;
+}
+
+void
+RRIPSetDueling::recordMiss(Role role)
+{
+   // Misses in the SRRIP leaders vote for BRRIP and vice versa
+   if ((role == SRRIP_LEADER) && (m_psel < MAX_PSEL))
+      m_psel ++;
+   else if ((role == BRRIP_LEADER) && (m_psel > 0))
+      m_psel --;
+}
+
+CacheSetRRIP::CacheSetRRIP(
+      CacheBase::cache_t cache_type,
+      UInt32 associativity, UInt32 blocksize, bool data_modeled,
+      InsertionPolicy insertion_policy,
+      UInt32 set_index, RRIPSetDueling* set_dueling) :
+   CacheSet(cache_type, associativity, blocksize, data_modeled),
+   m_insertion_policy(insertion_policy),
+   m_set_dueling(set_dueling),
+   m_set_dueling_role(RRIPSetDueling::FOLLOWER),
+   m_num_brrip_fills(0)
+{
+   m_rrpv = new UInt8[m_associativity];
+   m_fill_access_pending = new bool[m_associativity];
+   for (UInt32 i = 0; i < m_associativity; i++)
+   {
+      m_rrpv[i] = MAX_RRPV;
+      m_fill_access_pending[i] = false;
+   }
+
+   if (m_insertion_policy == DRRIP)
+   {
+      LOG_ASSERT_ERROR(m_set_dueling != NULL, "No set dueling for DRRIP");
+      m_set_dueling_role = m_set_dueling->getRole(set_index);
+   }
+}
+
+CacheSetRRIP::~CacheSetRRIP()
+{
+   delete [] m_rrpv;
+   delete [] m_fill_access_pending;
+}
+
+UInt32
+CacheSetRRIP::getReplacementIndex()
+{
+   // Age all the ways until one of them has the max RRPV
+   UInt8 max_rrpv = 0;
+   for (UInt32 i = 0; i < m_associativity; i++)
+   {
+      if (m_rrpv[i] == MAX_RRPV)
+         return i;
+      if (m_rrpv[i] > max_rrpv)
+         max_rrpv = m_rrpv[i];
+   }
+
+   UInt8 age = MAX_RRPV - max_rrpv;
+   UInt32 index = m_associativity;
+   for (UInt32 i = 0; i < m_associativity; i++)
+   {
+      m_rrpv[i] += age;
+      if ((m_rrpv[i] == MAX_RRPV) && (index == m_associativity))
+         index = i;
+   }
+   return index;
+}
+
+void
+CacheSetRRIP::updateReplacementIndex(UInt32 accessed_index)
+{
+   if (m_fill_access_pending[accessed_index])
+      m_fill_access_pending[accessed_index] = false;
+   else
+      m_rrpv[accessed_index] = 0;
+}
+
+void
+CacheSetRRIP::insertReplacementIndex(UInt32 inserted_index)
+{
+   bool brrip;
+   switch (m_insertion_policy)
+   {
+      case SRRIP:
+         brrip = false;
+         break;
+
+      case BRRIP:
+         brrip = true;
+         break;
+
+      case DRRIP:
+         // Every fill is a miss
+         m_set_dueling->recordMiss(m_set_dueling_role);
+         if (m_set_dueling_role == RRIPSetDueling::SRRIP_LEADER)
+            brrip = false;
+         else if (m_set_dueling_role == RRIPSetDueling::BRRIP_LEADER)
+            brrip = true;
+         else
+            brrip = m_set_dueling->isBRRIPSelected();
+         break;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized RRIP Insertion Policy(%u)", m_insertion_policy);
+         brrip = false;
+         break;
+   }
+
+   // BRRIP inserts with a long interval once every BRRIP_LONG_PERIOD fills (deterministic,
+   // instead of with a probability, so that runs are repeatable)
+   if (brrip && ((++ m_num_brrip_fills) % BRRIP_LONG_PERIOD) != 0)
+      m_rrpv[inserted_index] = MAX_RRPV;
+   else
+      m_rrpv[inserted_index] = MAX_RRPV - 1;
+   m_fill_access_pending[inserted_index] = true;
+}
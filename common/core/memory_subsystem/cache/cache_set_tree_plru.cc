@@ -0,0 +1,43 @@
+#include "cache_set.h"
+#include "utils.h"
+#include "log.h"
+
+CacheSetTreePLRU::CacheSetTreePLRU(
+      CacheBase::cache_t cache_type,
+      UInt32 associativity, UInt32 blocksize, bool data_modeled) :
+   CacheSet(cache_type, associativity, blocksize, data_modeled),
+   m_plru_bits(0)
+{
+   LOG_ASSERT_ERROR(isPower2(m_associativity) && (m_associativity <= 64),
+         "Associativity(%u) should be a power of 2 and <= 64", m_associativity);
+   m_log_associativity = floorLog2(m_associativity);
+}
+
+CacheSetTreePLRU::~CacheSetTreePLRU()
+{}
+
+UInt32 
+CacheSetTreePLRU::getReplacementIndex()
+{
+   // Follow the bits from the root
+   UInt32 node = 1;
+   for (UInt32 level = 0; level < m_log_associativity; level++)
+      node = 2 * node + ((m_plru_bits >> node) & 1);
+   return node - m_associativity;
+}
+
+void
+CacheSetTreePLRU::updateReplacementIndex(UInt32 accessed_index)
+{
+   // Point the nodes on the path from the root away from the accessed way
+   UInt32 node = 1;
+   for (UInt32 level = m_log_associativity; level > 0; level--)
+   {
+      UInt32 right = (accessed_index >> (level-1)) & 1;
+      if (right)
+         m_plru_bits &= ~(((UInt64) 1) << node);
+      else
+         m_plru_bits |= (((UInt64) 1) << node);
+      node = 2 * node + right;
+   }
+}
@@ -51,6 +51,16 @@ class MemoryManager
       virtual void reInitiateCacheAccess(UInt64 time,
                                          MemComponent::component_t mem_component,
                                          MissStatus* miss_status) = 0;
+      // Synchronous access to a single cache line. If it hits in the L1 cache, the access
+      // is done right away (no events) and 'completion_time' is set. Otherwise, nothing is
+      // changed and false is returned (initiateCacheAccess() must be used instead)
+      virtual bool tryL1CacheAccess(UInt64 time,
+                                    MemComponent::component_t mem_component,
+                                    Core::mem_op_t mem_op_type,
+                                    IntPtr address, UInt32 offset,
+                                    Byte* data_buf, UInt32 data_length,
+                                    bool modeled,
+                                    UInt64& completion_time) = 0;
 
       virtual void handleMsgFromNetwork(NetPacket& packet) = 0;
 
@@ -2,6 +2,7 @@
 #include "memory_manager.h"
 #include "core.h"
 #include "clock_converter.h"
+#include "config.h"
 #include "log.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
@@ -22,13 +23,15 @@ DramCntlr::DramCntlr(MemoryManager* memory_manager,
          dram_bandwidth,
          dram_queue_model_enabled);
 
-   m_dram_access_count = new AccessCountMap[NUM_ACCESS_TYPES];
+   for (UInt32 k = 0; k < NUM_ACCESS_TYPES; k++)
+      m_dram_access_profile[k] = AddressProfile::create();
 }
 
 DramCntlr::~DramCntlr()
 {
    printDramAccessCount();
-   delete [] m_dram_access_count;
+   for (UInt32 k = 0; k < NUM_ACCESS_TYPES; k++)
+      delete m_dram_access_profile[k];
 
    delete m_dram_perf_model;
 }
@@ -36,12 +39,16 @@ DramCntlr::~DramCntlr()
 void
 DramCntlr::getDataFromDram(IntPtr address, core_id_t requester, Byte* data_buf)
 {
-   if (m_data_map[address] == NULL)
+   // Timing-only caches: there is no data to keep
+   if (Config::getSingleton()->isCacheDataModeled())
    {
-      m_data_map[address] = new Byte[getCacheBlockSize()];
-      memset((void*) m_data_map[address], 0x00, getCacheBlockSize());
+      if (m_data_map[address] == NULL)
+      {
+         m_data_map[address] = new Byte[getCacheBlockSize()];
+         memset((void*) m_data_map[address], 0x00, getCacheBlockSize());
+      }
+      memcpy((void*) data_buf, (void*) m_data_map[address], getCacheBlockSize());
    }
-   memcpy((void*) data_buf, (void*) m_data_map[address], getCacheBlockSize());
 
    UInt64 dram_access_latency = runDramPerfModel(requester);
    getShmemPerfModel()->incrCycleCount(dram_access_latency);
@@ -52,11 +59,14 @@ DramCntlr::getDataFromDram(IntPtr address, core_id_t requester, Byte* data_buf)
 void
 DramCntlr::putDataToDram(IntPtr address, core_id_t requester, Byte* data_buf)
 {
-   if (m_data_map[address] == NULL)
+   if (Config::getSingleton()->isCacheDataModeled())
    {
-      LOG_PRINT_ERROR("Data Buffer does not exist");
+      if (m_data_map[address] == NULL)
+      {
+         LOG_PRINT_ERROR("Data Buffer does not exist");
+      }
+      memcpy((void*) m_data_map[address], (void*) data_buf, getCacheBlockSize());
    }
-   memcpy((void*) m_data_map[address], (void*) data_buf, getCacheBlockSize());
 
    runDramPerfModel(requester);
    
@@ -80,7 +90,8 @@ DramCntlr::runDramPerfModel(core_id_t requester)
 void
 DramCntlr::addToDramAccessCount(IntPtr address, access_t access_type)
 {
-   m_dram_access_count[access_type][address] = m_dram_access_count[access_type][address] + 1;
+   if (m_dram_access_profile[access_type])
+      m_dram_access_profile[access_type]->record(address);
 }
 
 void
@@ -88,7 +99,13 @@ DramCntlr::printDramAccessCount()
 {
    for (UInt32 k = 0; k < NUM_ACCESS_TYPES; k++)
    {
-      for (AccessCountMap::iterator i = m_dram_access_count[k].begin(); i != m_dram_access_count[k].end(); i++)
+      if (!m_dram_access_profile[k])
+         continue;
+
+      // Most accessed addresses, with estimated counts
+      vector<pair<IntPtr,UInt64> > top_address_list;
+      m_dram_access_profile[k]->getTopAddresses(top_address_list);
+      for (vector<pair<IntPtr,UInt64> >::iterator i = top_address_list.begin(); i != top_address_list.end(); i++)
       {
          if ((*i).second > 100)
          {
@@ -11,6 +11,7 @@ namespace PrL1PrL2DramDirectoryMOSI
 #include "dram_perf_model.h"
 #include "shmem_perf_model.h"
 #include "shmem_msg.h"
+#include "address_profile.h"
 #include "fixed_types.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
@@ -32,8 +33,8 @@ namespace PrL1PrL2DramDirectoryMOSI
          UInt32 m_cache_block_size;
          ShmemPerfModel* m_shmem_perf_model;
 
-         typedef std::map<IntPtr,UInt64> AccessCountMap;
-         AccessCountMap* m_dram_access_count;
+         // Address profiling ([address_profile] in the cfg file), NULL if disabled
+         AddressProfile* m_dram_access_profile[NUM_ACCESS_TYPES];
 
          UInt32 getCacheBlockSize() { return m_cache_block_size; }
          MemoryManager* getMemoryManager() { return m_memory_manager; }
@@ -11,10 +11,9 @@ using namespace std;
 #include "simulator.h"
 #include "config.h"
 #include "log.h"
+#include "tag_search.h"
 #include "utils.h"
 
-#define DETAILED_TRACKING_ENABLED    1
-
 namespace PrL1PrL2DramDirectoryMOSI
 {
 
@@ -40,6 +39,9 @@ DramDirectoryCache::DramDirectoryCache(
    
    // Instantiate the directory
    m_directory = new Directory(directory_type_str, total_entries, max_hw_sharers, max_num_sharers);
+   m_address_list.resize(m_total_entries);
+   for (UInt32 i = 0; i < m_total_entries; i++)
+      m_address_list[i] = m_directory->getDirectoryEntry(i)->getAddress();
 
    initializeParameters(num_dram_cntlrs);
    
@@ -50,6 +52,8 @@ DramDirectoryCache::DramDirectoryCache(
 
 DramDirectoryCache::~DramDirectoryCache()
 {
+   delete m_address_profile;
+   delete m_replaced_address_profile;
    delete m_directory;
 }
 
@@ -68,10 +72,13 @@ DramDirectoryCache::initializeParameters(UInt32 num_dram_cntlrs)
    LOG_ASSERT_ERROR(isPower2(stack_size), "stack_size(%#llx) should be a power of 2", stack_size);
    m_log_stack_size = floorLog2(stack_size);
    
-#ifdef DETAILED_TRACKING_ENABLED
-   m_set_specific_address_map.resize(m_num_sets);
-   m_set_replacement_histogram.resize(m_num_sets);
-#endif
+   m_address_profile = AddressProfile::create();
+   m_replaced_address_profile = AddressProfile::create();
+   if (m_address_profile)
+   {
+      m_set_access_histogram.resize(m_num_sets);
+      m_set_replacement_histogram.resize(m_num_sets);
+   }
 }
 
 DirectoryEntry*
@@ -85,42 +92,40 @@ DramDirectoryCache::getDirectoryEntry(IntPtr address)
    
    // Assume that it always hit in the Dram Directory Cache for now
    splitAddress(address, tag, set_index);
+
+   if (m_address_profile)
+   {
+      m_address_profile->record(address);
+      m_set_access_histogram[set_index] ++;
+   }
    
    // Find the relevant directory entry
-   for (UInt32 i = 0; i < m_associativity; i++)
+   UInt32 set_start = set_index * m_associativity;
+   SInt32 index = findFirstTag(&m_address_list[set_start], m_associativity, address);
+   if (index >= 0)
    {
-      DirectoryEntry* directory_entry = m_directory->getDirectoryEntry(set_index * m_associativity + i);
-
-      if (directory_entry->getAddress() == address)
-      {
-         if (m_shmem_perf_model)
-            getShmemPerfModel()->incrCycleCount(directory_entry->getLatency());
-         // Simple check for now. Make sophisticated later
-         return directory_entry;
-      }
+      DirectoryEntry* directory_entry = m_directory->getDirectoryEntry(set_start + index);
+      if (m_shmem_perf_model)
+         getShmemPerfModel()->incrCycleCount(directory_entry->getLatency());
+      // Simple check for now. Make sophisticated later
+      return directory_entry;
    }
 
    // Find a free directory entry if one does not currently exist
-   for (UInt32 i = 0; i < m_associativity; i++)
+   index = findFirstTag(&m_address_list[set_start], m_associativity, INVALID_ADDRESS);
+   if (index >= 0)
    {
-      DirectoryEntry* directory_entry = m_directory->getDirectoryEntry(set_index * m_associativity + i);
-      if (directory_entry->getAddress() == INVALID_ADDRESS)
-      {
-         // Simple check for now. Make sophisticated later
-         directory_entry->setAddress(address);
-         return directory_entry;
-      }
+      DirectoryEntry* directory_entry = m_directory->getDirectoryEntry(set_start + index);
+      // Simple check for now. Make sophisticated later
+      directory_entry->setAddress(address);
+      m_address_list[set_start + index] = address;
+      return directory_entry;
    }
 
-   // Check in the m_replaced_directory_entry_list
-   vector<DirectoryEntry*>::iterator it;
-   for (it = m_replaced_directory_entry_list.begin(); it != m_replaced_directory_entry_list.end(); it++)
-   {
-      if ((*it)->getAddress() == address)
-      {
-         return (*it);
-      } 
-   }
+   // Check in the m_replaced_directory_entry_map
+   DirectoryEntry** replaced_directory_entry = m_replaced_directory_entry_map.find(address);
+   if (replaced_directory_entry)
+      return *replaced_directory_entry;
 
    return (DirectoryEntry*) NULL;
 }
@@ -150,47 +155,40 @@ DramDirectoryCache::replaceDirectoryEntry(IntPtr replaced_address, IntPtr addres
    UInt32 set_index;
    splitAddress(replaced_address, tag, set_index);
 
-   for (UInt32 i = 0; i < m_associativity; i++)
-   {
-      DirectoryEntry* replaced_directory_entry = m_directory->getDirectoryEntry(set_index * m_associativity + i);
-      if (replaced_directory_entry->getAddress() == replaced_address)
-      {
-         m_replaced_directory_entry_list.push_back(replaced_directory_entry);
+   UInt32 set_start = set_index * m_associativity;
+   SInt32 index = findFirstTag(&m_address_list[set_start], m_associativity, replaced_address);
+   // Should not happen
+   assert(index >= 0);
 
-         DirectoryEntry* directory_entry = m_directory->createDirectoryEntry();
-         directory_entry->setAddress(address);
-         m_directory->setDirectoryEntry(set_index * m_associativity + i, directory_entry);
+   DirectoryEntry* replaced_directory_entry = m_directory->getDirectoryEntry(set_start + index);
+   // Requests for 'replaced_address' wait for the entry to be nullified,
+   // so it can not be replaced again in the meantime
+   if (!m_replaced_directory_entry_map.insert(replaced_address, replaced_directory_entry))
+      LOG_PRINT_ERROR("Directory entry of address(%#llx) already replaced", replaced_address);
 
-#ifdef DETAILED_TRACKING_ENABLED
-         m_replaced_address_map[replaced_address] ++;
-         m_set_replacement_histogram[set_index] ++;
-#endif
+   DirectoryEntry* directory_entry = m_directory->createDirectoryEntry();
+   directory_entry->setAddress(address);
+   m_directory->setDirectoryEntry(set_start + index, directory_entry);
+   m_address_list[set_start + index] = address;
 
-         return directory_entry;
-      }
+   if (m_replaced_address_profile)
+   {
+      m_replaced_address_profile->record(replaced_address);
+      m_set_replacement_histogram[set_index] ++;
    }
 
-   // Should not reach here
-   assert(false);
+   return directory_entry;
 }
 
 void
 DramDirectoryCache::invalidateDirectoryEntry(IntPtr address)
 {
-   vector<DirectoryEntry*>::iterator it;
-   for (it = m_replaced_directory_entry_list.begin(); it != m_replaced_directory_entry_list.end(); it++)
-   {
-      if ((*it)->getAddress() == address)
-      {
-         delete (*it);
-         m_replaced_directory_entry_list.erase(it);
-
-         return;
-      }
-   }
+   DirectoryEntry** replaced_directory_entry = m_replaced_directory_entry_map.find(address);
+   // Should not happen
+   assert(replaced_directory_entry);
 
-   // Should not reach here
-   assert(false);
+   delete *replaced_directory_entry;
+   m_replaced_directory_entry_map.erase(address);
 }
 
 void
@@ -200,11 +198,6 @@ DramDirectoryCache::splitAddress(IntPtr address, IntPtr& tag, UInt32& set_index)
 
    tag = cache_block_address;
    set_index = computeSetIndex(address);
-  
-#ifdef DETAILED_TRACKING_ENABLED 
-   m_address_map[address] ++;
-   m_set_specific_address_map[set_index][address] ++;
-#endif
 }
 
 IntPtr
@@ -266,46 +259,32 @@ DramDirectoryCache::outputSummary(ostream& out)
       }
    }
 
-#ifdef DETAILED_TRACKING_ENABLED
-   /*
-   core_id_t core_id = m_memory_manager->getCore()->getId();
-   string output_dir = Sim()->getCfg()->getString("general/output_dir", "./output_files/");
-
-   ostringstream filename;
-   filename << output_dir << "/address_set_" << core_id;
-   ofstream address_set_file(filename.str().c_str());
-
-   for (map<IntPtr,UInt64>::iterator it = m_address_map.begin(); \
-         it != m_address_map.end(); it++)
-      address_set_file << setfill(' ') << setw(20) << left << hex << (*it).first << dec
-         << setw(10) << left << (*it).second << "\n";
-   address_set_file.close();
-    */
+   if (!m_address_profile)
+      return;
 
-   UInt32 max_set_size = 0;
-   UInt32 min_set_size = 100000000;
-   SInt32 set_index_with_max_size = -1;
-   SInt32 set_index_with_min_size = -1;
+   UInt64 total_accesses = 0;
+   UInt64 max_set_accesses = 0;
+   UInt64 min_set_accesses = UINT64_MAX_;
+   SInt32 set_index_with_max_accesses = -1;
+   SInt32 set_index_with_min_accesses = -1;
 
    UInt64 total_evictions = 0;
    UInt64 max_set_evictions = 0;
    SInt32 set_index_with_max_evictions = -1;
 
-   UInt64 max_address_evictions = 0;
-   IntPtr address_with_max_evictions = INVALID_ADDRESS;
-   
    for (UInt32 i = 0; i < m_num_sets; i++)
    {
-      // max, min, average set size, set evictions
-      if (m_set_specific_address_map[i].size() > max_set_size)
+      // max, min, average set accesses, set evictions
+      total_accesses += m_set_access_histogram[i];
+      if (m_set_access_histogram[i] > max_set_accesses)
       {
-         max_set_size = m_set_specific_address_map[i].size();
-         set_index_with_max_size = i;
+         max_set_accesses = m_set_access_histogram[i];
+         set_index_with_max_accesses = i;
       }
-      if (m_set_specific_address_map[i].size() < min_set_size)
+      if (m_set_access_histogram[i] < min_set_accesses)
       {
-         min_set_size = m_set_specific_address_map[i].size();
-         set_index_with_min_size = i;
+         min_set_accesses = m_set_access_histogram[i];
+         set_index_with_min_accesses = i;
       }
       if (m_set_replacement_histogram[i] > max_set_evictions)
       {
@@ -315,27 +294,28 @@ DramDirectoryCache::outputSummary(ostream& out)
       total_evictions += m_set_replacement_histogram[i];
    }
 
-   for (map<IntPtr,UInt64>::iterator it = m_replaced_address_map.begin(); \
-         it != m_replaced_address_map.end(); it++)
+   vector<pair<IntPtr,UInt64> > top_address_list;
+   m_replaced_address_profile->getTopAddresses(top_address_list);
+   UInt64 max_address_evictions = 0;
+   IntPtr address_with_max_evictions = INVALID_ADDRESS;
+   if (!top_address_list.empty())
    {
-      if ((*it).second > max_address_evictions)
-      {
-         max_address_evictions = (*it).second;
-         address_with_max_evictions = (*it).first;
-      }
+      address_with_max_evictions = top_address_list.front().first;
+      max_address_evictions = top_address_list.front().second;
    }
 
-   // Total Number of Addresses
-   // Max Set Size, Average Set Size, Min Set Size
-   // Evictions: Average per set, Max, Address with max evictions
+   // Total Number of Addresses (estimated)
+   // Max Set Accesses, Average Set Accesses, Min Set Accesses
+   // Evictions: Average per set, Max, Address with max evictions (estimated)
+   // Most accessed addresses (estimated)
    out << "Dram Directory Cache: " << endl;
-   out << "    Total Addresses: " << m_address_map.size() << endl;
+   out << "    Total Addresses: " << m_address_profile->getNumDistinctAddresses() << endl;
 
-   out << "    Average set size: " << float(m_address_map.size()) / m_num_sets << endl;
-   out << "    Set index with max size: " << set_index_with_max_size << endl;
-   out << "    Max set size: " << max_set_size << endl;
-   out << "    Set index with min size: " << set_index_with_min_size << endl;
-   out << "    Min set size: " << min_set_size << endl;
+   out << "    Average set accesses: " << float(total_accesses) / m_num_sets << endl;
+   out << "    Set index with max accesses: " << set_index_with_max_accesses << endl;
+   out << "    Max set accesses: " << max_set_accesses << endl;
+   out << "    Set index with min accesses: " << set_index_with_min_accesses << endl;
+   out << "    Min set accesses: " << min_set_accesses << endl;
 
    out << "    Average evictions per set: " << float(total_evictions) / m_num_sets << endl;
    out << "    Set index with max evictions: " << set_index_with_max_evictions << endl;
@@ -343,21 +323,34 @@ DramDirectoryCache::outputSummary(ostream& out)
    
    out << "    Address with max evictions: 0x" << hex << address_with_max_evictions << dec << endl;
    out << "    Max address evictions: " << max_address_evictions << endl;
-#endif
+
+   // Every core prints the same rows (see formatSummaries()), so the unused entries are NA
+   m_address_profile->getTopAddresses(top_address_list);
+   UInt32 num_top_addresses = AddressProfile::getCfgNumTopAddresses();
+   for (UInt32 i = 0; i < num_top_addresses; i++)
+   {
+      out << "    Top address " << i << " (accesses): ";
+      if (i < top_address_list.size())
+         out << "0x" << hex << top_address_list[i].first << dec << " (" << top_address_list[i].second << ")" << endl;
+      else
+         out << "NA" << endl;
+   }
 }
 
 void
 DramDirectoryCache::dummyOutputSummary(ostream& out)
 {
-#ifdef DETAILED_TRACKING_ENABLED
+   if (!AddressProfile::isEnabled())
+      return;
+
    out << "Dram Directory Cache: " << endl;
    out << "    Total Addresses: NA" << endl;
 
-   out << "    Average set size: NA" << endl;
-   out << "    Set index with max size: NA" << endl;
-   out << "    Max set size: NA" << endl;
-   out << "    Set index with min size: NA" << endl;
-   out << "    Min set size: NA" << endl;
+   out << "    Average set accesses: NA" << endl;
+   out << "    Set index with max accesses: NA" << endl;
+   out << "    Max set accesses: NA" << endl;
+   out << "    Set index with min accesses: NA" << endl;
+   out << "    Min set accesses: NA" << endl;
 
    out << "    Average evictions per set: NA" << endl;
    out << "    Set index with max evictions: NA" << endl;
@@ -365,7 +358,10 @@ DramDirectoryCache::dummyOutputSummary(ostream& out)
    
    out << "    Address with max evictions: NA" << endl;
    out << "    Max address evictions: NA" << endl;
-#endif
+
+   UInt32 num_top_addresses = AddressProfile::getCfgNumTopAddresses();
+   for (UInt32 i = 0; i < num_top_addresses; i++)
+      out << "    Top address " << i << " (accesses): NA" << endl;
 }
 
 }
@@ -974,7 +974,9 @@ DramDirectoryCntlr::DataList::insert(IntPtr address, Byte* data)
    if (ret.second == false)
    {
       // There is already some data present
-      SInt32 equal = memcmp(alloc_data, (ret.first)->second, m_block_size);
+      // Timing-only caches do not keep the data of the lines
+      SInt32 equal = Config::getSingleton()->isCacheDataModeled() ?
+                     memcmp(alloc_data, (ret.first)->second, m_block_size) : 0;
       LOG_ASSERT_ERROR(equal == 0, "Address(0x%x), cached data different from now received data");
       delete [] alloc_data;
    }
@@ -1,6 +1,7 @@
 #include "l1_cache_cntlr.h"
 #include "l2_cache_cntlr.h" 
 #include "memory_manager.h"
+#include "config.h"
 #include "event.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
@@ -25,13 +26,15 @@ L1CacheCntlr::L1CacheCntlr(core_id_t core_id,
          l1_icache_associativity, 
          m_cache_block_size,
          l1_icache_replacement_policy,
-         CacheBase::PR_L1_CACHE);
+         CacheBase::PR_L1_CACHE,
+         Config::getSingleton()->isCacheDataModeled());
    m_l1_dcache = new Cache("L1-D",
          l1_dcache_size,
          l1_dcache_associativity, 
          m_cache_block_size,
          l1_dcache_replacement_policy,
-         CacheBase::PR_L1_CACHE);
+         CacheBase::PR_L1_CACHE,
+         Config::getSingleton()->isCacheDataModeled());
 
    initializeMissStatusMaps();
 }
@@ -197,10 +200,8 @@ L1CacheCntlr::reprocessMemOpFromCore(
 void
 L1CacheCntlr::completeMemOpFromCore(UInt32 memory_access_id)
 {
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << getMemoryManager()->getCore() << memory_access_id; 
    EventCompleteCacheAccess* event = new EventCompleteCacheAccess(getShmemPerfModel()->getCycleCount(),
-                                                                  event_args);
+                                                                  getMemoryManager()->getCore(), memory_access_id);
    Event::processInOrder(event, getMemoryManager()->getCore()->getId(), EventQueue::ORDERED);
 }
 
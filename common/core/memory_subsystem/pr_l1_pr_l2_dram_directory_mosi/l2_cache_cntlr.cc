@@ -2,6 +2,7 @@
 #include "l2_cache_cntlr.h"
 #include "log.h"
 #include "memory_manager.h"
+#include "config.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -26,7 +27,8 @@ L2CacheCntlr::L2CacheCntlr(core_id_t core_id,
          l2_cache_associativity, 
          m_cache_block_size, 
          l2_cache_replacement_policy, 
-         CacheBase::PR_L2_CACHE);
+         CacheBase::PR_L2_CACHE,
+         Config::getSingleton()->isCacheDataModeled());
 }
 
 L2CacheCntlr::~L2CacheCntlr()
@@ -2,6 +2,7 @@
 #include "cache_base.h"
 #include "simulator.h"
 #include "clock_converter.h"
+#include "net_packet_buffer.h"
 #include "network.h"
 #include "log.h"
 
@@ -315,7 +316,9 @@ MemoryManager::sendMsg(core_id_t receiver, ShmemMsg& shmem_msg)
 {
    assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
+   // The message is written directly into the payload shared by the packets sent
+   Byte* msg_buf = NetPacketBuffer::allocate(shmem_msg.getMsgLen());
+   shmem_msg.makeMsgBuf(msg_buf);
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    if (m_enabled)
@@ -328,10 +331,11 @@ MemoryManager::sendMsg(core_id_t receiver, ShmemMsg& shmem_msg)
    NetPacket packet(msg_time, packet_type,
          getCore()->getId(), receiver,
          shmem_msg.getMsgLen(), (const void*) msg_buf);
+   packet.shared_data = true;
    getNetwork()->netSend(packet);
 
-   // Delete the Msg Buf
-   delete [] msg_buf;
+   // Release the Msg Buf
+   NetPacketBuffer::release(msg_buf);
 }
 
 void
@@ -339,7 +343,9 @@ MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
 {
    assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
+   // The message is written directly into the payload shared by the packets sent
+   Byte* msg_buf = NetPacketBuffer::allocate(shmem_msg.getMsgLen());
+   shmem_msg.makeMsgBuf(msg_buf);
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    if (m_enabled)
@@ -352,10 +358,11 @@ MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
    NetPacket packet(msg_time, packet_type,
          getCore()->getId(), NetPacket::BROADCAST,
          shmem_msg.getMsgLen(), (const void*) msg_buf);
+   packet.shared_data = true;
    getNetwork()->netSend(packet);
 
-   // Delete the Msg Buf
-   delete [] msg_buf;
+   // Release the Msg Buf
+   NetPacketBuffer::release(msg_buf);
 }
 
 PacketType
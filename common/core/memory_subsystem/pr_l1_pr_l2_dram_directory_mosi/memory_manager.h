@@ -70,6 +70,15 @@ namespace PrL1PrL2DramDirectoryMOSI
          void reInitiateCacheAccess(UInt64 time,
                                     MemComponent::component_t mem_component,
                                     MissStatus* miss_status);
+         // Not implemented for this protocol: all accesses go through initiateCacheAccess()
+         bool tryL1CacheAccess(UInt64 time,
+                               MemComponent::component_t mem_component,
+                               Core::mem_op_t mem_op_type,
+                               IntPtr address, UInt32 offset,
+                               Byte* data_buf, UInt32 data_length,
+                               bool modeled,
+                               UInt64& completion_time)
+         { return false; }
 
          void handleMsgFromNetwork(NetPacket& packet);
 
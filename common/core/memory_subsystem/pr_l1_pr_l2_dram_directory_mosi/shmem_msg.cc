@@ -72,18 +72,16 @@ namespace PrL1PrL2DramDirectoryMOSI
       return shmem_msg;
    }
 
-   Byte*
-   ShmemMsg::makeMsgBuf()
+   // Writes the message into 'msg_buf' (getMsgLen() bytes)
+   void
+   ShmemMsg::makeMsgBuf(Byte* msg_buf)
    {
-      Byte* msg_buf = new Byte[getMsgLen()];
       memcpy(msg_buf, (void*) this, sizeof(*this));
       if (m_data_length > 0)
       {
          LOG_ASSERT_ERROR(m_data_buf != NULL, "m_data_buf(%p)", m_data_buf);
          memcpy(msg_buf + sizeof(*this), (void*) m_data_buf, m_data_length); 
       }
-
-      return msg_buf; 
    }
 
    UInt32
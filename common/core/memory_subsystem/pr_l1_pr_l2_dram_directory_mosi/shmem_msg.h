@@ -58,7 +58,7 @@ namespace PrL1PrL2DramDirectoryMOSI
 
          void clone(ShmemMsg* shmem_msg);
          static ShmemMsg* getShmemMsg(Byte* msg_buf);
-         Byte* makeMsgBuf();
+         void makeMsgBuf(Byte* msg_buf);
          UInt32 getMsgLen();
 
          // Modeled Parameters
@@ -11,6 +11,7 @@ namespace PrL1PrL2DramDirectoryMSI
 #include "dram_perf_model.h"
 #include "shmem_perf_model.h"
 #include "shmem_msg.h"
+#include "address_profile.h"
 #include "fixed_types.h"
 
 namespace PrL1PrL2DramDirectoryMSI
@@ -30,8 +31,8 @@ namespace PrL1PrL2DramDirectoryMSI
          std::map<IntPtr, Byte*> m_data_map;
          DramPerfModel* m_dram_perf_model;
 
-         typedef std::map<IntPtr,UInt64> AccessCountMap;
-         AccessCountMap* m_dram_access_count;
+         // Address profiling ([address_profile] in the cfg file), NULL if disabled
+         AddressProfile* m_dram_access_profile[NUM_ACCESS_TYPES];
 
          // Get/Put Data From/To Dram
          void getDataFromDram(core_id_t sender, ShmemMsg* shmem_msg);
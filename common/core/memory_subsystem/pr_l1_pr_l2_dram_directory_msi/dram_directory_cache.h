@@ -13,6 +13,8 @@ namespace PrL1PrL2DramDirectoryMSI
 
 #include "directory.h"
 #include "shmem_perf_model.h"
+#include "address_profile.h"
+#include "address_hash_map.h"
 
 namespace PrL1PrL2DramDirectoryMSI
 {
@@ -21,11 +23,15 @@ namespace PrL1PrL2DramDirectoryMSI
    private:
       MemoryManager* m_memory_manager;
       Directory* m_directory;
-      std::vector<DirectoryEntry*> m_replaced_directory_entry_list;
+      // Addresses of the directory entries, packed for the lookups
+      std::vector<IntPtr> m_address_list;
+      // Replaced entries, until their address is nullified in the caches
+      AddressHashMap<DirectoryEntry*> m_replaced_directory_entry_map;
       
-      std::map<IntPtr,UInt64> m_address_map;
-      std::vector<std::map<IntPtr,UInt64> > m_set_specific_address_map;
-      std::map<IntPtr,UInt64> m_replaced_address_map;
+      // Address profiling ([address_profile] in the cfg file), NULL if disabled
+      AddressProfile* m_address_profile;
+      AddressProfile* m_replaced_address_profile;
+      std::vector<UInt64> m_set_access_histogram;
       std::vector<UInt64> m_set_replacement_histogram;
 
       UInt32 m_total_entries;
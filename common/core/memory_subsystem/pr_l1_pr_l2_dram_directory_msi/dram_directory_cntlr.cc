@@ -68,11 +68,10 @@ DramDirectoryCntlr::unregisterEventHandlers()
 void
 scheduleNextDramDirectoryAccessReqFromL2Cache(Event* event)
 {
-   UnstructuredBuffer* event_args = event->getArgs();
+   const DramDirectoryNextReqArgs& event_args = TypedEvent<DramDirectoryNextReqArgs>::getTypedArgs(event);
 
-   DramDirectoryCntlr* dram_directory_cntlr;
-   IntPtr address;
-   (*event_args) >> dram_directory_cntlr >> address;
+   DramDirectoryCntlr* dram_directory_cntlr = event_args._dram_directory_cntlr;
+   IntPtr address = event_args._address;
 
    // Set the Time Correctly
    dram_directory_cntlr->getShmemPerfModel()->setCycleCount(event->getTime());
@@ -84,11 +83,10 @@ scheduleNextDramDirectoryAccessReqFromL2Cache(Event* event)
 void
 handleNextDramDirectoryAccessReqFromL2Cache(Event* event)
 {
-   UnstructuredBuffer* event_args = event->getArgs();
+   const DramDirectoryNextReqArgs& event_args = TypedEvent<DramDirectoryNextReqArgs>::getTypedArgs(event);
 
-   DramDirectoryCntlr* dram_directory_cntlr;
-   IntPtr address;
-   (*event_args) >> dram_directory_cntlr >> address;
+   DramDirectoryCntlr* dram_directory_cntlr = event_args._dram_directory_cntlr;
+   IntPtr address = event_args._address;
 
    // Set the Time Correctly
    dram_directory_cntlr->getShmemPerfModel()->setCycleCount(event->getTime());
@@ -115,9 +113,8 @@ DramDirectoryCntlr::scheduleNextReqFromL2Cache(IntPtr address)
       UInt64 time = getShmemPerfModel()->getCycleCount();
       LOG_PRINT("scheduleNextReqFromL2Cache(Time[%llu], Address[0x%llx])", time, address);
 
-      UnstructuredBuffer* event_args = new UnstructuredBuffer();
-      (*event_args) << this << address;
-      Event* event = new Event((Event::Type) DRAM_DIRECTORY_SCHEDULE_NEXT_REQ_FROM_L2_CACHE, time, event_args);
+      Event* event = new TypedEvent<DramDirectoryNextReqArgs>(DRAM_DIRECTORY_SCHEDULE_NEXT_REQ_FROM_L2_CACHE, time,
+            DramDirectoryNextReqArgs(this, address));
       Event::processInOrder(event, getCoreId(), EventQueue::ORDERED);
    }
 }
@@ -134,9 +131,8 @@ DramDirectoryCntlr::__scheduleNextReqFromL2Cache(IntPtr address)
    LOG_PRINT("Contention Delay(%llu)", queue_delay);
    time += queue_delay;
 
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << this << address;
-   Event* event = new Event((Event::Type) DRAM_DIRECTORY_HANDLE_NEXT_REQ_FROM_L2_CACHE, time, event_args);
+   Event* event = new TypedEvent<DramDirectoryNextReqArgs>(DRAM_DIRECTORY_HANDLE_NEXT_REQ_FROM_L2_CACHE, time,
+         DramDirectoryNextReqArgs(this, address));
    Event::processInOrder(event, getCoreId(), EventQueue::ORDERED);
 }
 
@@ -179,12 +175,11 @@ DramDirectoryCntlr::handleNextReqFromL2Cache(IntPtr address)
 void
 handleDramDirectoryAccessReq(Event* event)
 {
-   UnstructuredBuffer* event_args = event->getArgs();
+   const DramDirectoryAccessReqArgs& event_args = TypedEvent<DramDirectoryAccessReqArgs>::getTypedArgs(event);
    
-   DramDirectoryCntlr* dram_directory_cntlr;
-   core_id_t sender;
-   ShmemMsg* shmem_msg;
-   (*event_args) >> dram_directory_cntlr >> sender >> shmem_msg;
+   DramDirectoryCntlr* dram_directory_cntlr = event_args._dram_directory_cntlr;
+   core_id_t sender = event_args._sender;
+   ShmemMsg* shmem_msg = event_args._shmem_msg;
 
    // Set the Time correctly
    dram_directory_cntlr->getShmemPerfModel()->setCycleCount(event->getTime());
@@ -223,9 +218,8 @@ DramDirectoryCntlr::scheduleRequest(core_id_t sender, ShmemMsg* shmem_msg)
 
    // Push an event to access the L2 Cache from the Directory
    ShmemMsg* cloned_shmem_msg = shmem_msg->clone();
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << this << sender << cloned_shmem_msg;
-   Event* event = new Event((Event::Type) DRAM_DIRECTORY_ACCESS_REQ, time, event_args);
+   Event* event = new TypedEvent<DramDirectoryAccessReqArgs>(DRAM_DIRECTORY_ACCESS_REQ, time,
+         DramDirectoryAccessReqArgs(this, sender, cloned_shmem_msg));
    Event::processInOrder(event, getCoreId(), EventQueue::ORDERED);
 }
 
@@ -106,6 +106,29 @@ namespace PrL1PrL2DramDirectoryMSI
          static void unregisterEventHandlers();
    };
 
+   // Arguments of the DRAM_DIRECTORY_ACCESS_REQ event
+   class DramDirectoryAccessReqArgs
+   {
+   public:
+      DramDirectoryAccessReqArgs(DramDirectoryCntlr* dram_directory_cntlr, core_id_t sender, ShmemMsg* shmem_msg)
+         : _dram_directory_cntlr(dram_directory_cntlr), _sender(sender), _shmem_msg(shmem_msg) {}
+
+      DramDirectoryCntlr* _dram_directory_cntlr;
+      core_id_t _sender;
+      ShmemMsg* _shmem_msg;
+   };
+
+   // Arguments of the DRAM_DIRECTORY_{SCHEDULE,HANDLE}_NEXT_REQ_FROM_L2_CACHE events
+   class DramDirectoryNextReqArgs
+   {
+   public:
+      DramDirectoryNextReqArgs(DramDirectoryCntlr* dram_directory_cntlr, IntPtr address)
+         : _dram_directory_cntlr(dram_directory_cntlr), _address(address) {}
+
+      DramDirectoryCntlr* _dram_directory_cntlr;
+      IntPtr _address;
+   };
+
    void handleDramDirectoryAccessReq(Event* event);
    void scheduleNextDramDirectoryAccessReqFromL2Cache(Event* event);
    void handleNextDramDirectoryAccessReqFromL2Cache(Event* event);
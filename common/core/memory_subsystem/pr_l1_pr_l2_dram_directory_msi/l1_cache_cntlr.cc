@@ -1,6 +1,7 @@
 #include "l1_cache_cntlr.h"
 #include "l2_cache_cntlr.h" 
 #include "memory_manager.h"
+#include "config.h"
 #include "event.h"
 
 namespace PrL1PrL2DramDirectoryMSI
@@ -21,13 +22,15 @@ L1CacheCntlr::L1CacheCntlr(MemoryManager* memory_manager,
          l1_icache_associativity, 
          cache_block_size,
          l1_icache_replacement_policy,
-         CacheBase::PR_L1_CACHE);
+         CacheBase::PR_L1_CACHE,
+         Config::getSingleton()->isCacheDataModeled());
    m_l1_dcache = new Cache("L1-D",
          l1_dcache_size,
          l1_dcache_associativity, 
          cache_block_size,
          l1_dcache_replacement_policy,
-         CacheBase::PR_L1_CACHE);
+         CacheBase::PR_L1_CACHE,
+         Config::getSingleton()->isCacheDataModeled());
 
    initializeMissStatusMaps();
 }
@@ -130,13 +133,7 @@ L1CacheCntlr::doInitiateCacheAccess(MemComponent::component_t mem_component,
    
    if (operationPermissibleinL1Cache(mem_component, address, mem_op_type, modeled, update_cache_counters))
    {
-      // Increment Shared Mem Perf model cycle counts
-      // L1 Cache
-      getMemoryManager()->incrCycleCount(mem_component, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
-      if (mem_op_type == Core::WRITE)
-         getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
-
-      accessCache(mem_component, mem_op_type, address, offset, data_buf, data_length);
+      accessCacheOnL1Hit(mem_component, mem_op_type, address, offset, data_buf, data_length);
  
       // Complete Cache Request
       completeCacheRequest(mem_component, memory_access_id, l1_miss_status);
@@ -205,6 +202,49 @@ L1CacheCntlr::doInitiateCacheAccess(MemComponent::component_t mem_component,
    m_l2_cache_cntlr->handleMsgFromL1Cache(&shmem_msg);
 }
 
+bool
+L1CacheCntlr::isCacheHit(MemComponent::component_t mem_component, IntPtr ca_address, Core::mem_op_t mem_op_type)
+{
+   // Accesses to a line with an outstanding miss must wait for it (and atomic
+   // read-modify-write sequences always go through initiateCacheAccess())
+   if (m_locked || m_miss_status_maps[mem_component].get(ca_address))
+      return false;
+   return operationPermissibleinL1Cache(mem_component, ca_address, mem_op_type,
+                                        false /* modeled */, false /* update_cache_counters */);
+}
+
+void
+L1CacheCntlr::accessCacheOnHit(MemComponent::component_t mem_component,
+                               Core::mem_op_t mem_op_type,
+                               IntPtr ca_address, UInt32 offset,
+                               Byte* data_buf, UInt32 data_length,
+                               bool modeled)
+{
+   LOG_PRINT("Core Id(%i): accessCacheOnHit() [Mem Component(%u), Mem Op Type(%u), CA-Address(%#lx), Offset(%u), Data Length(%u)]",
+             getCoreId(), mem_component, mem_op_type, ca_address, offset, data_length);
+
+   __attribute(__unused__) bool cache_hit = operationPermissibleinL1Cache(mem_component, ca_address, mem_op_type,
+                                                                          modeled, true /* update_cache_counters */);
+   assert(cache_hit);
+
+   accessCacheOnL1Hit(mem_component, mem_op_type, ca_address, offset, data_buf, data_length);
+}
+
+void
+L1CacheCntlr::accessCacheOnL1Hit(MemComponent::component_t mem_component,
+                                 Core::mem_op_t mem_op_type,
+                                 IntPtr ca_address, UInt32 offset,
+                                 Byte* data_buf, UInt32 data_length)
+{
+   // Increment Shared Mem Perf model cycle counts
+   // L1 Cache
+   getMemoryManager()->incrCycleCount(mem_component, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+   if (mem_op_type == Core::WRITE)
+      getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+
+   accessCache(mem_component, mem_op_type, ca_address, offset, data_buf, data_length);
+}
+
 void
 L1CacheCntlr::completeCacheRequest(MemComponent::component_t mem_component,
                                    UInt32 memory_access_id,
@@ -214,10 +254,8 @@ L1CacheCntlr::completeCacheRequest(MemComponent::component_t mem_component,
              mem_component, memory_access_id, l1_miss_status);
 
    // Send Reply to Core
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << getMemoryManager()->getCore() << memory_access_id;
    EventCompleteCacheAccess* event = new EventCompleteCacheAccess(getShmemPerfModel()->getCycleCount(),
-                                                                  event_args);
+                                                                  getMemoryManager()->getCore(), memory_access_id);
    Event::processInOrder(event, getCoreId(), EventQueue::ORDERED);
  
    if (l1_miss_status)
@@ -242,10 +280,8 @@ L1CacheCntlr::processNextCacheRequest(MemComponent::component_t mem_component, I
    {
       UInt64 time = getShmemPerfModel()->getCycleCount() + 1;
 
-      UnstructuredBuffer* event_args = new UnstructuredBuffer();
-      (*event_args) << getMemoryManager() << mem_component << l1_miss_status;
-      
-      EventReInitiateCacheAccess* event = new EventReInitiateCacheAccess(time, event_args);
+      EventReInitiateCacheAccess* event = new EventReInitiateCacheAccess(time, getMemoryManager(),
+                                                                         mem_component, l1_miss_status);
       Event::processInOrder(event, getCoreId(), EventQueue::ORDERED);
    }
 }
@@ -65,6 +65,11 @@ namespace PrL1PrL2DramDirectoryMSI
                                     Byte* data_buf, UInt32 data_length,
                                     bool modeled,
                                     L1MissStatus* l1_miss_status);
+         // Access the L1 Cache on a hit (the permissions are already checked)
+         void accessCacheOnL1Hit(MemComponent::component_t mem_component,
+                                 Core::mem_op_t mem_op_type,
+                                 IntPtr ca_address, UInt32 offset,
+                                 Byte* data_buf, UInt32 data_length);
          // Complete Cache Request
          void completeCacheRequest(MemComponent::component_t mem_component, UInt32 memory_access_id, L1MissStatus* l1_miss_status);
          // Process Next Cache Request 
@@ -94,6 +99,15 @@ namespace PrL1PrL2DramDirectoryMSI
                                   bool modeled);
          // Called from memory manager to re-start L1 cache access
          void reInitiateCacheAccess(MemComponent::component_t mem_component, L1MissStatus* l1_miss_status);
+
+         // Synchronous L1 hits (no events): isCacheHit() has no side effects,
+         // accessCacheOnHit() must only be called if isCacheHit() is true
+         bool isCacheHit(MemComponent::component_t mem_component, IntPtr ca_address, Core::mem_op_t mem_op_type);
+         void accessCacheOnHit(MemComponent::component_t mem_component,
+                               Core::mem_op_t mem_op_type,
+                               IntPtr ca_address, UInt32 offset,
+                               Byte* data_buf, UInt32 data_length,
+                               bool modeled);
          
          // Called from L2 cache cntlr to indicate that a memory request has been processed
          void signalDataReady(MemComponent::component_t mem_component, IntPtr address);
@@ -2,6 +2,7 @@
 #include "l2_cache_cntlr.h"
 #include "log.h"
 #include "memory_manager.h"
+#include "config.h"
 
 namespace PrL1PrL2DramDirectoryMSI
 {
@@ -21,7 +22,8 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
          l2_cache_associativity, 
          cache_block_size, 
          l2_cache_replacement_policy, 
-         CacheBase::PR_L2_CACHE);
+         CacheBase::PR_L2_CACHE,
+         Config::getSingleton()->isCacheDataModeled());
    
    m_l2_cache_contention_model = new QueueModelSimple(false);
 }
@@ -187,12 +189,11 @@ L2CacheCntlr::processShmemReqFromL1Cache(MemComponent::component_t req_mem_compo
 void
 handleL2CacheAccessReq(Event* event)
 {
-   UnstructuredBuffer* event_args = event->getArgs();
+   const L2CacheAccessReqArgs& event_args = TypedEvent<L2CacheAccessReqArgs>::getTypedArgs(event);
    
-   L2CacheCntlr* l2_cache_cntlr;
-   core_id_t sender;
-   ShmemMsg* shmem_msg;
-   (*event_args) >> l2_cache_cntlr >> sender >> shmem_msg;
+   L2CacheCntlr* l2_cache_cntlr = event_args._l2_cache_cntlr;
+   core_id_t sender = event_args._sender;
+   ShmemMsg* shmem_msg = event_args._shmem_msg;
 
    // Set the Time correctly
    l2_cache_cntlr->getShmemPerfModel()->setCycleCount(event->getTime());
@@ -253,9 +254,8 @@ L2CacheCntlr::scheduleRequest(UInt64 time, core_id_t sender, ShmemMsg* shmem_msg
    time += queue_delay;
 
    // Push an event to access the L2 Cache from the Directory after cloning the msg
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << this << sender << shmem_msg;
-   Event* event = new Event((Event::Type) L2_CACHE_ACCESS_REQ, time, event_args);
+   Event* event = new TypedEvent<L2CacheAccessReqArgs>(L2_CACHE_ACCESS_REQ, time,
+         L2CacheAccessReqArgs(this, sender, shmem_msg));
    Event::processInOrder(event, getCoreId(), EventQueue::ORDERED);
 }
 
@@ -125,6 +125,18 @@ namespace PrL1PrL2DramDirectoryMSI
       static void unregisterEventHandlers();
    };
 
+   // Arguments of the L2_CACHE_ACCESS_REQ event
+   class L2CacheAccessReqArgs
+   {
+   public:
+      L2CacheAccessReqArgs(L2CacheCntlr* l2_cache_cntlr, core_id_t sender, ShmemMsg* shmem_msg)
+         : _l2_cache_cntlr(l2_cache_cntlr), _sender(sender), _shmem_msg(shmem_msg) {}
+
+      L2CacheCntlr* _l2_cache_cntlr;
+      core_id_t _sender;
+      ShmemMsg* _shmem_msg;
+   };
+
    void handleL2CacheAccessReq(Event* event);
 
 }
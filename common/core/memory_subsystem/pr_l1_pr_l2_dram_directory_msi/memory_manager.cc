@@ -2,6 +2,7 @@
 #include "cache_base.h"
 #include "simulator.h"
 #include "clock_converter.h"
+#include "net_packet_buffer.h"
 #include "log.h"
 
 namespace PrL1PrL2DramDirectoryMSI
@@ -258,6 +259,26 @@ MemoryManager::reInitiateCacheAccess(UInt64 time,
    m_l1_cache_cntlr->reInitiateCacheAccess(mem_component, (L1MissStatus*) miss_status);
 }
 
+bool
+MemoryManager::tryL1CacheAccess(UInt64 time,
+                                MemComponent::component_t mem_component,
+                                Core::mem_op_t mem_op_type,
+                                IntPtr address, UInt32 offset,
+                                Byte* data_buf, UInt32 data_length,
+                                bool modeled,
+                                UInt64& completion_time)
+{
+   assert((mem_component == MemComponent::L1_ICACHE) || (mem_component == MemComponent::L1_DCACHE));
+
+   if (!m_l1_cache_cntlr->isCacheHit(mem_component, address, mem_op_type))
+      return false;
+
+   getShmemPerfModel()->setCycleCount(time);
+   m_l1_cache_cntlr->accessCacheOnHit(mem_component, mem_op_type, address, offset, data_buf, data_length, modeled);
+   completion_time = getShmemPerfModel()->getCycleCount();
+   return true;
+}
+
 void
 MemoryManager::handleMsgFromNetwork(NetPacket& packet)
 {
@@ -348,9 +369,14 @@ void
 MemoryManager::sendMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t sender_mem_component, MemComponent::component_t receiver_mem_component, core_id_t requester, core_id_t receiver, IntPtr address, bool reply_expected, Byte* data_buf, UInt32 data_length)
 {
    assert((data_buf == NULL) == (data_length == 0));
+   // Timing-only caches: the cache line is modeled but not carried
+   if ((data_buf != NULL) && !Config::getSingleton()->isCacheDataModeled())
+      data_buf = ShmemMsg::UNMODELED_DATA_BUF;
    ShmemMsg shmem_msg(msg_type, sender_mem_component, receiver_mem_component, requester, address, reply_expected, data_buf, data_length);
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
+   // The message is written directly into the payload shared by the packets sent
+   Byte* msg_buf = NetPacketBuffer::allocate(shmem_msg.getMsgLen());
+   shmem_msg.makeMsgBuf(msg_buf);
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    LOG_PRINT("Core Id(%i): Sending Msg: type(%u), address(%#lx), "
@@ -363,22 +389,27 @@ MemoryManager::sendMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t sende
    NetPacket packet(msg_time, SHARED_MEM_1,
          getCore()->getId(), receiver,
          shmem_msg.getMsgLen(), (const void*) msg_buf);
+   packet.shared_data = true;
    getNetwork()->netSend(packet);
 
    // Incr Cycle Count by 1 cycle
    getShmemPerfModel()->incrCycleCount(1);
 
-   // Delete the Msg Buf
-   delete [] msg_buf;
+   // Release the Msg Buf
+   NetPacketBuffer::release(msg_buf);
 }
 
 void
 MemoryManager::broadcastMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t sender_mem_component, MemComponent::component_t receiver_mem_component, core_id_t requester, IntPtr address, bool reply_expected, Byte* data_buf, UInt32 data_length)
 {
    assert((data_buf == NULL) == (data_length == 0));
+   if ((data_buf != NULL) && !Config::getSingleton()->isCacheDataModeled())
+      data_buf = ShmemMsg::UNMODELED_DATA_BUF;
    ShmemMsg shmem_msg(msg_type, sender_mem_component, receiver_mem_component, requester, address, reply_expected, data_buf, data_length);
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
+   // The message is written directly into the payload shared by the packets sent
+   Byte* msg_buf = NetPacketBuffer::allocate(shmem_msg.getMsgLen());
+   shmem_msg.makeMsgBuf(msg_buf);
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    LOG_PRINT("Core Id(%i): Broadcasting Msg: type(%u), address(%#lx), "
@@ -391,13 +422,14 @@ MemoryManager::broadcastMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t
    NetPacket packet(msg_time, SHARED_MEM_1,
          getCore()->getId(), NetPacket::BROADCAST,
          shmem_msg.getMsgLen(), (const void*) msg_buf);
+   packet.shared_data = true;
    getNetwork()->netSend(packet);
 
    // Incr Cycle Count by 1 cycle
    getShmemPerfModel()->incrCycleCount(1);
 
-   // Delete the Msg Buf
-   delete [] msg_buf;
+   // Release the Msg Buf
+   NetPacketBuffer::release(msg_buf);
 }
 
 void
@@ -7,6 +7,10 @@ using std::ostringstream;
 
 namespace PrL1PrL2DramDirectoryMSI
 {
+   // Only its address is used
+   static Byte unmodeled_data;
+   Byte* const ShmemMsg::UNMODELED_DATA_BUF = &unmodeled_data;
+
    ShmemMsg::ShmemMsg() :
       m_msg_type(INVALID_MSG_TYPE),
       m_sender_mem_component(MemComponent::INVALID_MEM_COMPONENT),
@@ -57,31 +61,40 @@ namespace PrL1PrL2DramDirectoryMSI
       memcpy((void*) shmem_msg, msg_buf, sizeof(*shmem_msg));
       if (shmem_msg->getDataLength() > 0)
       {
-         shmem_msg->setDataBuf(new Byte[shmem_msg->getDataLength()]);
-         memcpy((void*) shmem_msg->getDataBuf(), msg_buf + sizeof(*shmem_msg), shmem_msg->getDataLength());
+         // makeMsgBuf() leaves a NULL data buffer if the cache line is not carried
+         if (shmem_msg->getDataBuf() == NULL)
+         {
+            shmem_msg->setDataBuf(UNMODELED_DATA_BUF);
+         }
+         else
+         {
+            shmem_msg->setDataBuf(new Byte[shmem_msg->getDataLength()]);
+            memcpy((void*) shmem_msg->getDataBuf(), msg_buf + sizeof(*shmem_msg), shmem_msg->getDataLength());
+         }
       }
       return shmem_msg;
    }
 
-   Byte*
-   ShmemMsg::makeMsgBuf() const
+   // Writes the message into 'msg_buf' (getMsgLen() bytes)
+   void
+   ShmemMsg::makeMsgBuf(Byte* msg_buf) const
    {
-      Byte* msg_buf = new Byte[getMsgLen()];
       memcpy(msg_buf, (void*) this, sizeof(*this));
       if (m_data_length > 0)
       {
          LOG_ASSERT_ERROR(m_data_buf != NULL, "m_data_buf(%p)", m_data_buf);
-         memcpy(msg_buf + sizeof(*this), (void*) m_data_buf, m_data_length); 
+         if (isDataCarried())
+            memcpy(msg_buf + sizeof(*this), (void*) m_data_buf, m_data_length); 
+         else
+            ((ShmemMsg*) msg_buf)->m_data_buf = NULL;
       }
-
-      return msg_buf; 
    }
 
    UInt32
    ShmemMsg::getMsgLen() const
    {
       assert((m_data_buf != NULL) == (m_data_length > 0));
-      return (sizeof(*this) + m_data_length);
+      return (sizeof(*this) + (isDataCarried() ? m_data_length : 0));
    }
 
    ShmemMsg*
@@ -90,7 +103,7 @@ namespace PrL1PrL2DramDirectoryMSI
       assert((m_data_buf != NULL) == (m_data_length > 0));
       
       ShmemMsg* cloned_msg = new ShmemMsg(*this);
-      if (m_data_length > 0)
+      if (isDataCarried())
       {
          cloned_msg->setDataBuf(new Byte[m_data_length]);
          memcpy(cloned_msg->getDataBuf(), m_data_buf, m_data_length);
@@ -102,7 +115,7 @@ namespace PrL1PrL2DramDirectoryMSI
    ShmemMsg::release()
    {
       assert((m_data_buf != NULL) == (m_data_length > 0));
-      if (m_data_length > 0)
+      if (isDataCarried())
       {
          delete [] m_data_buf;
       }
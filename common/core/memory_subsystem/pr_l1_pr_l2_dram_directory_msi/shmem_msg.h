@@ -31,6 +31,10 @@ namespace PrL1PrL2DramDirectoryMSI
          NUM_MSG_TYPES = MAX_MSG_TYPE - MIN_MSG_TYPE + 1
       };  
 
+      // Data buffer of the messages that model a cache line without carrying it
+      // (timing-only caches). It is never dereferenced
+      static Byte* const UNMODELED_DATA_BUF;
+
    private:   
       msg_t m_msg_type;
       MemComponent::component_t m_sender_mem_component;
@@ -41,6 +45,9 @@ namespace PrL1PrL2DramDirectoryMSI
       Byte* m_data_buf;
       UInt32 m_data_length;
 
+      bool isDataCarried() const
+      { return (m_data_length > 0) && (m_data_buf != UNMODELED_DATA_BUF); }
+
    public:
       ShmemMsg();
       ShmemMsg(msg_t msg_type,
@@ -56,7 +63,7 @@ namespace PrL1PrL2DramDirectoryMSI
       ~ShmemMsg();
 
       static ShmemMsg* getShmemMsg(Byte* msg_buf);
-      Byte* makeMsgBuf() const;
+      void makeMsgBuf(Byte* msg_buf) const;
       UInt32 getMsgLen() const;
       ShmemMsg* clone() const;
       void release();
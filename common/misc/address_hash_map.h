@@ -0,0 +1,130 @@
+#ifndef __ADDRESS_HASH_MAP_H__
+#define __ADDRESS_HASH_MAP_H__
+
+#include <vector>
+#include <assert.h>
+
+#include "fixed_types.h"
+
+// Hash map with addresses as keys, using open addressing (linear probing)
+// The entries live in one array whose size is a power of 2, at most half full.
+// erase() moves the later entries of the probe sequence back into the hole, so
+// lookups never go through deleted entries. INVALID_ADDRESS can not be a key
+template <class T>
+class AddressHashMap
+{
+   public:
+      AddressHashMap(UInt32 initial_capacity = 16)
+         : m_size(0)
+      {
+         UInt32 capacity = 2;
+         while (capacity < initial_capacity)
+            capacity <<= 1;
+         m_key_list.resize(capacity, INVALID_ADDRESS);
+         m_value_list.resize(capacity);
+         m_hash_shift = 64 - __builtin_ctz(capacity);
+      }
+      ~AddressHashMap() {}
+
+      // Pointer to the value of 'address', NULL if not present
+      T* find(IntPtr address)
+      {
+         UInt32 index = lookup(address);
+         return (m_key_list[index] == address) ? &m_value_list[index] : (T*) NULL;
+      }
+
+      // Returns false (and changes nothing) if 'address' is already present
+      bool insert(IntPtr address, const T& value)
+      {
+         assert(address != INVALID_ADDRESS);
+         if (2 * (m_size + 1) > m_key_list.size())
+            resize(2 * m_key_list.size());
+
+         UInt32 index = lookup(address);
+         if (m_key_list[index] == address)
+            return false;
+         m_key_list[index] = address;
+         m_value_list[index] = value;
+         m_size ++;
+         return true;
+      }
+
+      // Returns false if 'address' is not present
+      bool erase(IntPtr address)
+      {
+         UInt32 hole = lookup(address);
+         if (m_key_list[hole] != address)
+            return false;
+
+         // Backward-shift the entries that were displaced past the hole
+         UInt32 mask = m_key_list.size() - 1;
+         for (UInt32 index = (hole + 1) & mask; m_key_list[index] != INVALID_ADDRESS; index = (index + 1) & mask)
+         {
+            UInt32 home = getHomeIndex(m_key_list[index]);
+            // Move the entry if its home is not in the (cyclic) range (hole, index]
+            if (((index - home) & mask) >= ((index - hole) & mask))
+            {
+               m_key_list[hole] = m_key_list[index];
+               m_value_list[hole] = m_value_list[index];
+               hole = index;
+            }
+         }
+         m_key_list[hole] = INVALID_ADDRESS;
+         m_value_list[hole] = T();
+         m_size --;
+         return true;
+      }
+
+      UInt32 size() const { return m_size; }
+
+   private:
+      // Unit test (tests/unit/address_hash_map)
+      friend class AddressHashMapTest;
+
+      std::vector<IntPtr> m_key_list;
+      std::vector<T> m_value_list;
+      UInt32 m_size;
+      // 64 - log2(capacity)
+      UInt32 m_hash_shift;
+
+      UInt32 getCapacity() const { return m_key_list.size(); }
+
+      // First slot probed for 'address' (at the current capacity)
+      UInt32 getHomeIndex(IntPtr address) const
+      {
+         // Fibonacci hashing: the top bits of the product depend on all the address bits
+         UInt64 hash = ((UInt64) address) * 0x9e3779b97f4a7c15ULL;
+         return (UInt32) (hash >> m_hash_shift);
+      }
+
+      // Slot holding 'address', or the empty slot where it would go
+      UInt32 lookup(IntPtr address) const
+      {
+         UInt32 mask = m_key_list.size() - 1;
+         UInt32 index = getHomeIndex(address);
+         while ((m_key_list[index] != address) && (m_key_list[index] != INVALID_ADDRESS))
+            index = (index + 1) & mask;
+         return index;
+      }
+
+      void resize(UInt32 capacity)
+      {
+         std::vector<IntPtr> old_key_list(capacity, INVALID_ADDRESS);
+         std::vector<T> old_value_list(capacity);
+         old_key_list.swap(m_key_list);
+         old_value_list.swap(m_value_list);
+         m_hash_shift = 64 - __builtin_ctz(capacity);
+
+         for (UInt32 i = 0; i < old_key_list.size(); i++)
+         {
+            if (old_key_list[i] != INVALID_ADDRESS)
+            {
+               UInt32 index = lookup(old_key_list[i]);
+               m_key_list[index] = old_key_list[i];
+               m_value_list[index] = old_value_list[i];
+            }
+         }
+      }
+};
+
+#endif /* __ADDRESS_HASH_MAP_H__ */
@@ -0,0 +1,193 @@
+#include <cmath>
+#include <algorithm>
+using std::sort;
+
+#include "address_profile.h"
+#include "simulator.h"
+#include "tag_search.h"
+#include "utils.h"
+#include "log.h"
+
+// 64-bit finalizer of MurmurHash3
+static inline UInt64 mixBits(UInt64 key)
+{
+   key ^= key >> 33;
+   key *= 0xff51afd7ed558ccdULL;
+   key ^= key >> 33;
+   key *= 0xc4ceb9fe1a85ec53ULL;
+   key ^= key >> 33;
+   return key;
+}
+
+static bool compareCounts(const pair<IntPtr,UInt64>& a, const pair<IntPtr,UInt64>& b)
+{
+   return a.second > b.second;
+}
+
+AddressProfile::AddressProfile(UInt32 width, UInt32 num_top_addresses, UInt32 sample_period)
+   : _width(width)
+   , _sample_period(sample_period)
+   , _sample_countdown(sample_period)
+   , _total_count(0)
+   , _counter_vec(NUM_ROWS * width, 0)
+   , _num_top_addresses(num_top_addresses)
+   , _num_top_addresses_used(0)
+   , _top_address_vec(num_top_addresses)
+   , _top_count_vec(num_top_addresses)
+   , _register_vec(NUM_REGISTERS, 0)
+{
+   LOG_ASSERT_ERROR(isPower2(_width), "Sketch width(%u) must be a power of 2", _width);
+   LOG_ASSERT_ERROR(_sample_period > 0, "Sample period must be > 0");
+}
+
+AddressProfile::~AddressProfile()
+{}
+
+bool
+AddressProfile::isEnabled()
+{
+   return Sim()->getCfg()->getBool("address_profile/enabled", false);
+}
+
+AddressProfile*
+AddressProfile::create()
+{
+   if (!isEnabled())
+      return (AddressProfile*) NULL;
+
+   UInt32 width = 0;
+   UInt32 num_top_addresses = 0;
+   UInt32 sample_period = 0;
+   try
+   {
+      width = Sim()->getCfg()->getInt("address_profile/sketch_width");
+      num_top_addresses = Sim()->getCfg()->getInt("address_profile/num_top_addresses");
+      sample_period = Sim()->getCfg()->getInt("address_profile/sample_period");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read address_profile parameters from cfg file");
+   }
+   return new AddressProfile(width, num_top_addresses, sample_period);
+}
+
+UInt32
+AddressProfile::getCfgNumTopAddresses()
+{
+   try
+   {
+      return Sim()->getCfg()->getInt("address_profile/num_top_addresses");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read address_profile/num_top_addresses from cfg file");
+      return 0;
+   }
+}
+
+UInt64
+AddressProfile::computeHashes(IntPtr address, UInt64* hash_list) const
+{
+   // Every row takes its own 32 bits of two 64-bit hashes, so that two addresses
+   // that collide in one row are unlikely to collide in the others
+   UInt64 hash = mixBits((UInt64) address);
+   UInt64 hash_2 = mixBits(hash ^ 0x9e3779b97f4a7c15ULL);
+   for (UInt32 i = 0; i < NUM_ROWS; i++)
+      hash_list[i] = (((i < 2) ? hash : hash_2) >> (32 * (i & 1))) & 0xffffffff;
+   return hash;
+}
+
+UInt64
+AddressProfile::getCount(const UInt64* hash_list) const
+{
+   UInt64 count = UINT64_MAX_;
+   for (UInt32 i = 0; i < NUM_ROWS; i++)
+      count = std::min<UInt64>(count, _counter_vec[i * _width + (hash_list[i] & (_width - 1))]);
+   return count;
+}
+
+UInt64
+AddressProfile::getCount(IntPtr address) const
+{
+   UInt64 hash_list[NUM_ROWS];
+   computeHashes(address, hash_list);
+   return getCount(hash_list);
+}
+
+void
+AddressProfile::profile(IntPtr address)
+{
+   UInt64 hash_list[NUM_ROWS];
+   UInt64 hash = computeHashes(address, hash_list);
+
+   _total_count += _sample_period;
+   for (UInt32 i = 0; i < NUM_ROWS; i++)
+      _counter_vec[i * _width + (hash_list[i] & (_width - 1))] += _sample_period;
+
+   // HyperLogLog: register indexed by the top bits of the hash,
+   // holds the max position of the first 1 in the remaining bits
+   UInt32 register_index = hash >> (64 - LOG_NUM_REGISTERS);
+   UInt64 remaining_bits = hash << LOG_NUM_REGISTERS;
+   UInt8 rank = (remaining_bits == 0) ? (64 - LOG_NUM_REGISTERS + 1) : (__builtin_clzll(remaining_bits) + 1);
+   if (rank > _register_vec[register_index])
+      _register_vec[register_index] = rank;
+
+   // Top addresses
+   if (_num_top_addresses == 0)
+      return;
+   UInt64 count = getCount(hash_list);
+   SInt32 index = findFirstTag(&_top_address_vec[0], _num_top_addresses_used, address);
+   if (index >= 0)
+   {
+      _top_count_vec[index] = count;
+   }
+   else if (_num_top_addresses_used < _num_top_addresses)
+   {
+      _top_address_vec[_num_top_addresses_used] = address;
+      _top_count_vec[_num_top_addresses_used] = count;
+      _num_top_addresses_used ++;
+   }
+   else
+   {
+      UInt32 min_index = 0;
+      for (UInt32 i = 1; i < _num_top_addresses; i++)
+      {
+         if (_top_count_vec[i] < _top_count_vec[min_index])
+            min_index = i;
+      }
+      if (count > _top_count_vec[min_index])
+      {
+         _top_address_vec[min_index] = address;
+         _top_count_vec[min_index] = count;
+      }
+   }
+}
+
+UInt64
+AddressProfile::getNumDistinctAddresses() const
+{
+   double sum = 0.0;
+   UInt32 num_zero_registers = 0;
+   for (UInt32 i = 0; i < NUM_REGISTERS; i++)
+   {
+      sum += ldexp(1.0, -_register_vec[i]);
+      if (_register_vec[i] == 0)
+         num_zero_registers ++;
+   }
+
+   double alpha = 0.7213 / (1.0 + 1.079 / NUM_REGISTERS);
+   double estimate = alpha * NUM_REGISTERS * NUM_REGISTERS / sum;
+   // Small range correction (linear counting)
+   if ((estimate <= 2.5 * NUM_REGISTERS) && (num_zero_registers > 0))
+      estimate = NUM_REGISTERS * log(((double) NUM_REGISTERS) / num_zero_registers);
+   return (UInt64) (estimate + 0.5);
+}
+
+void
+AddressProfile::getTopAddresses(vector<pair<IntPtr,UInt64> >& top_address_list) const
+{
+   top_address_list.clear();
+   for (UInt32 i = 0; i < _num_top_addresses_used; i++)
+      top_address_list.push_back(std::make_pair(_top_address_vec[i], _top_count_vec[i]));
+   sort(top_address_list.begin(), top_address_list.end(), compareCounts);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+using std::pair;
+
+#include "fixed_types.h"
+
+// Access profile of a stream of addresses in a fixed amount of memory
+//  - Count-min sketch (NUM_ROWS rows of '_width' counters) for the access count of an address.
+//    The estimate is never below the true count, and is above it by at most
+//    (e * total_count / _width) with high probability
+//  - Table of the '_num_top_addresses' addresses with the highest estimated counts seen so far
+//  - HyperLogLog registers for the number of distinct addresses (about 3% standard error)
+// Only one of every '_sample_period' accesses is profiled, with a weight of '_sample_period'
+class AddressProfile
+{
+   public:
+      // 'width' must be a power of 2 (<= 2^32)
+      AddressProfile(UInt32 width, UInt32 num_top_addresses, UInt32 sample_period);
+      ~AddressProfile();
+
+      // Profile built from the [address_profile] section of the cfg file,
+      // NULL if address profiling is disabled
+      static bool isEnabled();
+      static AddressProfile* create();
+      // Size of the top address table of the profiles built by create()
+      static UInt32 getCfgNumTopAddresses();
+
+      void record(IntPtr address)
+      {
+         if (--_sample_countdown == 0)
+         {
+            _sample_countdown = _sample_period;
+            profile(address);
+         }
+      }
+
+      UInt64 getCount(IntPtr address) const;
+      UInt64 getTotalCount() const { return _total_count; }
+      UInt64 getNumDistinctAddresses() const;
+      // (address, estimated count) in decreasing order of count
+      void getTopAddresses(vector<pair<IntPtr,UInt64> >& top_address_list) const;
+
+   private:
+      static const UInt32 NUM_ROWS = 4;
+      static const UInt32 LOG_NUM_REGISTERS = 10;
+      static const UInt32 NUM_REGISTERS = 1 << LOG_NUM_REGISTERS;
+
+      UInt32 _width;
+      UInt32 _sample_period;
+      UInt32 _sample_countdown;
+      UInt64 _total_count;
+
+      // Count-min sketch (NUM_ROWS x _width)
+      vector<UInt64> _counter_vec;
+
+      // Top addresses (the first _num_top_addresses_used entries are valid)
+      UInt32 _num_top_addresses;
+      UInt32 _num_top_addresses_used;
+      vector<IntPtr> _top_address_vec;
+      vector<UInt64> _top_count_vec;
+
+      // HyperLogLog registers
+      vector<UInt8> _register_vec;
+
+      void profile(IntPtr address);
+      UInt64 getCount(const UInt64* hash_list) const;
+      // Fills in the counter index (modulo _width) of every row, returns the hash of 'address'
+      UInt64 computeHashes(IntPtr address, UInt64* hash_list) const;
+};
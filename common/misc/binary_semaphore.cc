@@ -6,10 +6,11 @@
 #include <linux/futex.h>
 #include <limits.h>
 
-BinarySemaphore::BinarySemaphore():
+BinarySemaphore::BinarySemaphore(UInt32 spin_count):
    _flag(false),
    _numWaiting(0),
-   _futx(0)
+   _futx(0),
+   _spin_count(spin_count)
 {}
 
 BinarySemaphore::~BinarySemaphore()
@@ -18,6 +19,10 @@ BinarySemaphore::~BinarySemaphore()
 void
 BinarySemaphore::wait()
 {
+   // Spin for a while before taking the lock and (possibly) going to sleep
+   for (UInt32 i = 0; (i < _spin_count) && !_flag; i++)
+      __asm__ __volatile__ ("rep; nop" : : : "memory");
+
    _lock.acquire();
    LOG_PRINT("Waiting on BinarySemaphore(%p)", this);
    while (!_flag)
@@ -34,12 +39,20 @@ BinarySemaphore::wait()
    }
 
    _flag = false;
+   // Pairs with the fast path in signal()
+   __sync_synchronize();
    _lock.release();
 }
 
 void
 BinarySemaphore::signal()
 {
+   // If _flag is already set, the waiter has not consumed the previous
+   // signal yet and will see everything written before this one
+   __sync_synchronize();
+   if (_flag)
+      return;
+
    _lock.acquire();
 
    LOG_PRINT("Signaling on Binary Semaphore(%p)", this);
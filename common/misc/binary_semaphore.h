@@ -1,17 +1,20 @@
 #pragma once
 
 #include "lock.h"
+#include "fixed_types.h"
 
 class BinarySemaphore
 {
    private:
-      bool _flag;
+      volatile bool _flag;
       int _numWaiting;
       int _futx;
       Lock _lock;
+      // Number of times wait() polls _flag before going to sleep
+      UInt32 _spin_count;
 
    public:
-      BinarySemaphore();
+      BinarySemaphore(UInt32 spin_count = 0);
       ~BinarySemaphore();
 
       void wait();
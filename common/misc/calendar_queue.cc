@@ -0,0 +1,117 @@
+#include <cassert>
+
+#include "calendar_queue.h"
+#include "log.h"
+
+CalendarQueue::CalendarQueue(UInt32 num_buckets):
+   _window_start(0),
+   _num_window_elements(0)
+{
+   // Round up to a power of 2 so that the bucket index is a mask
+   _num_buckets = 1;
+   while (_num_buckets < num_buckets)
+      _num_buckets <<= 1;
+   _bucket_mask = _num_buckets - 1;
+   _buckets.resize(_num_buckets);
+}
+
+CalendarQueue::~CalendarQueue()
+{}
+
+bool
+CalendarQueue::insert(UInt64 key, void* data)
+{
+   LOG_PRINT("Insert(%llu, %p), Size(%u)", key, data, size());
+   UInt64 min_key = min().first;
+
+   // An empty window can be moved anywhere
+   if ((_num_window_elements == 0) && (key != UINT64_MAX_) && !inWindow(key))
+   {
+      _window_start = key;
+      fillWindow();
+   }
+
+   if (inWindow(key))
+   {
+      getBucket(key).push(data);
+      _num_window_elements ++;
+   }
+   else
+   {
+      // Too far in the future (or earlier than the window start)
+      _overflow_heap.insert(key, data);
+   }
+
+   return (key < min_key);
+}
+
+pair<UInt64,void*>
+CalendarQueue::min()
+{
+   if (isMinInWindow())
+      return make_pair(_window_start, getBucket(_window_start).front());
+   else
+      return _overflow_heap.min();
+}
+
+pair<UInt64,void*>
+CalendarQueue::extractMin()
+{
+   LOG_PRINT("extractMin(), Size(%u)", size());
+   if (isMinInWindow())
+   {
+      Bucket& bucket = getBucket(_window_start);
+      void* data = bucket.front();
+      bucket.pop();
+      _num_window_elements --;
+      return make_pair(_window_start, data);
+   }
+   else
+   {
+      return _overflow_heap.extractMin();
+   }
+}
+
+bool
+CalendarQueue::isMinInWindow()
+{
+   if (_num_window_elements == 0)
+   {
+      // Jump to the earliest element in the overflow heap
+      UInt64 overflow_min_key = _overflow_heap.min().first;
+      if (overflow_min_key == UINT64_MAX_)
+         return false;
+      _window_start = overflow_min_key;
+      fillWindow();
+      assert(_num_window_elements > 0);
+   }
+
+   advanceWindow();
+   // Elements inserted earlier than the window start stay in the overflow heap
+   return (_window_start <= _overflow_heap.min().first);
+}
+
+void
+CalendarQueue::advanceWindow()
+{
+   assert(_num_window_elements > 0);
+   while (getBucket(_window_start).empty())
+   {
+      _window_start ++;
+      fillWindow();
+   }
+}
+
+void
+CalendarQueue::fillWindow()
+{
+   while (_overflow_heap.size() > 0)
+   {
+      pair<UInt64,void*> key_data_pair = _overflow_heap.min();
+      if ((key_data_pair.first == UINT64_MAX_) || !inWindow(key_data_pair.first))
+         break;
+      _overflow_heap.extractMin();
+      getBucket(key_data_pair.first).push(key_data_pair.second);
+      _num_window_elements ++;
+   }
+}
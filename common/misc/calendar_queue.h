@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+using std::pair;
+using std::make_pair;
+using std::vector;
+
+#include "fixed_types.h"
+#include "min_heap.h"
+
+// Calendar queue with one bucket per key (i.e., per cycle)
+// Keys in the window [_window_start, _window_start + num_buckets) are kept in
+// bucket (key % num_buckets), so insert/extractMin are O(1) amortized.
+// Keys outside the window go into an overflow MinHeap and are moved into the
+// buckets as the window slides forward.
+// Same interface as MinHeap::insert/min/extractMin/size
+class CalendarQueue
+{
+   public:
+      CalendarQueue(UInt32 num_buckets);
+      ~CalendarQueue();
+
+      // Interface Functions
+      // Returns true if 'key' is the new minimum
+      bool insert(UInt64 key, void* data = NULL);
+      pair<UInt64,void*> min();
+      pair<UInt64,void*> extractMin();
+      size_t size() { return _num_window_elements + _overflow_heap.size(); }
+
+   private:
+      // All the elements in a bucket have the same key.
+      // Elements are removed in FIFO order. The vector is cleared
+      // (not freed) once it is emptied, so it does not re-allocate
+      class Bucket
+      {
+         public:
+            Bucket() : _head(0) {}
+
+            bool empty() { return (_head == _data_list.size()); }
+            void* front() { return _data_list[_head]; }
+            void push(void* data) { _data_list.push_back(data); }
+            void pop()
+            {
+               _head ++;
+               if (_head == _data_list.size())
+               {
+                  _data_list.clear();
+                  _head = 0;
+               }
+            }
+
+         private:
+            vector<void*> _data_list;
+            UInt32 _head;
+      };
+
+      vector<Bucket> _buckets;
+      UInt32 _num_buckets;
+      UInt32 _bucket_mask;
+      UInt64 _window_start;
+      UInt32 _num_window_elements;
+
+      MinHeap _overflow_heap;
+
+      bool inWindow(UInt64 key)
+      { return (key >= _window_start) && ((key - _window_start) < _num_buckets); }
+      Bucket& getBucket(UInt64 key) { return _buckets[key & _bucket_mask]; }
+
+      // Is the minimum element in the buckets (or in the overflow heap) ?
+      bool isMinInWindow();
+      // Move _window_start to the first non-empty bucket
+      void advanceWindow();
+      // Move the elements in the overflow heap that now fall in the window into the buckets
+      void fillWindow();
+};
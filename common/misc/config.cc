@@ -44,6 +44,11 @@ Config::Config()
       // Accuracy & Execution Modes
       m_accuracy_mode = parseAccuracyMode(Sim()->getCfg()->getString("general/accuracy_mode"));
       m_execution_mode = parseExecutionMode(Sim()->getCfg()->getString("general/execution_mode"));
+
+      // Cache lines are modeled without their data (only tags & state) unless the
+      // application reads its data from the simulated memory system
+      m_cache_data_modeled = (m_execution_mode == FULL) ||
+                             !Sim()->getCfg()->getBool("caching_protocol/timing_only", false);
    }
    catch(...)
    {
@@ -126,6 +131,11 @@ bool Config::getEnablePowerModeling() const
    return (bool)m_knob_enable_power_modeling;
 }
 
+bool Config::isCacheDataModeled() const
+{
+   return m_cache_data_modeled;
+}
+
 std::string Config::getOutputFileName() const
 {
    return formatOutputFileName(m_knob_output_file);
@@ -289,6 +299,8 @@ void Config::parseNetworkParameters()
    const float DEFAULT_FREQUENCY = 1;           // In GHz
 
    string network_parameters_list[NUM_STATIC_NETWORKS];
+   bool hybrid_networks_enabled = false;
+   string fast_network_type;
    try
    {
       config::Config *cfg = Sim()->getCfg();
@@ -297,6 +309,9 @@ void Config::parseNetworkParameters()
       network_parameters_list[STATIC_NETWORK_MEMORY_1] = cfg->getString("network/memory_model_1");
       network_parameters_list[STATIC_NETWORK_MEMORY_2] = cfg->getString("network/memory_model_2");
       network_parameters_list[STATIC_NETWORK_SYSTEM] = cfg->getString("network/system_model");
+      hybrid_networks_enabled = cfg->getBool("network/hybrid/enabled", false);
+      if (hybrid_networks_enabled)
+         fast_network_type = cfg->getString("network/hybrid/fast_model");
    }
    catch (...)
    {
@@ -306,7 +321,16 @@ void Config::parseNetworkParameters()
 
    for (SInt32 i = 0; i < NUM_STATIC_NETWORKS; i++)
    {
-      m_network_parameters_vec.push_back(NetworkParameters(network_parameters_list[i], DEFAULT_FREQUENCY));
+      // Only the memory networks with a finite-buffer model are hybrid
+      string fast_type = "";
+      if (hybrid_networks_enabled &&
+          ((i == STATIC_NETWORK_MEMORY_1) || (i == STATIC_NETWORK_MEMORY_2)))
+      {
+         UInt32 network_type = NetworkModel::parseNetworkType(network_parameters_list[i]);
+         if ((network_type != NETWORK_MAGIC) && (network_type != NETWORK_EMESH_HOP_COUNTER))
+            fast_type = fast_network_type;
+      }
+      m_network_parameters_vec.push_back(NetworkParameters(network_parameters_list[i], fast_type, DEFAULT_FREQUENCY));
    }
 }
 
@@ -385,6 +409,21 @@ string Config::getNetworkType(SInt32 network_id)
    return m_network_parameters_vec[network_id].getType();
 }
 
+bool Config::isHybridNetwork(SInt32 network_id)
+{
+   LOG_ASSERT_ERROR(m_network_parameters_vec.size() == NUM_STATIC_NETWORKS,
+         "m_network_parameters_vec.size(%u), NUM_STATIC_NETWORKS(%u)",
+         m_network_parameters_vec.size(), NUM_STATIC_NETWORKS);
+
+   return m_network_parameters_vec[network_id].isHybrid();
+}
+
+string Config::getFastNetworkType(SInt32 network_id)
+{
+   LOG_ASSERT_ERROR(isHybridNetwork(network_id), "Network(%i) is not hybrid", network_id);
+   return m_network_parameters_vec[network_id].getFastType();
+}
+
 UInt32 Config::getNearestAcceptableCoreCount(UInt32 core_count)
 {
    UInt32 nearest_acceptable_core_count = 0;
@@ -50,16 +50,20 @@ private:
    {
       private:
          std::string m_type;
+         // Model used outside of the detailed intervals of a hybrid network ("" otherwise)
+         std::string m_fast_type;
          volatile float m_frequency;
 
       public:
-         NetworkParameters(std::string type, volatile float frequency):
-            m_type(type), m_frequency(frequency)
+         NetworkParameters(std::string type, std::string fast_type, volatile float frequency):
+            m_type(type), m_fast_type(fast_type), m_frequency(frequency)
          {}
          ~NetworkParameters() {}
 
          volatile float getFrequency() { return m_frequency; }
          std::string getType() { return m_type; }
+         std::string getFastType() { return m_fast_type; }
+         bool isHybrid() { return (m_fast_type != ""); }
    };
    
 public:
@@ -118,11 +122,16 @@ public:
    void setCoreFrequency(core_id_t core_id, volatile float frequency);
 
    std::string getNetworkType(SInt32 network_id);
+   // Hybrid networks switch between the model above and a fast model at runtime
+   bool isHybridNetwork(SInt32 network_id);
+   std::string getFastNetworkType(SInt32 network_id);
 
    // Knobs
    bool isSimulatingSharedMemory() const;
    bool getEnablePerformanceModeling() const;
    bool getEnablePowerModeling() const;
+   // False when the caches are timing-only (caching_protocol/timing_only)
+   bool isCacheDataModeled() const;
 
    // Logging
    std::string getOutputFileName() const;
@@ -144,6 +153,8 @@ private:
    AccuracyMode m_accuracy_mode;
    ExecutionMode m_execution_mode;
 
+   bool m_cache_data_modeled;
+
    static Config *m_singleton;
 
    static UInt32 m_knob_total_cores;
@@ -2,6 +2,10 @@
 
 #include "log.h"
 
+#ifdef LOCK_CONTENTION_COUNTING
+static volatile unsigned long long _num_contended_acquires = 0;
+#endif
+
 Lock::Lock()
 {
    pthread_mutex_init(&_mutx, NULL);
@@ -14,6 +18,12 @@ Lock::~Lock()
 
 void Lock::acquire()
 {
+#ifdef LOCK_CONTENTION_COUNTING
+   if (pthread_mutex_trylock(&_mutx) == 0)
+      return;
+
+   __sync_fetch_and_add(&_num_contended_acquires, 1);
+#endif
    pthread_mutex_lock(&_mutx);
 }
 
@@ -21,3 +31,21 @@ void Lock::release()
 {
    pthread_mutex_unlock(&_mutx);
 }
+
+bool Lock::isContentionCounted()
+{
+#ifdef LOCK_CONTENTION_COUNTING
+   return true;
+#else
+   return false;
+#endif
+}
+
+unsigned long long Lock::getNumContendedAcquires()
+{
+#ifdef LOCK_CONTENTION_COUNTING
+   return _num_contended_acquires;
+#else
+   return 0;
+#endif
+}
@@ -12,6 +12,12 @@ public:
    void acquire();
    void release();
 
+   // Number of acquire() calls (over all locks) that found the lock held.
+   // Only counted with LOCK_CONTENTION_COUNTING = true in Makefile.config,
+   // since it adds a shared atomic to every contended acquire
+   static bool isContentionCounted();
+   static unsigned long long getNumContendedAcquires();
+
 private:
    pthread_mutex_t _mutx;
 };
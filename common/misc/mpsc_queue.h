@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "fixed_types.h"
+
+// Link embedded in the elements of an MPSCQueue
+class MPSCQueueNode
+{
+   public:
+      MPSCQueueNode() : _mpsc_next(NULL) {}
+
+      MPSCQueueNode* volatile _mpsc_next;
+};
+
+// Intrusive, unbounded, lock-free queue for any number of producer threads
+// and exactly one consumer thread (D. Vyukov's MPSC node-based queue).
+// T must derive from MPSCQueueNode; an element can be on one queue at a time.
+// push() is one atomic exchange and never waits for the consumer or the other
+// producers. A producer is between the exchange and the link to its node for
+// a few instructions; pop() returns NULL if it finds such an unlinked node, so
+// each producer must wake up the consumer after its push() returns, and the
+// consumer must pop() until it gets NULL.
+template <class T>
+class MPSCQueue
+{
+   public:
+      MPSCQueue();
+      ~MPSCQueue();
+
+      // Producer side (any thread)
+      void push(T* element);
+
+      // Consumer side (one thread)
+      T* pop();
+
+      // May be called by any thread, as a hint only: while the consumer
+      // re-queues the stub, it can briefly be true with elements still queued
+      bool empty() { return (_back == &_stub); }
+
+   private:
+      // Producers append to _back; _stub is queued whenever the queue runs empty,
+      // so that _back never has to be reset to NULL by the consumer
+      // (on a separate cache line from the consumer-owned fields)
+      MPSCQueueNode* volatile _back;
+
+      // Consumer-owned
+      Byte _consumer_padding[64];
+      MPSCQueueNode* _front;
+      MPSCQueueNode _stub;
+
+      void pushNode(MPSCQueueNode* node);
+};
+
+template <class T>
+MPSCQueue<T>::MPSCQueue()
+   : _back(&_stub)
+   , _front(&_stub)
+{}
+
+template <class T>
+MPSCQueue<T>::~MPSCQueue()
+{}
+
+template <class T>
+void
+MPSCQueue<T>::push(T* element)
+{
+   pushNode(static_cast<MPSCQueueNode*>(element));
+}
+
+template <class T>
+void
+MPSCQueue<T>::pushNode(MPSCQueueNode* node)
+{
+   node->_mpsc_next = NULL;
+   // Full barrier on x86: the element is written before it is linked
+   MPSCQueueNode* prev = __sync_lock_test_and_set(&_back, node);
+   prev->_mpsc_next = node;
+}
+
+template <class T>
+T*
+MPSCQueue<T>::pop()
+{
+   MPSCQueueNode* front = _front;
+   MPSCQueueNode* next = front->_mpsc_next;
+
+   // Skip over the stub
+   if (front == &_stub)
+   {
+      if (next == NULL)
+         return (T*) NULL;
+      _front = next;
+      front = next;
+      next = next->_mpsc_next;
+   }
+
+   if (next != NULL)
+   {
+      _front = next;
+      return static_cast<T*>(front);
+   }
+
+   // 'front' is the last linked node. If it is not the last pushed node,
+   // a producer has not linked its node yet
+   if (front != _back)
+      return (T*) NULL;
+
+   // Re-queue the stub behind 'front' so that 'front' can be removed
+   pushNode(&_stub);
+   next = front->_mpsc_next;
+   if (next != NULL)
+   {
+      _front = next;
+      return static_cast<T*>(front);
+   }
+   return (T*) NULL;
+}
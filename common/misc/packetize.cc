@@ -3,22 +3,24 @@
 using namespace std;
 
 UnstructuredBuffer::UnstructuredBuffer()
+   : m_read_pos(0)
 {
 }
 
 const void* UnstructuredBuffer::getBuffer()
 {
-   return m_chars.data();
+   return m_chars.data() + m_read_pos;
 }
 
 void UnstructuredBuffer::clear()
 {
    m_chars.erase();
+   m_read_pos = 0;
 }
 
 int UnstructuredBuffer::size()
 {
-   return m_chars.size();
+   return m_chars.size() - m_read_pos;
 }
 
 // put buffer
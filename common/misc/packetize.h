@@ -21,6 +21,8 @@ class UnstructuredBuffer
 
 private:
     std::string m_chars;
+    // Bytes before m_read_pos have already been consumed by get()
+    size_t m_read_pos;
 
 public:
 
@@ -62,11 +64,18 @@ template<class T> void UnstructuredBuffer::put(const T* data, int num)
 template<class T> bool UnstructuredBuffer::get(T* data, int num)
 {
     assert(num >= 0);
-    if (m_chars.size() < (num * sizeof(T)))
+    if ((m_chars.size() - m_read_pos) < (num * sizeof(T)))
         return false;
 
-    m_chars.copy((char *) data, num * sizeof(T));
-    m_chars.erase(0, num * sizeof(T));
+    m_chars.copy((char *) data, num * sizeof(T), m_read_pos);
+    m_read_pos += num * sizeof(T);
+
+    // Recycle the storage once everything has been consumed
+    if (m_read_pos == m_chars.size())
+    {
+        m_chars.clear();
+        m_read_pos = 0;
+    }
 
     return true;
 }
@@ -0,0 +1,125 @@
+#include <assert.h>
+
+#include "slab_allocator.h"
+#include "log.h"
+
+// Blocks are aligned to this boundary so that any object fits
+static const size_t BLOCK_ALIGNMENT = 16;
+
+SlabAllocator::SlabAllocator(size_t block_size, UInt32 blocks_per_slab)
+   : _block_size(block_size)
+   , _blocks_per_slab(blocks_per_slab)
+   , _free_list_tls(TLS::create())
+   , _shared_head(NULL)
+   , _shared_size(0)
+{
+   if (_block_size < sizeof(Block))
+      _block_size = sizeof(Block);
+   _block_size = (_block_size + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+   assert(_blocks_per_slab > 0);
+}
+
+SlabAllocator::~SlabAllocator()
+{
+   for (vector<FreeList*>::iterator it = _free_list_vec.begin(); it != _free_list_vec.end(); it++)
+      delete *it;
+   for (vector<Byte*>::iterator it = _slab_list.begin(); it != _slab_list.end(); it++)
+      delete [] *it;
+   delete _free_list_tls;
+}
+
+void*
+SlabAllocator::allocate()
+{
+   FreeList* free_list = getFreeList();
+   if (!free_list->_head)
+      refill(free_list);
+
+   Block* block = free_list->_head;
+   free_list->_head = block->_next;
+   free_list->_size --;
+   return (void*) block;
+}
+
+void
+SlabAllocator::deallocate(void* ptr)
+{
+   if (!ptr)
+      return;
+
+   FreeList* free_list = getFreeList();
+   Block* block = (Block*) ptr;
+   block->_next = free_list->_head;
+   free_list->_head = block;
+   free_list->_size ++;
+
+   if (free_list->_size > 2 * _blocks_per_slab)
+      spill(free_list);
+}
+
+SlabAllocator::FreeList*
+SlabAllocator::getFreeList()
+{
+   FreeList* free_list = _free_list_tls->getPtr<FreeList>();
+   if (!free_list)
+   {
+      free_list = new FreeList();
+      _free_list_tls->set(free_list);
+
+      ScopedLock sl(_lock);
+      _free_list_vec.push_back(free_list);
+   }
+   return free_list;
+}
+
+void
+SlabAllocator::refill(FreeList* free_list)
+{
+   ScopedLock sl(_lock);
+
+   if (_shared_head)
+   {
+      // Take back a batch of blocks spilled by other threads
+      for (UInt32 i = 0; (i < _blocks_per_slab) && _shared_head; i++)
+      {
+         Block* block = _shared_head;
+         _shared_head = block->_next;
+         _shared_size --;
+
+         block->_next = free_list->_head;
+         free_list->_head = block;
+         free_list->_size ++;
+      }
+      return;
+   }
+
+   Byte* slab = new Byte[_block_size * _blocks_per_slab];
+   _slab_list.push_back(slab);
+   LOG_PRINT("Allocated slab(%p), Block Size(%u), Num Slabs(%u)",
+         slab, (UInt32) _block_size, (UInt32) _slab_list.size());
+
+   for (UInt32 i = 0; i < _blocks_per_slab; i++)
+   {
+      Block* block = (Block*) (slab + i * _block_size);
+      block->_next = free_list->_head;
+      free_list->_head = block;
+      free_list->_size ++;
+   }
+}
+
+void
+SlabAllocator::spill(FreeList* free_list)
+{
+   // Detach a batch from the local free list before taking the lock
+   Block* batch_head = free_list->_head;
+   Block* batch_tail = batch_head;
+   for (UInt32 i = 1; i < _blocks_per_slab; i++)
+      batch_tail = batch_tail->_next;
+   free_list->_head = batch_tail->_next;
+   free_list->_size -= _blocks_per_slab;
+
+   ScopedLock sl(_lock);
+   batch_tail->_next = _shared_head;
+   _shared_head = batch_head;
+   _shared_size += _blocks_per_slab;
+}
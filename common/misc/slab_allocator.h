@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "fixed_types.h"
+#include "lock.h"
+#include "tls.h"
+
+// Fixed-size block allocator with one free list per thread
+// Blocks are carved out of large slabs and are never returned to the
+// system until the allocator is destroyed. A block freed by a thread goes
+// onto that thread's free list, so allocate()/deallocate() take no lock
+// in the common case. Blocks allocated on one thread and freed on another
+// (e.g. events crossing sim threads) would otherwise pile up on the
+// consumer, so a free list that grows too long spills a batch of blocks
+// into a shared pool that other threads refill from.
+class SlabAllocator
+{
+   public:
+      SlabAllocator(size_t block_size, UInt32 blocks_per_slab = 1024);
+      ~SlabAllocator();
+
+      void* allocate();
+      void deallocate(void* ptr);
+
+      size_t getBlockSize() const { return _block_size; }
+
+   private:
+      class Block
+      {
+         public:
+            Block* _next;
+      };
+
+      class FreeList
+      {
+         public:
+            FreeList() : _head(NULL), _size(0) {}
+            Block* _head;
+            UInt32 _size;
+      };
+
+      size_t _block_size;
+      UInt32 _blocks_per_slab;
+      TLS* _free_list_tls;
+
+      // Shared state (protected by _lock)
+      Lock _lock;
+      Block* _shared_head;
+      UInt32 _shared_size;
+      vector<Byte*> _slab_list;
+      vector<FreeList*> _free_list_vec;
+
+      FreeList* getFreeList();
+      void refill(FreeList* free_list);
+      void spill(FreeList* free_list);
+};
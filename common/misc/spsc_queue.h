@@ -0,0 +1,122 @@
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+
+#include "fixed_types.h"
+
+// Lock-free bounded queue for exactly one producer and one consumer thread
+// The producer may push() several elements and make them visible to the
+// consumer all at once with publish(), so that a batch costs a single
+// memory barrier. _head is written only by the consumer and _tail only by
+// the producer; each side keeps a private copy of the other's index and
+// re-reads the shared one only when its private copy says the queue is
+// full (producer) or empty (consumer).
+template <class T>
+class SPSCQueue
+{
+   public:
+      SPSCQueue(UInt32 capacity);
+      ~SPSCQueue();
+
+      // Producer side
+      bool push(const T& element);
+      void publish();
+      UInt32 getNumUnpublished() { return _private_tail - _tail; }
+
+      // Consumer side
+      T* front();
+      void pop();
+      bool empty() { return (front() == (T*) NULL); }
+
+      UInt32 getCapacity() { return _capacity; }
+
+   private:
+      T* _elements;
+      UInt32 _capacity;
+      UInt32 _mask;
+
+      // Producer-owned (the padding keeps the shared indices on separate
+      // cache lines, without over-aligning the queue for 'new')
+      Byte _producer_padding[64];
+      volatile UInt32 _tail;
+      UInt32 _private_tail;
+      UInt32 _cached_head;
+
+      // Consumer-owned
+      Byte _consumer_padding[64];
+      volatile UInt32 _head;
+      UInt32 _cached_tail;
+};
+
+template <class T>
+SPSCQueue<T>::SPSCQueue(UInt32 capacity)
+   : _tail(0)
+   , _private_tail(0)
+   , _cached_head(0)
+   , _head(0)
+   , _cached_tail(0)
+{
+   // Round up to a power of 2 so that indices wrap with a mask
+   _capacity = 1;
+   while (_capacity < capacity)
+      _capacity <<= 1;
+   _mask = _capacity - 1;
+   _elements = new T[_capacity];
+}
+
+template <class T>
+SPSCQueue<T>::~SPSCQueue()
+{
+   delete [] _elements;
+}
+
+template <class T>
+bool
+SPSCQueue<T>::push(const T& element)
+{
+   if ((_private_tail - _cached_head) == _capacity)
+   {
+      _cached_head = _head;
+      if ((_private_tail - _cached_head) == _capacity)
+         return false;
+   }
+
+   _elements[_private_tail & _mask] = element;
+   _private_tail ++;
+   return true;
+}
+
+template <class T>
+void
+SPSCQueue<T>::publish()
+{
+   // Element stores must be visible before the new tail
+   __sync_synchronize();
+   _tail = _private_tail;
+}
+
+template <class T>
+T*
+SPSCQueue<T>::front()
+{
+   if (_head == _cached_tail)
+   {
+      _cached_tail = _tail;
+      if (_head == _cached_tail)
+         return (T*) NULL;
+      // Do not read the elements before the tail
+      __sync_synchronize();
+   }
+   return &_elements[_head & _mask];
+}
+
+template <class T>
+void
+SPSCQueue<T>::pop()
+{
+   assert(_head != _cached_tail);
+   // Finish reading the element before handing its slot back
+   __sync_synchronize();
+   _head = _head + 1;
+}
@@ -0,0 +1,96 @@
+#ifndef __TAG_SEARCH_H__
+#define __TAG_SEARCH_H__
+
+// Search of a tag in a packed array of tags (e.g., the ways of a cache set)
+// The tags are compared a vector at a time (SSE2, or AVX2 if compiled with it)
+// and the matches are read out of the comparison mask
+
+#include "fixed_types.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Bit i of the result is set if tags[i] == tag (num_tags <= 32)
+inline UInt32 matchTags(const IntPtr* tags, UInt32 num_tags, IntPtr tag)
+{
+   UInt32 mask = 0;
+   UInt32 i = 0;
+
+#if __SIZEOF_POINTER__ == 8
+#ifdef __AVX2__
+   __m256i key_256 = _mm256_set1_epi64x((long long) tag);
+   for ( ; (i + 4) <= num_tags; i += 4)
+   {
+      __m256i cmp = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*) (tags + i)), key_256);
+      mask |= ((UInt32) _mm256_movemask_pd(_mm256_castsi256_pd(cmp))) << i;
+   }
+#endif
+#ifdef __SSE2__
+   // No 64-bit compare in SSE2: both 32-bit halves must match
+   __m128i key_128 = _mm_set1_epi64x((long long) tag);
+   for ( ; (i + 2) <= num_tags; i += 2)
+   {
+      __m128i cmp = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (tags + i)), key_128);
+      cmp = _mm_and_si128(cmp, _mm_shuffle_epi32(cmp, _MM_SHUFFLE(2,3,0,1)));
+      mask |= ((UInt32) _mm_movemask_pd(_mm_castsi128_pd(cmp))) << i;
+   }
+#endif
+#elif __SIZEOF_POINTER__ == 4
+#ifdef __AVX2__
+   __m256i key_256 = _mm256_set1_epi32((int) tag);
+   for ( ; (i + 8) <= num_tags; i += 8)
+   {
+      __m256i cmp = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*) (tags + i)), key_256);
+      mask |= ((UInt32) _mm256_movemask_ps(_mm256_castsi256_ps(cmp))) << i;
+   }
+#endif
+#ifdef __SSE2__
+   __m128i key_128 = _mm_set1_epi32((int) tag);
+   for ( ; (i + 4) <= num_tags; i += 4)
+   {
+      __m128i cmp = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (tags + i)), key_128);
+      mask |= ((UInt32) _mm_movemask_ps(_mm_castsi128_ps(cmp))) << i;
+   }
+#endif
+#endif
+
+   for ( ; i < num_tags; i++)
+   {
+      if (tags[i] == tag)
+         mask |= (1U << i);
+   }
+   return mask;
+}
+
+// Index of the first (lowest) tag equal to 'tag', -1 if none
+inline SInt32 findFirstTag(const IntPtr* tags, UInt32 num_tags, IntPtr tag)
+{
+   for (UInt32 base = 0; base < num_tags; base += 32)
+   {
+      UInt32 num_window_tags = (num_tags - base < 32) ? (num_tags - base) : 32;
+      UInt32 mask = matchTags(tags + base, num_window_tags, tag);
+      if (mask != 0)
+         return base + __builtin_ctz(mask);
+   }
+   return -1;
+}
+
+// Index of the last (highest) tag equal to 'tag', -1 if none
+inline SInt32 findLastTag(const IntPtr* tags, UInt32 num_tags, IntPtr tag)
+{
+   for (UInt32 end = num_tags; end > 0; )
+   {
+      UInt32 base = (end > 32) ? (end - 32) : 0;
+      UInt32 mask = matchTags(tags + base, end - base, tag);
+      if (mask != 0)
+         return base + 31 - __builtin_clz(mask);
+      end = base;
+   }
+   return -1;
+}
+
+#endif /* __TAG_SEARCH_H__ */
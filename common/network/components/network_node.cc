@@ -49,14 +49,16 @@ NetworkNode::~NetworkNode()
 {}
 
 void
-NetworkNode::processNetPacket(NetPacket* input_net_packet, list<NetPacket*>& output_net_packet_list)
+NetworkNode::processNetPacket(NetPacket* input_net_packet, vector<NetPacket*>& output_net_packet_list)
 {
    LOG_ASSERT_ERROR(input_net_packet->time >= _last_net_packet_time,
          "Curr Net Packet Time(%llu), Last Net Packet Time(%llu)", input_net_packet->time, _last_net_packet_time);
    _last_net_packet_time = input_net_packet->time;
 
    NetworkMsg* input_network_msg = (NetworkMsg*) input_net_packet->data;
-   vector<NetworkMsg*> output_network_msg_list;
+   // Reuse the storage of the output msg list
+   vector<NetworkMsg*>& output_network_msg_list = _output_network_msg_list;
+   output_network_msg_list.clear();
 
    Router::Id sender_router_id(input_net_packet->sender, input_network_msg->_sender_router_index);
    Router::Id receiver_router_id(input_net_packet->receiver, input_network_msg->_receiver_router_index);
@@ -132,7 +134,7 @@ NetworkNode::processNetPacket(NetPacket* input_net_packet, list<NetPacket*>& out
       constructNetPackets(output_network_msg, output_net_packet_list);
    }
 
-   for (list<NetPacket*>::iterator it = output_net_packet_list.begin();
+   for (vector<NetPacket*>::iterator it = output_net_packet_list.begin();
          it != output_net_packet_list.end(); it ++)
    {
       printNetPacket(*it);
@@ -140,7 +142,7 @@ NetworkNode::processNetPacket(NetPacket* input_net_packet, list<NetPacket*>& out
 }
 
 void
-NetworkNode::constructNetPackets(NetworkMsg* network_msg, list<NetPacket*>& net_packet_list)
+NetworkNode::constructNetPackets(NetworkMsg* network_msg, vector<NetPacket*>& net_packet_list)
 {
    switch (network_msg->_type)
    {
@@ -152,17 +154,18 @@ NetworkNode::constructNetPackets(NetworkMsg* network_msg, list<NetPacket*>& net_
 
          flit->_net_packet->time += (flit->_normalized_time - flit->_normalized_time_at_entry);
 
-         // Get receiver router id
-         vector<Router::Id> receiving_router_id_list;
-         if (flit->_output_endpoint._index == Channel::Endpoint::ALL)
-         {
-            receiving_router_id_list = getRouterIdListFromOutputChannel(flit->_output_endpoint._channel_id);
-         }
-         else
+         // Unicast flit: sent to one receiver router
+         if (flit->_output_endpoint._index != Channel::Endpoint::ALL)
          {
-            receiving_router_id_list.push_back(getRouterIdFromOutputEndpoint(flit->_output_endpoint));
+            Router::Id& receiver_router_id = getRouterIdFromOutputEndpoint(flit->_output_endpoint);
+            addNetPacketEndpoints(flit->_net_packet, getRouterId(), receiver_router_id);
+            net_packet_list.push_back(flit->_net_packet);
+            break;
          }
 
+         // Broadcasted flit: sent to all the receiver routers of the output channel
+         vector<Router::Id>& receiving_router_id_list = getRouterIdListFromOutputChannel(flit->_output_endpoint._channel_id);
+
          vector<Router::Id>::iterator router_it = receiving_router_id_list.begin();
          for ( ; (router_it + 1) != receiving_router_id_list.end(); router_it ++)
          {
@@ -338,6 +341,20 @@ NetworkNode::initializeContentionModelCounters()
    _total_flits_processed.resize(_num_input_channels, 0);
 }
 
+void
+NetworkNode::resetCounters()
+{
+   _total_input_buffer_writes = 0;
+   _total_input_buffer_reads = 0;
+   _total_switch_allocator_requests = 0;
+   _total_crossbar_traversals.assign(_num_output_channels, 0);
+   _total_output_link_unicasts.assign(_num_output_channels, 0);
+   _total_output_link_broadcasts.assign(_num_output_channels, 0);
+
+   _total_contention_delay_counters.assign(_num_input_channels, 0);
+   _total_flits_processed.assign(_num_input_channels, 0);
+}
+
 void
 NetworkNode::updateEventCounters(Flit* flit)
 {
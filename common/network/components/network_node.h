@@ -39,7 +39,7 @@ public:
    static void addChannelMapping(vector<vector<Router::Id> >& channel_to_router_id_list__mapping, vector<Router::Id>& router_id);
 
    // Process NetworkMsg
-   void processNetPacket(NetPacket* input_net_packet, list<NetPacket*>& output_net_packet_list);
+   void processNetPacket(NetPacket* input_net_packet, vector<NetPacket*>& output_net_packet_list);
 
    // Channel::Endpoint <--> Router::Id
    Channel::Endpoint& getInputEndpointFromRouterId(Router::Id& router_id);
@@ -59,6 +59,9 @@ public:
    // Query Contention Counters
    double getAverageContentionDelay();
 
+   // Reset Event & Contention Counters
+   void resetCounters();
+
    // RouterPerformanceModel
    RouterPerformanceModel* getRouterPerformanceModel()
    { return _router_performance_model; }
@@ -92,6 +95,9 @@ private:
    vector<UInt64> _total_contention_delay_counters;
    vector<UInt64> _total_flits_processed;
 
+   // Output msgs of processNetPacket() (storage reused across calls)
+   vector<NetworkMsg*> _output_network_msg_list;
+
    // Cached Output Endpoint List - For all the available input channels
    vector< vector<Channel::Endpoint>* > _cached_output_endpoint_list;
 
@@ -116,7 +122,7 @@ private:
    // Perform Router and Link Traversal
    void performRouterAndLinkTraversal(NetworkMsg* output_network_msg);
    // Construct NetPackets
-   void constructNetPackets(NetworkMsg* network_msg, list<NetPacket*>& net_packet_list);
+   void constructNetPackets(NetworkMsg* network_msg, vector<NetPacket*>& net_packet_list);
    // Add NetPacket Endpoints
    void addNetPacketEndpoints(NetPacket* net_packet, Router::Id sender_router_id, Router::Id receiver_router_id);
   
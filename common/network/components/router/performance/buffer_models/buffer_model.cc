@@ -28,6 +28,21 @@ BufferModel::dequeue()
    return NULL;
 }
 
+BufferManagementMsg*
+BufferModel::splitFront(SInt32 num_phits)
+{
+   Flit* flit = _buffer.front();
+
+   LOG_ASSERT_ERROR(num_phits < flit->_num_phits, "Num Phits(%i) >= Flit Num Phits(%i)",
+         num_phits, flit->_num_phits);
+   LOG_ASSERT_ERROR(flit->_normalized_time >= _buffer_time,
+         "Flit Time(%llu) < Buffer Time(%llu)", flit->_normalized_time, _buffer_time);
+   _buffer_time = flit->_normalized_time + num_phits;
+
+   LOG_PRINT("splitFront(%i): Buffer Time(%llu)", num_phits, _buffer_time);
+   return NULL;
+}
+
 void
 BufferModel::updateFlitTime()
 {
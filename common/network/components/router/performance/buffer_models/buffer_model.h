@@ -23,6 +23,9 @@ class BufferModel
 
       virtual BufferManagementMsg* enqueue(Flit* flit);
       virtual BufferManagementMsg* dequeue();
+      // Remove the first 'num_phits' flits of the flit train at the front;
+      // the rest of the train stays at the front of the buffer
+      virtual BufferManagementMsg* splitFront(SInt32 num_phits);
       Flit* front() { return _buffer.front(); }
       bool empty() { return _buffer.empty(); }
       size_t size() { return _buffer.size(); }
@@ -21,3 +21,18 @@ CreditBufferModel::dequeue()
    
    return credit_msg;
 }
+
+BufferManagementMsg*
+CreditBufferModel::splitFront(SInt32 num_phits)
+{
+   Flit* flit = BufferModel::front();
+   // The flits leave one per cycle starting at the flit time, and so can the
+   // flits sent by the upstream router into the freed buffers
+   CreditMsg* credit_msg = new CreditMsg(flit->_normalized_time, num_phits);
+
+   LOG_PRINT("Data: allocate(%p)", credit_msg);
+
+   BufferModel::splitFront(num_phits);
+
+   return credit_msg;
+}
@@ -10,4 +10,5 @@ class CreditBufferModel : public FiniteBufferModel
       ~CreditBufferModel();
 
       BufferManagementMsg* dequeue();
+      BufferManagementMsg* splitFront(SInt32 num_phits);
 };
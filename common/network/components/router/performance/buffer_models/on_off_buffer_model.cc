@@ -56,3 +56,10 @@ OnOffBufferModel::dequeue()
    
    return on_off_msg;
 }
+
+BufferManagementMsg*
+OnOffBufferModel::splitFront(SInt32 num_phits)
+{
+   LOG_PRINT_ERROR("On Off Buffer Management Scheme does not work with flit trains");
+   return (BufferManagementMsg*) NULL;
+}
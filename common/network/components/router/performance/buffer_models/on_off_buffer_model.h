@@ -11,6 +11,7 @@ class OnOffBufferModel : public FiniteBufferModel
 
       BufferManagementMsg* enqueue(Flit* flit);
       BufferManagementMsg* dequeue();
+      BufferManagementMsg* splitFront(SInt32 num_phits);
    
    private:
       SInt32 _on_off_threshold;
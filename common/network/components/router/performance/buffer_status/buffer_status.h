@@ -15,6 +15,8 @@ public:
    virtual void allocate(Flit* flit, SInt32 num_buffers) = 0;
    virtual UInt64 tryAllocate(Flit* flit, SInt32 num_buffers) = 0;
    virtual void receive(BufferManagementMsg* msg) = 0;
+   // Number of buffers that can be allocated now (as far as this router knows)
+   virtual SInt32 getNumFreeBuffers() = 0;
 
    static BufferStatus* create(BufferManagementScheme::Type buffer_management_scheme, SInt32 size_buffer);
 };
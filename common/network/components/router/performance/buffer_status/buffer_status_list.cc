@@ -1,14 +1,17 @@
+#include <climits>
+
 #include "buffer_status_list.h"
 #include "log.h"
 
 BufferStatusList::BufferStatusList(SInt32 num_output_endpoints,
       BufferManagementScheme::Type buffer_management_scheme,
-      SInt32 size_buffer)
+      SInt32 size_buffer, SInt32 num_vcs)
    : _num_output_endpoints(num_output_endpoints)
+   , _num_vcs(num_vcs)
    , _channel_free_time(0)
 {
-   _buffer_status_vec.resize(_num_output_endpoints);
-   for (SInt32 i = 0; i < _num_output_endpoints; i++)
+   _buffer_status_vec.resize(_num_output_endpoints * _num_vcs);
+   for (SInt32 i = 0; i < _num_output_endpoints * _num_vcs; i++)
    {
       _buffer_status_vec[i] = BufferStatus::create(buffer_management_scheme, size_buffer);
    }
@@ -16,14 +19,14 @@ BufferStatusList::BufferStatusList(SInt32 num_output_endpoints,
 
 BufferStatusList::~BufferStatusList()
 {
-   for (SInt32 i = 0; i < _num_output_endpoints; i++)
+   for (SInt32 i = 0; i < _num_output_endpoints * _num_vcs; i++)
    {
       delete _buffer_status_vec[i];
    }
 }
 
 void
-BufferStatusList::allocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_buffers)
+BufferStatusList::allocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_buffers, SInt32 vc_id)
 {
    // We can surely allocate buffers here
    if (endpoint_index == Channel::Endpoint::ALL)
@@ -31,13 +34,13 @@ BufferStatusList::allocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_b
       // Broadcasted flit
       for (SInt32 i = 0; i < _num_output_endpoints; i++)
       {
-         _buffer_status_vec[i]->allocate(flit, num_buffers);
+         getBufferStatus(i, vc_id)->allocate(flit, num_buffers);
       }
    }
    else
    {
       // Before allocating buffer, always update the buffer with the _channel_time
-      _buffer_status_vec[endpoint_index]->allocate(flit, num_buffers);
+      getBufferStatus(endpoint_index, vc_id)->allocate(flit, num_buffers);
    }
 
    // Update Channel Free Time
@@ -46,13 +49,15 @@ BufferStatusList::allocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_b
 }
 
 UInt64
-BufferStatusList::tryAllocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_buffers)
+BufferStatusList::tryAllocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_buffers, SInt32 vc_id)
 {
    // Check if buffers can be allocated at the downstream router
    LOG_ASSERT_ERROR((endpoint_index == Channel::Endpoint::ALL) ||
                     ((endpoint_index >= 0) && (endpoint_index < _num_output_endpoints)),
                     "Invalid Endpoint Index(%i): should be ALL(0x%x) or within [0,%i]",
                     endpoint_index, Channel::Endpoint::ALL, _num_output_endpoints-1);
+   LOG_ASSERT_ERROR((vc_id >= 0) && (vc_id < _num_vcs), "Invalid VC(%i): should be within [0,%i]",
+                    vc_id, _num_vcs-1);
 
    // Initially, set the allocated time to time when channel is free
    UInt64 allocated_time = _channel_free_time;
@@ -62,13 +67,13 @@ BufferStatusList::tryAllocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 nu
       // Flit broadcasted to all endpoints of a channel
       for (SInt32 i = 0; (i < _num_output_endpoints) && (allocated_time != UINT64_MAX_); i++)
       {
-         allocated_time = max<UInt64>(allocated_time, _buffer_status_vec[i]->tryAllocate(flit, num_buffers));
+         allocated_time = max<UInt64>(allocated_time, getBufferStatus(i, vc_id)->tryAllocate(flit, num_buffers));
       }
    }
    else
    {
       // Flit sent to only one endpoint of a channel
-      allocated_time = max<UInt64>(allocated_time, _buffer_status_vec[endpoint_index]->tryAllocate(flit, num_buffers));
+      allocated_time = max<UInt64>(allocated_time, getBufferStatus(endpoint_index, vc_id)->tryAllocate(flit, num_buffers));
    }
   
    LOG_PRINT("Allocated Time(%llu)", allocated_time); 
@@ -78,5 +83,20 @@ BufferStatusList::tryAllocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 nu
 void
 BufferStatusList::receiveBufferManagementMsg(BufferManagementMsg* buffer_msg, SInt32 endpoint_index)
 {
-   _buffer_status_vec[endpoint_index]->receive(buffer_msg);
+   // Buffer management msgs carry the virtual channel whose buffers they free
+   getBufferStatus(endpoint_index, buffer_msg->_vc_id)->receive(buffer_msg);
+}
+
+SInt32
+BufferStatusList::getNumFreeBuffers(SInt32 endpoint_index)
+{
+   LOG_ASSERT_ERROR((endpoint_index >= 0) && (endpoint_index < _num_output_endpoints),
+                    "Invalid Endpoint Index(%i): should be within [0,%i]",
+                    endpoint_index, _num_output_endpoints-1);
+
+   // Infinite buffers report INT_MAX each
+   SInt64 num_free_buffers = 0;
+   for (SInt32 vc_id = 0; vc_id < _num_vcs; vc_id++)
+      num_free_buffers += getBufferStatus(endpoint_index, vc_id)->getNumFreeBuffers();
+   return (SInt32) min<SInt64>(num_free_buffers, INT_MAX);
 }
@@ -10,20 +10,28 @@ using namespace std;
 #include "buffer_status.h"
 
 // An object of this class is instantiated for every output channel
+// Each endpoint has 'num_vcs' virtual channels with 'size_buffer' buffers each;
+// the virtual channels share the output link (_channel_free_time)
 class BufferStatusList
 {
    public:
       BufferStatusList(SInt32 num_output_endpoints, 
                        BufferManagementScheme::Type buffer_management_scheme,
-                       SInt32 size_buffer);
+                       SInt32 size_buffer, SInt32 num_vcs = 1);
       ~BufferStatusList();
 
-      void allocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_buffers);
-      UInt64 tryAllocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_buffers);
+      void allocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_buffers, SInt32 vc_id = 0);
+      UInt64 tryAllocateBuffer(Flit* flit, SInt32 endpoint_index, SInt32 num_buffers, SInt32 vc_id = 0);
       void receiveBufferManagementMsg(BufferManagementMsg* buffer_msg, SInt32 endpoint_index);
+      // Free buffers of all the VCs of an endpoint
+      SInt32 getNumFreeBuffers(SInt32 endpoint_index);
 
    private:
       vector<BufferStatus*> _buffer_status_vec;
       SInt32 _num_output_endpoints;
+      SInt32 _num_vcs;
       UInt64 _channel_free_time;
+
+      BufferStatus* getBufferStatus(SInt32 endpoint_index, SInt32 vc_id)
+      { return _buffer_status_vec[endpoint_index * _num_vcs + vc_id]; }
 };
@@ -12,6 +12,7 @@ class CreditStatus : public FiniteBufferStatus
       void allocate(Flit* flit, SInt32 num_buffers);
       UInt64 tryAllocate(Flit* flit, SInt32 num_buffers);
       void receive(BufferManagementMsg* buffer_mangement_msg);
+      SInt32 getNumFreeBuffers() { return _credit_count; }
    
    private:
       SInt32 _credit_count;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <climits>
 
 #include "fixed_types.h"
 #include "buffer_status.h"
@@ -14,4 +15,5 @@ class InfiniteBufferStatus : public BufferStatus
       void allocate(Flit* flit, SInt32 num_buffers) {}
       UInt64 tryAllocate(Flit* flit, SInt32 num_buffers) { return 0; }
       void receive(BufferManagementMsg* msg) { assert(false); }
+      SInt32 getNumFreeBuffers() { return INT_MAX; }
 };
@@ -15,6 +15,8 @@ class OnOffStatus : public FiniteBufferStatus
       void allocate(Flit* flit, SInt32 num_buffers);
       UInt64 tryAllocate(Flit* flit, SInt32 num_buffers);
       void receive(BufferManagementMsg* buffer_mangement_msg);
+      // Only tells whether the downstream buffer is above the 'off' threshold
+      SInt32 getNumFreeBuffers() { return _on_off_status ? _size_buffer : 0; }
    
    private:
       bool _on_off_status;
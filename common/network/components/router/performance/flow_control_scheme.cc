@@ -3,8 +3,30 @@
 #include "virtual_cut_through_flow_control_scheme.h"
 #include "wormhole_flow_control_scheme.h"
 #include "wormhole_unicast__virtual_cut_through_broadcast__flow_control_scheme.h"
+#include "wormhole_virtual_channel_flow_control_scheme.h"
+#include "buffer_status_list.h"
 #include "log.h"
 
+FlowControlScheme::FlowControlScheme(SInt32 num_input_channels, SInt32 num_output_channels):
+   _num_input_channels(num_input_channels),
+   _num_output_channels(num_output_channels),
+   _vec_downstream_buffer_status_list(num_output_channels, (BufferStatusList*) NULL)
+{}
+
+FlowControlScheme::~FlowControlScheme()
+{
+   for (SInt32 i = 0; i < _num_output_channels; i++)
+   {
+      delete _vec_downstream_buffer_status_list[i];
+   }
+}
+
+SInt32
+FlowControlScheme::getNumFreeDownstreamBuffers(Channel::Endpoint& output_endpoint)
+{
+   return _vec_downstream_buffer_status_list[output_endpoint._channel_id]->getNumFreeBuffers(output_endpoint._index);
+}
+
 FlowControlScheme::Type
 FlowControlScheme::parse(string flow_control_scheme_str)
 {
@@ -16,6 +38,10 @@ FlowControlScheme::parse(string flow_control_scheme_str)
       return WORMHOLE;
    else if (flow_control_scheme_str == "wormhole_unicast__virtual_cut_through_broadcast")
       return WORMHOLE_UNICAST__VIRTUAL_CUT_THROUGH_BROADCAST;
+   else if (flow_control_scheme_str == "wormhole_flit_train")
+      return WORMHOLE_FLIT_TRAIN;
+   else if (flow_control_scheme_str == "wormhole_virtual_channel")
+      return WORMHOLE_VIRTUAL_CHANNEL;
    else
    {
       LOG_PRINT_ERROR("Unrecognized Flow Control Scheme(%s)", flow_control_scheme_str.c_str());
@@ -30,7 +56,8 @@ FlowControlScheme::create(Type flow_control_scheme,
       vector<BufferManagementScheme::Type>& input_buffer_management_schemes,
       vector<BufferManagementScheme::Type>& downstream_buffer_management_schemes,
       vector<SInt32>& input_buffer_size_list,
-      vector<SInt32>& downstream_buffer_size_list)
+      vector<SInt32>& downstream_buffer_size_list,
+      SInt32 num_vcs)
 {
    switch(flow_control_scheme)
    {
@@ -49,6 +76,7 @@ FlowControlScheme::create(Type flow_control_scheme,
                input_buffer_size_list, downstream_buffer_size_list);
 
       case WORMHOLE:
+      case WORMHOLE_FLIT_TRAIN:
          return new WormholeFlowControlScheme( \
                num_input_channels, num_output_channels, \
                num_input_endpoints_list, num_output_endpoints_list, \
@@ -62,6 +90,14 @@ FlowControlScheme::create(Type flow_control_scheme,
                input_buffer_management_schemes, downstream_buffer_management_schemes, \
                input_buffer_size_list, downstream_buffer_size_list);
 
+      case WORMHOLE_VIRTUAL_CHANNEL:
+         return new WormholeVirtualChannelFlowControlScheme( \
+               num_input_channels, num_output_channels, \
+               num_input_endpoints_list, num_output_endpoints_list, \
+               input_buffer_management_schemes, downstream_buffer_management_schemes, \
+               input_buffer_size_list, downstream_buffer_size_list, \
+               num_vcs);
+
       default:
          LOG_PRINT_ERROR("Unrecognized Flow Control Scheme(%u)", flow_control_scheme);
          return (FlowControlScheme*) NULL;
@@ -70,7 +106,7 @@ FlowControlScheme::create(Type flow_control_scheme,
 
 void
 FlowControlScheme::dividePacket(Type flow_control_scheme,
-                                NetPacket* net_packet, list<NetPacket*>& net_packet_list,
+                                NetPacket* net_packet, vector<NetPacket*>& net_packet_list,
                                 SInt32 serialization_latency)
 {
    LOG_PRINT("dividePacket(FLOW_CONTROL_SCHEME - %u) enter", flow_control_scheme);
@@ -83,9 +119,14 @@ FlowControlScheme::dividePacket(Type flow_control_scheme,
 
       case WORMHOLE:
       case WORMHOLE_UNICAST__VIRTUAL_CUT_THROUGH_BROADCAST:
+      case WORMHOLE_VIRTUAL_CHANNEL:
          FlitBufferFlowControlScheme::dividePacket(net_packet, net_packet_list, serialization_latency);
          break;
 
+      case WORMHOLE_FLIT_TRAIN:
+         FlitBufferFlowControlScheme::dividePacketIntoFlitTrain(net_packet, net_packet_list, serialization_latency);
+         break;
+
       default:
          LOG_PRINT_ERROR("Unrecognized Flow Control Scheme(%u)", flow_control_scheme);
          break;
@@ -104,6 +145,8 @@ FlowControlScheme::isPacketComplete(Type flow_control_scheme, Flit::Type flit_ty
 
       case WORMHOLE:
       case WORMHOLE_UNICAST__VIRTUAL_CUT_THROUGH_BROADCAST:
+      case WORMHOLE_FLIT_TRAIN:
+      case WORMHOLE_VIRTUAL_CHANNEL:
          return FlitBufferFlowControlScheme::isPacketComplete(flit_type);
 
       default:
@@ -11,6 +11,8 @@ using namespace std;
 #include "buffer_management_msg.h"
 #include "buffer_model.h"
 
+class BufferStatusList;
+
 class FlowControlScheme
 {
    public:
@@ -20,14 +22,13 @@ class FlowControlScheme
          VIRTUAL_CUT_THROUGH,
          WORMHOLE,
          WORMHOLE_UNICAST__VIRTUAL_CUT_THROUGH_BROADCAST,
+         WORMHOLE_FLIT_TRAIN,
+         WORMHOLE_VIRTUAL_CHANNEL,
          NUM_SCHEMES
       };
 
-      FlowControlScheme(SInt32 num_input_channels, SInt32 num_output_channels):
-         _num_input_channels(num_input_channels),
-         _num_output_channels(num_output_channels)
-      {}
-      virtual ~FlowControlScheme() {};
+      FlowControlScheme(SInt32 num_input_channels, SInt32 num_output_channels);
+      virtual ~FlowControlScheme();
 
       static Type parse(string flow_control_scheme_str);
       
@@ -36,10 +37,11 @@ class FlowControlScheme
             vector<SInt32>& num_input_endpoints_list, vector<SInt32>& num_output_endpoints_list,
             vector<BufferManagementScheme::Type>& input_buffer_management_schemes,
             vector<BufferManagementScheme::Type>& downstream_buffer_management_schemes,
-            vector<SInt32>& input_buffer_size_list, vector<SInt32>& downstream_buffer_size_list);
+            vector<SInt32>& input_buffer_size_list, vector<SInt32>& downstream_buffer_size_list,
+            SInt32 num_vcs = 1);
 
       static void dividePacket(Type flow_control_scheme,
-                               NetPacket* net_packet, list<NetPacket*>& net_packet_list,
+                               NetPacket* net_packet, vector<NetPacket*>& net_packet_list,
                                SInt32 serialization_latency);
       static bool isPacketComplete(Type flow_control_scheme, Flit::Type flit_type);
 
@@ -49,8 +51,14 @@ class FlowControlScheme
             vector<NetworkMsg*>& network_msg_list) = 0;
 
       virtual BufferModel* getBufferModel(SInt32 input_channel_id) = 0;
+      // Free buffers at the downstream router of an output endpoint (for adaptive routing)
+      // With virtual channels, summed over the downstream VCs
+      SInt32 getNumFreeDownstreamBuffers(Channel::Endpoint& output_endpoint);
 
    protected:
       SInt32 _num_input_channels;
       SInt32 _num_output_channels;
+      // Downstream buffer usage histories (one per output channel), created by the
+      // derived classes and deleted here
+      vector<BufferStatusList*> _vec_downstream_buffer_status_list;
 };
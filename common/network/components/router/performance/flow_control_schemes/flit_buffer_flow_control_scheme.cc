@@ -13,7 +13,7 @@ FlitBufferFlowControlScheme::~FlitBufferFlowControlScheme()
 
 void
 FlitBufferFlowControlScheme::dividePacket(NetPacket* net_packet,
-                                          list<NetPacket*>& net_packet_list,
+                                          vector<NetPacket*>& net_packet_list,
                                           SInt32 serialization_latency)
 {
    LOG_PRINT("dividePacket(%p, %i) enter", net_packet, serialization_latency);
@@ -56,6 +56,28 @@ FlitBufferFlowControlScheme::dividePacket(NetPacket* net_packet,
    LOG_PRINT("dividePacket() exit");
 }
 
+void
+FlitBufferFlowControlScheme::dividePacketIntoFlitTrain(NetPacket* net_packet,
+                                                       vector<NetPacket*>& net_packet_list,
+                                                       SInt32 serialization_latency)
+{
+   LOG_PRINT("dividePacketIntoFlitTrain(%p, %i) enter", net_packet, serialization_latency);
+
+   // The train carries the whole packet: the head flit leaves at 'time' and
+   // the tail flit at 'time + _num_phits - 1'
+   HeadFlit* head_flit = new HeadFlit(serialization_latency /* num_flits */,
+                                      serialization_latency /* num_phits */,
+                                      net_packet->sender, net_packet->receiver);
+   head_flit->_type = (Flit::Type) ( ((SInt32) Flit::HEAD) | ((SInt32) Flit::TAIL) );
+   NetPacket* head_flit_packet = new NetPacket(net_packet->time, net_packet->type,
+         head_flit->size(), (void*) head_flit,
+         false /* is_raw */, net_packet->sequence_num);
+   head_flit_packet->start_time = net_packet->start_time;
+   net_packet_list.push_back(head_flit_packet);
+
+   LOG_PRINT("dividePacketIntoFlitTrain() exit");
+}
+
 bool
 FlitBufferFlowControlScheme::isPacketComplete(Flit::Type flit_type)
 {
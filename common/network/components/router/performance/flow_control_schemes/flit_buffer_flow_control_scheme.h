@@ -1,6 +1,6 @@
 #pragma once
 
-#include <list>
+#include <vector>
 using namespace std;
 
 #include "fixed_types.h"
@@ -18,8 +18,12 @@ class FlitBufferFlowControlScheme : public FlowControlScheme
       ~FlitBufferFlowControlScheme();
       
       // Dividing and coalescing packet at start and end
-      static void dividePacket(NetPacket* net_packet, list<NetPacket*>& net_packet_list,
+      static void dividePacket(NetPacket* net_packet, vector<NetPacket*>& net_packet_list,
                                SInt32 num_flits);
+      // A flit train is a single message standing for 'num_flits' consecutive flits
+      // (one phit each). It is only split up by the routers when they run out of buffers
+      static void dividePacketIntoFlitTrain(NetPacket* net_packet, vector<NetPacket*>& net_packet_list,
+                                            SInt32 num_flits);
       static bool isPacketComplete(Flit::Type flit_type);
    
    protected:
@@ -45,6 +49,7 @@ class FlitBufferFlowControlScheme : public FlowControlScheme
             // Just want to call the public functions of BufferModel
             BufferManagementMsg* enqueue(Flit* flit) { return _buffer->enqueue(flit); }
             BufferManagementMsg* dequeue() { return _buffer->dequeue(); }
+            BufferManagementMsg* splitFront(SInt32 num_phits) { return _buffer->splitFront(num_phits); }
             Flit* front() { return _buffer->front(); }
             bool empty() { return _buffer->empty(); }
             size_t size() { return _buffer->size(); }
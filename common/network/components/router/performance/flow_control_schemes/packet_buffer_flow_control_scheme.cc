@@ -19,7 +19,6 @@ PacketBufferFlowControlScheme::PacketBufferFlowControlScheme(
    }
 
    // Create downstream buffer usage histories
-   _vec_downstream_buffer_status_list.resize(_num_output_channels);
    for (SInt32 i = 0; i < _num_output_channels; i++)
    {
       _vec_downstream_buffer_status_list[i] =  new BufferStatusList(num_output_endpoints_list[i],
@@ -33,10 +32,6 @@ PacketBufferFlowControlScheme::~PacketBufferFlowControlScheme()
    {
       delete _input_packet_buffer_vec[i];
    }
-   for (SInt32 i = 0; i < _num_output_channels; i++)
-   {
-      delete _vec_downstream_buffer_status_list[i];
-   }
 }
 
 void
@@ -174,9 +169,6 @@ PacketBufferFlowControlScheme::sendPacket(SInt32 input_channel)
       upstream_buffer_msg->_input_endpoint = head_flit->_input_endpoint;
       _network_msg_list->push_back(upstream_buffer_msg);
    }
-         
-   // Delete _output_endpoint_list
-   delete head_flit->_output_endpoint_list;
 
    // Release the Net-packet and hence the flit
    head_flit->_net_packet->release();
@@ -199,7 +191,7 @@ PacketBufferFlowControlScheme::tryAllocateDownstreamBuffer(HeadFlit* head_flit,
 }
 
 void
-PacketBufferFlowControlScheme::dividePacket(NetPacket* net_packet, list<NetPacket*>& net_packet_list,
+PacketBufferFlowControlScheme::dividePacket(NetPacket* net_packet, vector<NetPacket*>& net_packet_list,
                                             SInt32 serialization_latency)
 {
    LOG_PRINT("PACKET_BUFFER: dividePacket(%p,%i) enter", net_packet, serialization_latency);
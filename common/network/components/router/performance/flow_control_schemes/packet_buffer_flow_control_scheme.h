@@ -1,8 +1,7 @@
 #pragma once
 
-#include <vector>
 #include <queue>
-#include <list>
+#include <vector>
 using namespace std;
 
 #include "fixed_types.h"
@@ -27,7 +26,7 @@ class PacketBufferFlowControlScheme : public FlowControlScheme
       void processBufferManagementMsg(BufferManagementMsg* buffer_management_msg, vector<NetworkMsg*>& network_msg_list);
 
       // Dividing and coalescing packet at start and end
-      static void dividePacket(NetPacket* net_packet, list<NetPacket*>& net_packet_list, SInt32 serialization_latency);
+      static void dividePacket(NetPacket* net_packet, vector<NetPacket*>& net_packet_list, SInt32 serialization_latency);
       static bool isPacketComplete(Flit::Type flit_type);
 
       BufferModel* getBufferModel(SInt32 input_channel_id)
@@ -37,7 +36,6 @@ class PacketBufferFlowControlScheme : public FlowControlScheme
       typedef BufferModel PacketBuffer;
 
       vector<PacketBuffer*> _input_packet_buffer_vec;
-      vector<BufferStatusList*> _vec_downstream_buffer_status_list;
       vector<NetworkMsg*>* _network_msg_list;
 
       // Private Functions
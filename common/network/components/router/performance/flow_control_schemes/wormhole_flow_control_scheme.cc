@@ -19,7 +19,6 @@ WormholeFlowControlScheme::WormholeFlowControlScheme(
    }
 
    // Create downstream buffer usage histories
-   _vec_downstream_buffer_status_list.resize(_num_output_channels);
    for (SInt32 i = 0; i < _num_output_channels; i++)
    {
       _vec_downstream_buffer_status_list[i] = new BufferStatusList(num_output_endpoints_list[i],
@@ -40,10 +39,6 @@ WormholeFlowControlScheme::~WormholeFlowControlScheme()
    {
       delete _input_flit_buffer_vec[i];
    }
-   for (SInt32 i = 0; i < _num_output_channels; i++)
-   {
-      delete _vec_downstream_buffer_status_list[i];
-   }
 }
 
 void
@@ -205,14 +200,24 @@ WormholeFlowControlScheme::sendFlit(SInt32 input_channel)
    // All Output Channels are now allocated
 
    // Now, allocate a downstream buffer
+   // A flit train (_num_phits > 1) needs one buffer per flit. If the downstream
+   // routers do not have buffers for all of them, send the flits that fit
+   // (the same number to every output endpoint)
+   SInt32 num_flits = flit->_num_phits;
    UInt64 max_allocated_time = 0;
 
    vector<Channel::Endpoint>::iterator endpoint_it = flit_buffer->_output_endpoint_list->begin();
-   for ( ; endpoint_it != flit_buffer->_output_endpoint_list->end(); endpoint_it ++)
+   while (endpoint_it != flit_buffer->_output_endpoint_list->end())
    {
       Channel::Endpoint output_endpoint = *endpoint_it;
       
-      UInt64 allocated_time = tryAllocateDownstreamBuffer(flit, output_endpoint);
+      SInt32 endpoint_num_flits = num_flits;
+      UInt64 allocated_time = tryAllocateDownstreamBuffer(flit, output_endpoint, endpoint_num_flits);
+      while ((allocated_time == UINT64_MAX_) && (endpoint_num_flits > 1))
+      {
+         endpoint_num_flits --;
+         allocated_time = tryAllocateDownstreamBuffer(flit, output_endpoint, endpoint_num_flits);
+      }
       if (allocated_time == UINT64_MAX_)
       {
          LOG_PRINT("Could not allocate a buffer for output endpoint(%i,%i)",
@@ -222,8 +227,20 @@ WormholeFlowControlScheme::sendFlit(SInt32 input_channel)
          return make_pair<bool,bool>(false,false);
       }
 
+      if ((endpoint_num_flits < num_flits) && (endpoint_it != flit_buffer->_output_endpoint_list->begin()))
+      {
+         // The allocated times of the previous endpoints are for a longer train,
+         // start over with the shorter one
+         num_flits = endpoint_num_flits;
+         max_allocated_time = 0;
+         endpoint_it = flit_buffer->_output_endpoint_list->begin();
+         continue;
+      }
+      num_flits = endpoint_num_flits;
+
       // Compute the maximum
       max_allocated_time = max<UInt64>(max_allocated_time, allocated_time);
+      endpoint_it ++;
    }
 
    // All output endpoints have a free buffer
@@ -231,6 +248,12 @@ WormholeFlowControlScheme::sendFlit(SInt32 input_channel)
 
    // Update Flit Time to max_allocated_time
    flit->_normalized_time = max<UInt64>(flit->_normalized_time, max_allocated_time);
+
+   // The flits that do not fit stay in the input buffer
+   BufferManagementMsg* upstream_buffer_msg = NULL;
+   Flit* train_flit = flit;
+   if (num_flits < flit->_num_phits)
+      flit = splitFlitTrain(flit_buffer, num_flits, upstream_buffer_msg);
    
    // Send Flit to all output endpoints
    endpoint_it = flit_buffer->_output_endpoint_list->begin();
@@ -240,7 +263,7 @@ WormholeFlowControlScheme::sendFlit(SInt32 input_channel)
       LOG_PRINT("Downstream Buffer allocated for Output Endpoint(%i,%i)",
             output_endpoint._channel_id, output_endpoint._index);
       
-      allocateDownstreamBuffer(flit, output_endpoint);
+      allocateDownstreamBuffer(flit, output_endpoint, flit->_num_phits);
 
       // Duplicate flit and net_packet
       NetPacket* cloned_net_packet = flit->_net_packet->clone();
@@ -267,12 +290,15 @@ WormholeFlowControlScheme::sendFlit(SInt32 input_channel)
       }
    }
 
-   // Update Buffer Time for next flit
-   LOG_PRINT("Updating Buffer Time");
-   flit_buffer->updateBufferTime();
+   if (flit == train_flit)
+   {
+      // Update Buffer Time for next flit
+      LOG_PRINT("Updating Buffer Time");
+      flit_buffer->updateBufferTime();
 
-   // Remove flit from queue
-   BufferManagementMsg* upstream_buffer_msg = flit_buffer->dequeue();
+      // Remove flit from queue
+      upstream_buffer_msg = flit_buffer->dequeue();
+   }
    if (upstream_buffer_msg)
    {
       LOG_PRINT("Sending Upstream Buffer Msg (%p)", upstream_buffer_msg);
@@ -293,8 +319,7 @@ WormholeFlowControlScheme::sendFlit(SInt32 input_channel)
       LOG_PRINT("TAIL flit");
 
       // All flits of the packet have been sent on all output channels
-      // Delete _output_endpoint_list
-      delete flit_buffer->_output_endpoint_list;
+      // (_output_endpoint_list belongs to the routing table)
       flit_buffer->_output_endpoint_list = NULL;
 
       // Set Output Channels allocated to false
@@ -311,18 +336,44 @@ WormholeFlowControlScheme::sendFlit(SInt32 input_channel)
    }
 }
 
+// Splits the first 'num_flits' flits off the flit train at the front of 'flit_buffer'
+// and returns them as a new flit train. The rest of the train stays in the buffer,
+// and moves back as if its first flit had arrived 'num_flits' cycles after the head
+Flit*
+WormholeFlowControlScheme::splitFlitTrain(FlitBuffer* flit_buffer, SInt32 num_flits,
+                                          BufferManagementMsg*& upstream_buffer_msg)
+{
+   Flit* flit = flit_buffer->front();
+   LOG_PRINT("splitFlitTrain(%p, %i): Num Phits(%i)", flit, num_flits, flit->_num_phits);
+
+   NetPacket* split_net_packet = flit->_net_packet->clone();
+   Flit* split_flit = (Flit*) split_net_packet->data;
+   split_flit->_net_packet = split_net_packet;
+   split_flit->_num_phits = num_flits;
+   split_flit->_type = (flit->_type & Flit::HEAD) ? Flit::HEAD : Flit::BODY;
+
+   // Frees 'num_flits' buffers and moves the buffer time past the split flits
+   upstream_buffer_msg = flit_buffer->splitFront(num_flits);
+
+   flit->_type = (Flit::Type) ( ((SInt32) Flit::BODY) | (flit->_type & Flit::TAIL) );
+   flit->_num_phits -= num_flits;
+   flit->_normalized_time += num_flits;
+   flit->_normalized_time_at_entry += num_flits;
+   flit->_net_packet->time += num_flits;
+
+   return split_flit;
+}
+
 void
-WormholeFlowControlScheme::allocateDownstreamBuffer(Flit* flit, Channel::Endpoint& output_endpoint)
+WormholeFlowControlScheme::allocateDownstreamBuffer(Flit* flit, Channel::Endpoint& output_endpoint, SInt32 num_buffers)
 {
-   LOG_ASSERT_ERROR(flit->_num_phits == 1, "Num Phits(%i)", flit->_num_phits);
    BufferStatusList* buffer_status_list = _vec_downstream_buffer_status_list[output_endpoint._channel_id];
-   buffer_status_list->allocateBuffer(flit, output_endpoint._index, flit->_num_phits);
+   buffer_status_list->allocateBuffer(flit, output_endpoint._index, num_buffers);
 }
 
 UInt64
-WormholeFlowControlScheme::tryAllocateDownstreamBuffer(Flit* flit, Channel::Endpoint& output_endpoint)
+WormholeFlowControlScheme::tryAllocateDownstreamBuffer(Flit* flit, Channel::Endpoint& output_endpoint, SInt32 num_buffers)
 {
-   LOG_ASSERT_ERROR(flit->_num_phits == 1, "Num Phits(%i), Flit(%s)", flit->_num_phits, flit->getTypeString().c_str());
    BufferStatusList* buffer_status_list = _vec_downstream_buffer_status_list[output_endpoint._channel_id];
-   return buffer_status_list->tryAllocateBuffer(flit, output_endpoint._index, flit->_num_phits);
+   return buffer_status_list->tryAllocateBuffer(flit, output_endpoint._index, num_buffers);
 }
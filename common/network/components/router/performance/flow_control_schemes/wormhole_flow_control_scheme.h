@@ -29,13 +29,14 @@ class WormholeFlowControlScheme : public FlitBufferFlowControlScheme
   
    protected:
       vector<FlitBuffer*> _input_flit_buffer_vec;
-      vector<BufferStatusList*> _vec_downstream_buffer_status_list;
       vector<SInt32> _input_channels_allocated_vec;
       vector<NetworkMsg*>* _network_msg_list;
 
    private:
       void iterate();
       virtual pair<bool,bool> sendFlit(SInt32 input_channel);
-      void allocateDownstreamBuffer(Flit* flit, Channel::Endpoint& output_endpoint);
-      UInt64 tryAllocateDownstreamBuffer(Flit* flit, Channel::Endpoint& output_endpoint);
+      void allocateDownstreamBuffer(Flit* flit, Channel::Endpoint& output_endpoint, SInt32 num_buffers);
+      UInt64 tryAllocateDownstreamBuffer(Flit* flit, Channel::Endpoint& output_endpoint, SInt32 num_buffers);
+      Flit* splitFlitTrain(FlitBuffer* flit_buffer, SInt32 num_flits,
+                           BufferManagementMsg*& upstream_buffer_msg);
 };
@@ -235,7 +235,7 @@ WormholeUnicastVirtualCutThroughBroadcastFlowControlScheme::sendFlit(SInt32 inpu
       flit_buffer->_output_channels_allocated = false;
       
       // All flits of the packet have been sent on all output channels
-      delete flit_buffer->_output_endpoint_list;
+      // (_output_endpoint_list belongs to the routing table)
       flit_buffer->_output_endpoint_list = NULL;
       
       LOG_PRINT("sendFlit(%i) exit->(true,true)", input_channel);
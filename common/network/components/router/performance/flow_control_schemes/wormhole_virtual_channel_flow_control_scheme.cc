@@ -0,0 +1,323 @@
+#include "head_flit.h"
+#include "wormhole_virtual_channel_flow_control_scheme.h"
+#include "log.h"
+
+WormholeVirtualChannelFlowControlScheme::WormholeVirtualChannelFlowControlScheme(
+      SInt32 num_input_channels, SInt32 num_output_channels,
+      vector<SInt32>& num_input_endpoints_list, vector<SInt32>& num_output_endpoints_list,
+      vector<BufferManagementScheme::Type>& input_buffer_management_scheme_vec,
+      vector<BufferManagementScheme::Type>& downstream_buffer_management_scheme_vec,
+      vector<SInt32>& input_buffer_size_vec, vector<SInt32>& downstream_buffer_size_vec,
+      SInt32 num_vcs):
+   FlitBufferFlowControlScheme(num_input_channels, num_output_channels),
+   _num_vcs(num_vcs)
+{
+   LOG_ASSERT_ERROR(_num_vcs >= 1, "Num VCs(%i) must be >= 1", _num_vcs);
+
+   // Create the VCs of the input channels
+   _input_vc_vec.resize(_num_input_channels * _num_vcs);
+   for (SInt32 i = 0; i < _num_input_channels; i++)
+   {
+      for (SInt32 j = 0; j < _num_vcs; j++)
+      {
+         _input_vc_vec[i * _num_vcs + j] = new VirtualChannel(input_buffer_management_scheme_vec[i],
+               input_buffer_size_vec[i]);
+      }
+   }
+   _next_input_vc_vec.resize(_num_input_channels, 0);
+   _input_channel_free_time_vec.resize(_num_input_channels, 0);
+
+   // Create downstream buffer usage histories (one per downstream VC)
+   for (SInt32 i = 0; i < _num_output_channels; i++)
+   {
+      _vec_downstream_buffer_status_list[i] = new BufferStatusList(num_output_endpoints_list[i],
+            downstream_buffer_management_scheme_vec[i], downstream_buffer_size_vec[i], _num_vcs);
+   }
+
+   // No output VC is allocated to an input VC initially
+   _output_vc_allocated_vec.resize(_num_output_channels, vector<SInt32>(_num_vcs, Channel::INVALID));
+   _next_output_vc_vec.resize(_num_output_channels, 0);
+}
+
+WormholeVirtualChannelFlowControlScheme::~WormholeVirtualChannelFlowControlScheme()
+{
+   for (SInt32 i = 0; i < _num_input_channels * _num_vcs; i++)
+   {
+      delete _input_vc_vec[i];
+   }
+}
+
+void
+WormholeVirtualChannelFlowControlScheme::processDataMsg(Flit* flit, vector<NetworkMsg*>& network_msg_list)
+{
+   LOG_PRINT("processDataMsg(%p, %p) enter", this, flit);
+
+   _network_msg_list = &network_msg_list;
+
+   Channel::Endpoint& input_endpoint = flit->_input_endpoint;
+   LOG_PRINT("Input Endpoint(%i, %i), VC(%i)", input_endpoint._channel_id, input_endpoint._index, flit->_vc_id);
+   LOG_ASSERT_ERROR((flit->_vc_id >= 0) && (flit->_vc_id < _num_vcs),
+         "Flit VC(%i), Num VCs(%i)", flit->_vc_id, _num_vcs);
+
+   VirtualChannel* virtual_channel = getVirtualChannel(input_endpoint._channel_id, flit->_vc_id);
+   BufferManagementMsg* upstream_buffer_msg = virtual_channel->enqueue(flit);
+
+   if (upstream_buffer_msg)
+   {
+      upstream_buffer_msg->_input_endpoint = flit->_input_endpoint;
+      upstream_buffer_msg->_vc_id = flit->_vc_id;
+      _network_msg_list->push_back(upstream_buffer_msg);
+   }
+
+   iterate();
+
+   LOG_PRINT("processDataMsg(%p, %p) exit", this, flit);
+}
+
+void
+WormholeVirtualChannelFlowControlScheme::processBufferManagementMsg(BufferManagementMsg* buffer_management_msg,
+                                                                    vector<NetworkMsg*>& network_msg_list)
+{
+   LOG_PRINT("processBufferManagementMsg(%p, %p) enter", this, buffer_management_msg);
+
+   _network_msg_list = &network_msg_list;
+
+   Channel::Endpoint& output_endpoint = buffer_management_msg->_output_endpoint;
+   BufferStatusList* buffer_status_list = _vec_downstream_buffer_status_list[output_endpoint._channel_id];
+   buffer_status_list->receiveBufferManagementMsg(buffer_management_msg, output_endpoint._index);
+
+   iterate();
+
+   LOG_PRINT("processBufferManagementMsg(%p, %p) exit", this, buffer_management_msg);
+}
+
+void
+WormholeVirtualChannelFlowControlScheme::iterate()
+{
+   LOG_PRINT("iterate(%p) enter", this);
+
+   // Sending a flit can free an output VC that a head flit at another input channel
+   // is waiting for, so go over the input channels until no flit can be sent
+   bool processing_finished;
+   do
+   {
+      processing_finished = true;
+      for (SInt32 input_channel = 0; input_channel < _num_input_channels; input_channel++)
+      {
+         while (allocateSwitch(input_channel))
+            processing_finished = false;
+      }
+   } while (! processing_finished);
+
+   LOG_PRINT("iterate(%p) exit", this);
+}
+
+// Switch allocation for one input channel
+// Returns true if a flit was sent from one of its VCs
+bool
+WormholeVirtualChannelFlowControlScheme::allocateSwitch(SInt32 input_channel)
+{
+   SInt32 granted_vc_id = Channel::INVALID;
+   UInt64 granted_time = UINT64_MAX_;
+
+   for (SInt32 i = 0; i < _num_vcs; i++)
+   {
+      SInt32 vc_id = (_next_input_vc_vec[input_channel] + i) % _num_vcs;
+      UInt64 send_time = computeFlitSendTime(input_channel, vc_id);
+      if (send_time < granted_time)
+      {
+         granted_vc_id = vc_id;
+         granted_time = send_time;
+      }
+   }
+
+   if (granted_vc_id == Channel::INVALID)
+      return false;
+
+   LOG_PRINT("Switch allocated to Input Channel(%i), VC(%i) at Time(%llu)",
+         input_channel, granted_vc_id, granted_time);
+   sendFlit(input_channel, granted_vc_id, granted_time);
+   _next_input_vc_vec[input_channel] = (granted_vc_id + 1) % _num_vcs;
+   return true;
+}
+
+// VC allocation for the head flit at the front of an input VC
+// Allocates a free VC on every output channel of the packet, or none at all
+bool
+WormholeVirtualChannelFlowControlScheme::allocateOutputVCs(SInt32 input_channel, SInt32 vc_id)
+{
+   VirtualChannel* virtual_channel = getVirtualChannel(input_channel, vc_id);
+   vector<Channel::Endpoint>* output_endpoint_list = virtual_channel->_output_endpoint_list;
+   vector<SInt32>& output_vc_list = virtual_channel->_output_vc_list;
+   assert(output_vc_list.empty());
+
+   vector<Channel::Endpoint>::iterator endpoint_it = output_endpoint_list->begin();
+   for ( ; endpoint_it != output_endpoint_list->end(); endpoint_it ++)
+   {
+      SInt32 output_channel = (*endpoint_it)._channel_id;
+      vector<SInt32>& output_vc_allocated_vec = _output_vc_allocated_vec[output_channel];
+
+      SInt32 output_vc_id = Channel::INVALID;
+      for (SInt32 i = 0; i < _num_vcs; i++)
+      {
+         SInt32 candidate_vc_id = (_next_output_vc_vec[output_channel] + i) % _num_vcs;
+         if (output_vc_allocated_vec[candidate_vc_id] == Channel::INVALID)
+         {
+            output_vc_id = candidate_vc_id;
+            break;
+         }
+      }
+
+      if (output_vc_id == Channel::INVALID)
+      {
+         // All the VCs of the output channel are held by other packets
+         LOG_PRINT("No free VC on Output Channel(%i)", output_channel);
+         output_vc_list.clear();
+         return false;
+      }
+      output_vc_list.push_back(output_vc_id);
+   }
+
+   // Free VCs on all output channels. Allocate them at once
+   SInt32 input_vc = input_channel * _num_vcs + vc_id;
+   for (UInt32 i = 0; i < output_endpoint_list->size(); i++)
+   {
+      SInt32 output_channel = (*output_endpoint_list)[i]._channel_id;
+      SInt32 output_vc_id = output_vc_list[i];
+      LOG_PRINT("Allocating Output Channel(%i), VC(%i) to Input Channel(%i), VC(%i)",
+            output_channel, output_vc_id, input_channel, vc_id);
+
+      _output_vc_allocated_vec[output_channel][output_vc_id] = input_vc;
+      _next_output_vc_vec[output_channel] = (output_vc_id + 1) % _num_vcs;
+   }
+
+   virtual_channel->_output_channels_allocated = true;
+   return true;
+}
+
+// Earliest time at which the flit at the front of an input VC can be sent
+// Returns UINT64_MAX_ if it cannot be sent yet (no output VC or no downstream buffer)
+UInt64
+WormholeVirtualChannelFlowControlScheme::computeFlitSendTime(SInt32 input_channel, SInt32 vc_id)
+{
+   VirtualChannel* virtual_channel = getVirtualChannel(input_channel, vc_id);
+   if (virtual_channel->empty())
+      return UINT64_MAX_;
+
+   Flit* flit = virtual_channel->front();
+
+   if (virtual_channel->_output_endpoint_list == NULL)
+   {
+      LOG_ASSERT_ERROR(flit->_type & Flit::HEAD, "flit->_type(%u)", flit->_type);
+      HeadFlit* head_flit = (HeadFlit*) flit;
+      virtual_channel->_output_endpoint_list = head_flit->_output_endpoint_list;
+   }
+
+   // Synchronize the flit time to the VC buffer time
+   virtual_channel->updateFlitTime();
+
+   if (!virtual_channel->_output_channels_allocated)
+   {
+      LOG_ASSERT_ERROR(flit->_type & Flit::HEAD, "flit->_type(%u)", flit->_type);
+      if (!allocateOutputVCs(input_channel, vc_id))
+         return UINT64_MAX_;
+   }
+
+   UInt64 send_time = max<UInt64>(flit->_normalized_time, _input_channel_free_time_vec[input_channel]);
+
+   // A buffer must be free in the allocated VC of every downstream router
+   vector<Channel::Endpoint>* output_endpoint_list = virtual_channel->_output_endpoint_list;
+   for (UInt32 i = 0; i < output_endpoint_list->size(); i++)
+   {
+      Channel::Endpoint& output_endpoint = (*output_endpoint_list)[i];
+      BufferStatusList* buffer_status_list = _vec_downstream_buffer_status_list[output_endpoint._channel_id];
+      UInt64 allocated_time = buffer_status_list->tryAllocateBuffer(flit, output_endpoint._index,
+            flit->_num_phits, virtual_channel->_output_vc_list[i]);
+      if (allocated_time == UINT64_MAX_)
+      {
+         LOG_PRINT("Could not allocate a buffer for Output Endpoint(%i,%i), VC(%i)",
+               output_endpoint._channel_id, output_endpoint._index, virtual_channel->_output_vc_list[i]);
+         return UINT64_MAX_;
+      }
+      send_time = max<UInt64>(send_time, allocated_time);
+   }
+
+   return send_time;
+}
+
+void
+WormholeVirtualChannelFlowControlScheme::sendFlit(SInt32 input_channel, SInt32 vc_id, UInt64 send_time)
+{
+   LOG_PRINT("sendFlit(%i, %i, %llu) enter", input_channel, vc_id, send_time);
+
+   VirtualChannel* virtual_channel = getVirtualChannel(input_channel, vc_id);
+   Flit* flit = virtual_channel->front();
+   flit->_normalized_time = send_time;
+
+   SInt32 input_vc = input_channel * _num_vcs + vc_id;
+
+   // Send Flit to all output endpoints
+   vector<Channel::Endpoint>* output_endpoint_list = virtual_channel->_output_endpoint_list;
+   for (UInt32 i = 0; i < output_endpoint_list->size(); i++)
+   {
+      Channel::Endpoint& output_endpoint = (*output_endpoint_list)[i];
+      SInt32 output_channel = output_endpoint._channel_id;
+      SInt32 output_vc_id = virtual_channel->_output_vc_list[i];
+
+      BufferStatusList* buffer_status_list = _vec_downstream_buffer_status_list[output_channel];
+      buffer_status_list->allocateBuffer(flit, output_endpoint._index, flit->_num_phits, output_vc_id);
+
+      // Duplicate flit and net_packet
+      NetPacket* cloned_net_packet = flit->_net_packet->clone();
+      Flit* cloned_flit = (Flit*) cloned_net_packet->data;
+      cloned_flit->_net_packet = cloned_net_packet;
+      cloned_flit->_output_endpoint = output_endpoint;
+      cloned_flit->_vc_id = output_vc_id;
+
+      // Send flit to downstream router
+      _network_msg_list->push_back(cloned_flit);
+
+      // If TAIL Flit, de-allocate output VC
+      if (flit->_type & Flit::TAIL)
+      {
+         LOG_PRINT("TAIL Flit: Releasing Output Channel(%i), VC(%i)", output_channel, output_vc_id);
+         LOG_ASSERT_ERROR(_output_vc_allocated_vec[output_channel][output_vc_id] == input_vc,
+               "Output Channel(%i), VC(%i) allocated to Input VC(%i), should be allocated to (%i)",
+               output_channel, output_vc_id, _output_vc_allocated_vec[output_channel][output_vc_id], input_vc);
+
+         _output_vc_allocated_vec[output_channel][output_vc_id] = Channel::INVALID;
+      }
+   }
+
+   // The crossbar input is busy while the flit goes through
+   _input_channel_free_time_vec[input_channel] = send_time + flit->_num_phits;
+
+   // Update Buffer Time for next flit and remove flit from queue
+   virtual_channel->updateBufferTime();
+   BufferManagementMsg* upstream_buffer_msg = virtual_channel->dequeue();
+   if (upstream_buffer_msg)
+   {
+      LOG_PRINT("Sending Upstream Buffer Msg (%p)", upstream_buffer_msg);
+
+      upstream_buffer_msg->_input_endpoint = flit->_input_endpoint;
+      upstream_buffer_msg->_vc_id = vc_id;
+      _network_msg_list->push_back(upstream_buffer_msg);
+   }
+
+   // Move the flit_type to a local variable
+   Flit::Type flit_type = flit->_type;
+
+   // Release the Net-packet and hence the flit
+   flit->_net_packet->release();
+
+   if (flit_type & Flit::TAIL)
+   {
+      // The input VC can take the next packet
+      // (_output_endpoint_list belongs to the routing table)
+      virtual_channel->_output_endpoint_list = NULL;
+      virtual_channel->_output_channels_allocated = false;
+      virtual_channel->_output_vc_list.clear();
+   }
+
+   LOG_PRINT("sendFlit(%i, %i) exit", input_channel, vc_id);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+using namespace std;
+
+#include "fixed_types.h"
+#include "flit.h"
+#include "buffer_management_msg.h"
+#include "buffer_status_list.h"
+#include "flit_buffer_flow_control_scheme.h"
+
+// Wormhole flow control with 'num_vcs' virtual channels (VCs) per input port
+// Every VC has its own flit buffer (and its own credits at the upstream router), so a
+// blocked packet only holds on to its VC, and the packets in the other VCs of the
+// port can still use the crossbar and the links. Flits go through a separable allocator:
+//  - VC allocation: the head flit of an input VC acquires a free VC on each of its
+//    output channels, all at once. The output VCs are released by the tail flit
+//  - Switch allocation: an input port sends one flit per cycle, picking the input VC
+//    whose flit can leave the earliest (round-robin among the VCs on a tie).
+//    The VCs of an output channel share the link, one flit per cycle
+class WormholeVirtualChannelFlowControlScheme : public FlitBufferFlowControlScheme
+{
+   public:
+      WormholeVirtualChannelFlowControlScheme(SInt32 num_input_channels, SInt32 num_output_channels,
+            vector<SInt32>& num_input_endpoints_list, vector<SInt32>& num_output_endpoints_list,
+            vector<BufferManagementScheme::Type>& input_buffer_management_scheme_vec,
+            vector<BufferManagementScheme::Type>& downstream_buffer_management_scheme_vec,
+            vector<SInt32>& input_buffer_size_vec,
+            vector<SInt32>& downstream_buffer_size_vec,
+            SInt32 num_vcs);
+      ~WormholeVirtualChannelFlowControlScheme();
+
+      // Public Functions
+      void processDataMsg(Flit* flit, vector<NetworkMsg*>& network_msg_list);
+      void processBufferManagementMsg(BufferManagementMsg* buffer_msg, vector<NetworkMsg*>& network_msg_list);
+
+      // Buffer of VC 0
+      BufferModel* getBufferModel(SInt32 input_channel_id)
+      { return getVirtualChannel(input_channel_id, 0)->getBufferModel(); }
+
+   private:
+      class VirtualChannel : public FlitBuffer
+      {
+         public:
+            VirtualChannel(BufferManagementScheme::Type buffer_management_scheme, SInt32 size_buffer)
+               : FlitBuffer(buffer_management_scheme, size_buffer)
+            {}
+            ~VirtualChannel() {}
+
+            // VC allocated on the output channel of each endpoint in _output_endpoint_list
+            vector<SInt32> _output_vc_list;
+      };
+
+      SInt32 _num_vcs;
+      // (_num_vcs) VCs per input channel
+      vector<VirtualChannel*> _input_vc_vec;
+      // Input VC (input_channel * _num_vcs + vc_id) each output VC is allocated to
+      vector<vector<SInt32> > _output_vc_allocated_vec;
+      // Round-robin pointers of the switch allocator (per input channel)
+      // and of the VC allocator (per output channel)
+      vector<SInt32> _next_input_vc_vec;
+      vector<SInt32> _next_output_vc_vec;
+      // Time at which the next flit from an input channel can go through the crossbar
+      vector<UInt64> _input_channel_free_time_vec;
+      vector<NetworkMsg*>* _network_msg_list;
+
+      VirtualChannel* getVirtualChannel(SInt32 input_channel, SInt32 vc_id)
+      { return _input_vc_vec[input_channel * _num_vcs + vc_id]; }
+
+      void iterate();
+      bool allocateSwitch(SInt32 input_channel);
+      bool allocateOutputVCs(SInt32 input_channel, SInt32 vc_id);
+      UInt64 computeFlitSendTime(SInt32 input_channel, SInt32 vc_id);
+      void sendFlit(SInt32 input_channel, SInt32 vc_id, UInt64 send_time);
+};
@@ -1,12 +1,15 @@
 #include "network_msg.h"
 
+SlabAllocator NetworkMsg::_allocator(NetworkMsg::MAX_POOLED_NETWORK_MSG_SIZE);
+
 NetworkMsg::NetworkMsg(Type type, UInt64 normalized_time):
    _normalized_time(normalized_time),
    _sender_router_index(0),
    _receiver_router_index(0),
    _type(type),
    _input_endpoint(Channel::Endpoint()),
-   _output_endpoint(Channel::Endpoint())
+   _output_endpoint(Channel::Endpoint()),
+   _vc_id(0)
 {}
 
 NetworkMsg::NetworkMsg(const NetworkMsg& rhs):
@@ -15,12 +18,30 @@ NetworkMsg::NetworkMsg(const NetworkMsg& rhs):
    _receiver_router_index(rhs._receiver_router_index),
    _type(rhs._type),
    _input_endpoint(rhs._input_endpoint),
-   _output_endpoint(rhs._output_endpoint)
+   _output_endpoint(rhs._output_endpoint),
+   _vc_id(rhs._vc_id)
 {}
 
 NetworkMsg::~NetworkMsg()
 {}
 
+void*
+NetworkMsg::operator new(size_t size)
+{
+   if (size > _allocator.getBlockSize())
+      return ::operator new(size);
+   return _allocator.allocate();
+}
+
+void
+NetworkMsg::operator delete(void* ptr, size_t size)
+{
+   if (size > _allocator.getBlockSize())
+      ::operator delete(ptr);
+   else
+      _allocator.deallocate(ptr);
+}
+
 std::string
 NetworkMsg::getTypeString()
 {
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "fixed_types.h"
+#include "slab_allocator.h"
 #include "channel.h"
 
 class NetworkMsg
@@ -17,7 +18,11 @@ class NetworkMsg
 
       NetworkMsg(Type type, UInt64 normalized_time = 0);
       NetworkMsg(const NetworkMsg& rhs);
-      ~NetworkMsg();
+      virtual ~NetworkMsg();
+
+      // Flits and buffer management msgs are allocated from a per-thread slab, not the general heap
+      static void* operator new(size_t size);
+      static void operator delete(void* ptr, size_t size);
       
       UInt64 _normalized_time;
       SInt32 _sender_router_index;
@@ -25,8 +30,17 @@ class NetworkMsg
       Type _type;
       Channel::Endpoint _input_endpoint;
       Channel::Endpoint _output_endpoint;
+      // Virtual channel of the flit at the receiving router's input port
+      // (for buffer management msgs, the virtual channel whose buffers were freed)
+      SInt32 _vc_id;
 
       virtual NetworkMsg* clone() { return new NetworkMsg(*this); }
       virtual UInt32 size() { return sizeof(*this); }
       std::string getTypeString();
+
+   private:
+      // Largest NetworkMsg (incl. HeadFlit) served from the slab
+      static const size_t MAX_POOLED_NETWORK_MSG_SIZE = 128;
+
+      static SlabAllocator _allocator;
 };
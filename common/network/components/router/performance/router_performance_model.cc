@@ -10,7 +10,8 @@ RouterPerformanceModel::RouterPerformanceModel(
       vector<BufferManagementScheme::Type> input_buffer_management_schemes,
       vector<BufferManagementScheme::Type> downstream_buffer_management_schemes,
       vector<SInt32> input_buffer_size_list,
-      vector<SInt32> downstream_buffer_size_list)
+      vector<SInt32> downstream_buffer_size_list,
+      SInt32 num_vcs)
    : _data_pipeline_delay(data_pipeline_delay)
    , _credit_pipeline_delay(credit_pipeline_delay)
 {
@@ -18,7 +19,8 @@ RouterPerformanceModel::RouterPerformanceModel(
          num_input_channels, num_output_channels,
          num_input_endpoints_list, num_output_endpoints_list,
          input_buffer_management_schemes, downstream_buffer_management_schemes,
-         input_buffer_size_list, downstream_buffer_size_list);
+         input_buffer_size_list, downstream_buffer_size_list,
+         num_vcs);
 }
 
 RouterPerformanceModel::~RouterPerformanceModel()
@@ -19,7 +19,8 @@ class RouterPerformanceModel
             vector<BufferManagementScheme::Type> input_buffer_management_schemes,
             vector<BufferManagementScheme::Type> downstream_buffer_management_schemes,
             vector<SInt32> input_buffer_size_list,
-            vector<SInt32> downstream_buffer_size_list);
+            vector<SInt32> downstream_buffer_size_list,
+            SInt32 num_vcs = 1);
       ~RouterPerformanceModel();
 
       void processDataMsg(Flit* flit, vector<NetworkMsg*>& network_msg_list_to_send);
@@ -0,0 +1,38 @@
+#include "routing_table.h"
+#include "log.h"
+
+RoutingTable::RoutingTable(SInt32 num_routes)
+   : _route_vec(num_routes, (vector<Channel::Endpoint>*) NULL)
+{}
+
+RoutingTable::~RoutingTable()
+{
+   for (UInt32 i = 0; i < _output_endpoint_list_vec.size(); i++)
+      delete _output_endpoint_list_vec[i];
+}
+
+vector<Channel::Endpoint>*
+RoutingTable::setRoute(SInt32 route_num, const vector<Channel::Endpoint>& output_endpoint_vec)
+{
+   LOG_ASSERT_ERROR(route_num >= 0 && route_num < (SInt32) _route_vec.size(),
+                    "Route Num(%i) out of range [0,%u)", route_num, _route_vec.size());
+
+   // A router only has a handful of distinct output endpoint lists
+   vector<Channel::Endpoint>* output_endpoint_list = NULL;
+   for (UInt32 i = 0; i < _output_endpoint_list_vec.size(); i++)
+   {
+      if (*_output_endpoint_list_vec[i] == output_endpoint_vec)
+      {
+         output_endpoint_list = _output_endpoint_list_vec[i];
+         break;
+      }
+   }
+   if (!output_endpoint_list)
+   {
+      output_endpoint_list = new vector<Channel::Endpoint>(output_endpoint_vec);
+      _output_endpoint_list_vec.push_back(output_endpoint_list);
+   }
+
+   _route_vec[route_num] = output_endpoint_list;
+   return output_endpoint_list;
+}
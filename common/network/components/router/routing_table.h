@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "fixed_types.h"
+#include "channel.h"
+#include "log.h"
+
+// Output endpoint lists of one router, indexed by a route number that the
+// network model computes from the head flit (e.g., its receiver, or its
+// sender for a broadcast). Each distinct list is allocated once and shared by
+// all the routes (and head flits) that use it, so it must not be modified or
+// deleted by the flow control schemes.
+class RoutingTable
+{
+   public:
+      RoutingTable(SInt32 num_routes);
+      ~RoutingTable();
+
+      // Returns NULL if the route has not been set
+      vector<Channel::Endpoint>* getRoute(SInt32 route_num)
+      {
+         LOG_ASSERT_ERROR(route_num >= 0 && route_num < (SInt32) _route_vec.size(),
+                          "Route Num(%i) out of range [0,%u)", route_num, _route_vec.size());
+         return _route_vec[route_num];
+      }
+      vector<Channel::Endpoint>* setRoute(SInt32 route_num, const vector<Channel::Endpoint>& output_endpoint_vec);
+
+   private:
+      // One entry per route, pointing into _output_endpoint_list_vec
+      vector<vector<Channel::Endpoint>*> _route_vec;
+      // Distinct output endpoint lists
+      vector<vector<Channel::Endpoint>*> _output_endpoint_list_vec;
+};
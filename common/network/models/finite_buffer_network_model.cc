@@ -12,6 +12,7 @@
 FiniteBufferNetworkModel::FiniteBufferNetworkModel(Network* net, SInt32 network_id)
    : NetworkModel(net, network_id, true)
    , _sender_sequence_num(0)
+   , _net_packet_injector_output_endpoint_list(1, Channel::Endpoint(0,0))
    , _netPacketInjectorExitCallback(NULL)
 {
    _flow_control_packet_type = getNetwork()->getPacketTypeFromNetworkId(network_id);
@@ -28,10 +29,25 @@ FiniteBufferNetworkModel::FiniteBufferNetworkModel(Network* net, SInt32 network_
 FiniteBufferNetworkModel::~FiniteBufferNetworkModel()
 {
    delete _sender_contention_model;
+
+   // Delete the routing tables
+   map<SInt32, RoutingTable*>::iterator it = _routing_table_map.begin();
+   for ( ; it != _routing_table_map.end(); it ++)
+      delete (*it).second;
+}
+
+void
+FiniteBufferNetworkModel::reset()
+{
+   resetPerformanceCounters();
+
+   map<SInt32, NetworkNode*>::iterator it = _network_node_map.begin();
+   for ( ; it != _network_node_map.end(); it ++)
+      (*it).second->resetCounters();
 }
 
 void
-FiniteBufferNetworkModel::sendNetPacket(NetPacket* raw_packet, list<NetPacket*>& modeling_packet_list_to_send)
+FiniteBufferNetworkModel::sendNetPacket(NetPacket* raw_packet, vector<NetPacket*>& modeling_packet_list_to_send)
 {
    LOG_PRINT("sendNetPacket(%i, %p, %u) enter", getNetwork()->getCore()->getId(), raw_packet, _flow_control_scheme);
 
@@ -60,7 +76,7 @@ FiniteBufferNetworkModel::sendNetPacket(NetPacket* raw_packet, list<NetPacket*>&
          serialization_latency);
 
    // Send out all the flits
-   list<NetPacket*>::iterator packet_it = modeling_packet_list_to_send.begin();
+   vector<NetPacket*>::iterator packet_it = modeling_packet_list_to_send.begin();
    for ( ; packet_it != modeling_packet_list_to_send.end(); packet_it ++)
    {
       NetPacket* modeling_packet_to_send = *packet_it;
@@ -77,7 +93,7 @@ FiniteBufferNetworkModel::sendNetPacket(NetPacket* raw_packet, list<NetPacket*>&
 
 void
 FiniteBufferNetworkModel::receiveNetPacket(NetPacket* net_packet,
-      list<NetPacket*>& modeling_packet_list_to_send, list<NetPacket*>& raw_packet_list_to_receive)
+      vector<NetPacket*>& modeling_packet_list_to_send, vector<NetPacket*>& raw_packet_list_to_receive)
 {
    LOG_PRINT("receiveNetPacket(%p): Time(%llu), Sender(%i), Receiver(%i), Length(%i), Sequence Num(%llu), Raw(%s) enter",
          net_packet, net_packet->time, net_packet->sender, net_packet->receiver,
@@ -120,7 +136,7 @@ FiniteBufferNetworkModel::receiveNetPacket(NetPacket* net_packet,
 
                if (node_type == NET_PACKET_INJECTOR)
                {
-                  head_flit->_output_endpoint_list = new vector<Channel::Endpoint>(1,Channel::Endpoint(0,0));
+                  head_flit->_output_endpoint_list = &_net_packet_injector_output_endpoint_list;
                }
                else // (node_type != NET_PACKET_INJECTOR)
                {
@@ -170,7 +186,8 @@ FiniteBufferNetworkModel::unregisterNetPacketInjectorExitCallback()
 NetworkNode*
 FiniteBufferNetworkModel::createNetPacketInjectorNode(Router::Id ingress_router_id,
                                                       BufferManagementScheme::Type ingress_router_buffer_management_scheme,
-                                                      SInt32 ingress_router_buffer_size)
+                                                      SInt32 ingress_router_buffer_size,
+                                                      SInt32 ingress_router_num_vcs)
 {
    RouterPerformanceModel* router_performance_model =
       new RouterPerformanceModel(
@@ -181,7 +198,8 @@ FiniteBufferNetworkModel::createNetPacketInjectorNode(Router::Id ingress_router_
             vector<BufferManagementScheme::Type>(1, BufferManagementScheme::INFINITE),
             vector<BufferManagementScheme::Type>(1, ingress_router_buffer_management_scheme),
             vector<SInt32>(1, -1),
-            vector<SInt32>(1, ingress_router_buffer_size)
+            vector<SInt32>(1, ingress_router_buffer_size),
+            ingress_router_num_vcs
             );
 
    // No Router Power Model
@@ -209,7 +227,7 @@ FiniteBufferNetworkModel::createNetPacketInjectorNode(Router::Id ingress_router_
 }
 
 void
-FiniteBufferNetworkModel::receiveRawPacket(NetPacket* raw_packet, list<NetPacket*>& raw_packet_list_to_receive)
+FiniteBufferNetworkModel::receiveRawPacket(NetPacket* raw_packet, vector<NetPacket*>& raw_packet_list_to_receive)
 {
    LOG_PRINT("receiveRawPacket(%p) enter", raw_packet);
    assert(isModeled(raw_packet));
@@ -245,7 +263,7 @@ FiniteBufferNetworkModel::receiveRawPacket(NetPacket* raw_packet, list<NetPacket
 }
 
 void
-FiniteBufferNetworkModel::receiveModelingPacket(NetPacket* modeling_packet, list<NetPacket*>& raw_packet_list_to_receive)
+FiniteBufferNetworkModel::receiveModelingPacket(NetPacket* modeling_packet, vector<NetPacket*>& raw_packet_list_to_receive)
 {
    LOG_PRINT("receiveModelingPacket(%p) enter", modeling_packet);
  
@@ -360,7 +378,7 @@ FiniteBufferNetworkModel::insertInCompletePacketList(NetPacket* raw_packet, SInt
 }
 
 void
-FiniteBufferNetworkModel::getReadyPackets(SInt32 sender, list<NetPacket*>& raw_packet_list_to_receive)
+FiniteBufferNetworkModel::getReadyPackets(SInt32 sender, vector<NetPacket*>& raw_packet_list_to_receive)
 {
    LOG_PRINT("getReadyPackets(%i) enter", sender);
    // The assumption is that all packets are ready at the same time, so if the components
@@ -421,9 +439,9 @@ FiniteBufferNetworkModel::computePacketId(core_id_t sender, UInt64 sender_sequen
 }
 
 UInt64
-FiniteBufferNetworkModel::getNetPacketInjectorExitTime(const list<NetPacket*>& modeling_packet_list)
+FiniteBufferNetworkModel::getNetPacketInjectorExitTime(const vector<NetPacket*>& modeling_packet_list)
 {
-   for (list<NetPacket*>::const_iterator it = modeling_packet_list.begin(); it != modeling_packet_list.end(); it ++)
+   for (vector<NetPacket*>::const_iterator it = modeling_packet_list.begin(); it != modeling_packet_list.end(); it ++)
    {
       NetPacket* net_packet = *it;
       NetworkMsg* network_msg = (NetworkMsg*) net_packet->data;
@@ -432,8 +450,11 @@ FiniteBufferNetworkModel::getNetPacketInjectorExitTime(const list<NetPacket*>& m
 
       if (FlowControlScheme::isPacketComplete(_flow_control_scheme, flit->_type))
       {
-         list<NetPacket*>::const_iterator end_it = modeling_packet_list.end();
+         vector<NetPacket*>::const_iterator end_it = modeling_packet_list.end();
          assert(end_it == ++it);
+         // The tail of a flit train leaves (_num_phits - 1) cycles after its head
+         if (_flow_control_scheme == FlowControlScheme::WORMHOLE_FLIT_TRAIN)
+            return net_packet->time + flit->_num_phits - 1;
          return net_packet->time;
       }
    }
@@ -457,9 +478,9 @@ FiniteBufferNetworkModel::outputContentionDelaySummary(ostream& out)
 }
 
 void
-FiniteBufferNetworkModel::printNetPacketList(const list<NetPacket*>& net_packet_list) const
+FiniteBufferNetworkModel::printNetPacketList(const vector<NetPacket*>& net_packet_list) const
 {
-   list<NetPacket*>::const_iterator packet_it = net_packet_list.begin();
+   vector<NetPacket*>::const_iterator packet_it = net_packet_list.begin();
    for ( ; packet_it != net_packet_list.end(); packet_it ++)
    {
       NetPacket* net_packet = *packet_it;
@@ -10,6 +10,7 @@ using namespace std;
 #include "network_node.h"
 #include "lock.h"
 #include "head_flit.h"
+#include "routing_table.h"
 #include "queue_model_simple.h"
 
 class FiniteBufferNetworkModel : public NetworkModel
@@ -22,13 +23,14 @@ public:
    static const SInt32 NET_PACKET_INJECTOR = 0;
    
    // Virtual Functions which are pure in network_model.h
-   void reset() { }
+   // Resets the performance counters of the model and its network nodes
+   void reset();
    
    // Send Network Packet
-   void sendNetPacket(NetPacket* raw_packet, list<NetPacket*>& modeling_packet_list_to_send);
+   void sendNetPacket(NetPacket* raw_packet, vector<NetPacket*>& modeling_packet_list_to_send);
    // Receive Network Packet
-   void receiveNetPacket(NetPacket* net_packet, list<NetPacket*>& modeling_packet_list_to_send,
-         list<NetPacket*>& raw_packet_list_to_receive);
+   void receiveNetPacket(NetPacket* net_packet, vector<NetPacket*>& modeling_packet_list_to_send,
+         vector<NetPacket*>& raw_packet_list_to_receive);
 
    // Register/Unregister NetPacketInjectorExitCallback
    typedef void (*NetPacketInjectorExitCallback)(void*, UInt64);
@@ -51,10 +53,21 @@ protected:
    // CORE_INTERFACE port
    static const SInt32 CORE_INTERFACE = -1;
 
+   // Routing Tables of the network nodes on this core (indexed like _network_node_map)
+   map<SInt32, RoutingTable*> _routing_table_map;
+   // Route number of a unicast (by receiver) or a broadcast (by sender)
+   static SInt32 getNumRoutes() { return 2 * Config::getSingleton()->getTotalCores(); }
+   static SInt32 computeRouteNum(core_id_t sender, core_id_t receiver)
+   {
+      return (receiver == NetPacket::BROADCAST) ?
+             (Config::getSingleton()->getTotalCores() + sender) : receiver;
+   }
+
    // Create NetPacket Injector Node
    NetworkNode* createNetPacketInjectorNode(Router::Id ingress_router_id,
          BufferManagementScheme::Type ingress_router_buffer_management_scheme,
-         SInt32 ingress_router_buffer_size);
+         SInt32 ingress_router_buffer_size,
+         SInt32 ingress_router_num_vcs = 1);
 
    void outputContentionDelaySummary(ostream& out);
 
@@ -91,6 +104,9 @@ private:
    
    // Sender Contention Model
    QueueModelSimple* _sender_contention_model;
+
+   // Output Endpoint List of all the head flits at the net packet injector
+   vector<Channel::Endpoint> _net_packet_injector_output_endpoint_list;
    
    // Callback when packet leaves net packet injector
    NetPacketInjectorExitCallback _netPacketInjectorExitCallback;
@@ -100,22 +116,22 @@ private:
    virtual void computeOutputEndpointList(HeadFlit* head_flit, NetworkNode* curr_network_node) = 0;
 
    // Receive raw packet containing actual application data (non-modeling packet)
-   void receiveRawPacket(NetPacket* raw_packet, list<NetPacket*>& raw_packet_list_to_receive);
+   void receiveRawPacket(NetPacket* raw_packet, vector<NetPacket*>& raw_packet_list_to_receive);
    // Receive modeling packet containing timing information (non-raw packet)
-   void receiveModelingPacket(NetPacket* modeling_packet, list<NetPacket*>& raw_packet_list_to_receive);
+   void receiveModelingPacket(NetPacket* modeling_packet, vector<NetPacket*>& raw_packet_list_to_receive);
 
    // Insert a raw_packet in completed packets list
    void insertInCompletePacketList(NetPacket* raw_packet, SInt32 zero_load_delay);
    // Get the ready packets
-   void getReadyPackets(SInt32 sender, list<NetPacket*>& raw_packet_list_to_receive);
+   void getReadyPackets(SInt32 sender, vector<NetPacket*>& raw_packet_list_to_receive);
 
    // Utils
    UInt64 computePacketId(core_id_t sender, UInt64 sequence_num);
 
    // Signal Injector that packet has left the network interface
-   UInt64 getNetPacketInjectorExitTime(const list<NetPacket*>& modeling_packet_list);
+   UInt64 getNetPacketInjectorExitTime(const vector<NetPacket*>& modeling_packet_list);
    void signalNetPacketInjector(UInt64 time);
 
    // misc
-   void printNetPacketList(const list<NetPacket*>& net_packet_list) const;
+   void printNetPacketList(const vector<NetPacket*>& net_packet_list) const;
 };
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <climits>
 #include <algorithm>
 using namespace std;
 
@@ -89,6 +90,14 @@ FiniteBufferNetworkModelAtac::FiniteBufferNetworkModelAtac(Network* network, SIn
       }
    }
 
+   // Routing Tables (the routes are computed on first use)
+   map<SInt32, NetworkNode*>::iterator node_it = _network_node_map.begin();
+   for ( ; node_it != _network_node_map.end(); node_it ++)
+   {
+      if ((*node_it).first != NET_PACKET_INJECTOR)
+         _routing_table_map[(*node_it).first] = new RoutingTable(getNumANetRoutes());
+   }
+
    // Initialize Performance Counters
    initializePerformanceCounters();
 }
@@ -101,6 +110,14 @@ FiniteBufferNetworkModelAtac::~FiniteBufferNetworkModelAtac()
       delete (*it).second;
 }
 
+void
+FiniteBufferNetworkModelAtac::reset()
+{
+   FiniteBufferNetworkModel::reset();
+   // ENet/ONet Counters
+   initializePerformanceCounters();
+}
+
 FiniteBufferNetworkModelAtac::GlobalRoutingStrategy
 FiniteBufferNetworkModelAtac::parseGlobalRoutingStrategy(string str)
 {
@@ -160,6 +177,26 @@ FiniteBufferNetworkModelAtac::computeReceiveNetID(core_id_t sender)
    return (sending_cluster_id % _num_receive_nets_per_cluster);
 }
 
+SInt32
+FiniteBufferNetworkModelAtac::getNumANetRoutes()
+{
+   // ENet: one route per receiver
+   // ONet: one route per (receive net, receiver or broadcast)
+   SInt32 total_cores = Config::getSingleton()->getTotalCores();
+   return total_cores + _num_receive_nets_per_cluster * (total_cores + 1);
+}
+
+SInt32
+FiniteBufferNetworkModelAtac::computeANetRouteNum(core_id_t sender, core_id_t receiver)
+{
+   SInt32 total_cores = Config::getSingleton()->getTotalCores();
+   if (computeGlobalRoute(sender, receiver) == GLOBAL_ENET)
+      return receiver;
+   
+   SInt32 receiver_idx = (receiver == NetPacket::BROADCAST) ? total_cores : receiver;
+   return total_cores + computeReceiveNetID(sender) * (total_cores + 1) + receiver_idx;
+}
+
 
 void
 FiniteBufferNetworkModelAtac::initializeANetTopologyParameters()
@@ -623,6 +660,15 @@ FiniteBufferNetworkModelAtac::computeOutputEndpointList(HeadFlit* head_flit, Net
    
    assert(_core_id == curr_router_id._core_id);
 
+   RoutingTable* routing_table = _routing_table_map[curr_router_id._index];
+   SInt32 route_num = computeANetRouteNum(head_flit->_sender, head_flit->_receiver);
+   head_flit->_output_endpoint_list = routing_table->getRoute(route_num);
+   if (head_flit->_output_endpoint_list)
+   {
+      LOG_PRINT("computeOutputEndpointList(%p, %p) end", head_flit, curr_network_node);
+      return;
+   }
+
    // Output Endpoint List
    vector<Channel::Endpoint> output_endpoint_vec;
 
@@ -643,7 +689,7 @@ FiniteBufferNetworkModelAtac::computeOutputEndpointList(HeadFlit* head_flit, Net
             output_endpoint_vec);
    }
 
-   head_flit->_output_endpoint_list = new vector<Channel::Endpoint>(output_endpoint_vec);
+   head_flit->_output_endpoint_list = routing_table->setRoute(route_num, output_endpoint_vec);
    
    LOG_PRINT("computeOutputEndpointList(%p, %p) end", head_flit, curr_network_node);
 }
@@ -1302,6 +1348,33 @@ FiniteBufferNetworkModelAtac::computeMemoryControllerPositions(SInt32 num_memory
    return (make_pair(true, core_id_list_with_memory_controllers));
 }
 
+UInt64
+FiniteBufferNetworkModelAtac::computeMinimumLatency()
+{
+   // Every router-to-router hop incurs at least the data (or credit) pipeline
+   // delay of the routers involved. Link delays are not included here.
+   const char* router_list[] = {"enet", "onet/send_hub", "onet/receive_hub", "star_net"};
+   SInt32 min_pipeline_delay = INT_MAX;
+
+   try
+   {
+      for (UInt32 i = 0; i < sizeof(router_list) / sizeof(router_list[0]); i++)
+      {
+         string router_section = string("network/atac/") + router_list[i] + "/router/";
+         min_pipeline_delay = min<SInt32>(min_pipeline_delay,
+               Sim()->getCfg()->getInt(router_section + "data_pipeline_delay"));
+         min_pipeline_delay = min<SInt32>(min_pipeline_delay,
+               Sim()->getCfg()->getInt(router_section + "credit_pipeline_delay"));
+      }
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read ATAC router parameters from the cfg file");
+   }
+
+   return (UInt64) min_pipeline_delay;
+}
+
 void
 FiniteBufferNetworkModelAtac::initializePerformanceCounters()
 {
@@ -13,9 +13,11 @@ public:
    void processReceivedPacket(const NetPacket* net_packet);
    // Output Summary 
    void outputSummary(ostream& out);
+   void reset();
 
    static pair<bool,SInt32> computeCoreCountConstraints(SInt32 core_count);
    static pair<bool,vector<core_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers);
+   static UInt64 computeMinimumLatency();
 
 private:
    ////// Private Enumerators
@@ -148,6 +150,9 @@ private:
    static GlobalRoute computeGlobalRoute(core_id_t sender, core_id_t receiver);
    // BNet link/channel to send the packet on
    static SInt32 computeReceiveNetID(core_id_t sender);
+   // Route number of a packet (ONet routes depend on the receive net of the sender)
+   static SInt32 getNumANetRoutes();
+   static SInt32 computeANetRouteNum(core_id_t sender, core_id_t receiver);
    // Parsing Functions
    static GlobalRoutingStrategy parseGlobalRoutingStrategy(string str);
    static ReceiveNetType parseReceiveNetType(string str);
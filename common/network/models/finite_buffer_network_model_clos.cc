@@ -90,6 +90,8 @@ FiniteBufferNetworkModelClos::FiniteBufferNetworkModelClos(Network* network, SIn
 
    // Seed the buffer for random number generation
    srand48_r(_core_id, &_rand_data_buffer);
+
+   initializeRoutingTables();
    
    LOG_PRINT("Exit FiniteBufferNetworkModelClos constructor core_id %i", _core_id);
 }
@@ -125,39 +127,87 @@ FiniteBufferNetworkModelClos::computeOutputEndpointList(HeadFlit* head_flit, Net
    LOG_PRINT("computeOutputEndpointList: head_flit, curr_network _node =(%p,%p) enter", head_flit, curr_network_node);
    LOG_PRINT("head_flit->_sender %i, head_flit->_receiver %i", head_flit->_sender, head_flit->_receiver);
    
-   // get routerID from curr_network_node to determine if we are at a core, ingress, middle, or egress
-   // for each case, will determine the next destination(s) and put them in head flit
    Router::Id curr_router_id = curr_network_node->getRouterId();
-   core_id_t curr_core_id = curr_router_id._core_id;
    SInt32 curr_router_index = curr_router_id._index;
-   LOG_PRINT("Current Router Id [%i,%i])", curr_router_id._core_id, curr_router_id._index);
-   
    assert(_core_id == curr_router_id._core_id);
-   
-   list<Router::Id> next_dest_list;                 // list of next destination routerIDs (note: if unicast router, will only have one routerID in this list)
-   vector<Channel::Endpoint> output_endpoint_vec;   
 
+   SInt32 route_num;
    if (curr_router_index == INGRESS_ROUTER)
    {
-      LOG_PRINT("At INGRESS_ROUTER with core_id %i. Compute next destination.", curr_core_id);
       // next destination is a random middle router
-      UInt32 middle_router_idx = getRandNum(0, num_mid_routers);                 // get random index
-      core_id_t next_coreID = middle_coreID_list[middle_router_idx];     // compute coreID of this random middle router from index
-      
-      Router::Id router_id(next_coreID, MIDDLE_ROUTER); 
-      // add next router to the list
-      next_dest_list.push_back(router_id);
-      LOG_PRINT("Next destination Router Id [%i,%i]", router_id._core_id, router_id._index);
-      
-      // add corresponding channel endpoint to the vector (will later be added to the head flit object)
-      Channel::Endpoint& output_endpoint = curr_network_node->getOutputEndpointFromRouterId(router_id);
-      output_endpoint_vec.push_back(output_endpoint);
+      route_num = getRandNum(0, num_mid_routers);
    }
+   else // (curr_router_index == MIDDLE_ROUTER || curr_router_index == EGRESS_ROUTER)
+   {
+      route_num = computeRouteNum(head_flit->_sender, head_flit->_receiver);
+   }
+
+   RoutingTable* routing_table = _routing_table_map[curr_router_index];
+   LOG_ASSERT_ERROR(routing_table, "Unrecognized Node Type(%i)", curr_router_index);
+   head_flit->_output_endpoint_list = routing_table->getRoute(route_num);
    
+   LOG_PRINT("computeOutputEndpointList(%p, %p) end", head_flit, curr_network_node);
+}
+
+void
+FiniteBufferNetworkModelClos::initializeRoutingTables()
+{
+   map<SInt32, NetworkNode*>::iterator it = _network_node_map.begin();
+   for ( ; it != _network_node_map.end(); it ++)
+   {
+      SInt32 router_index = (*it).first;
+      NetworkNode* network_node = (*it).second;
+      if (router_index == NET_PACKET_INJECTOR)
+         continue;
+
+      RoutingTable* routing_table;
+      if (router_index == INGRESS_ROUTER)
+      {
+         // One route per middle router
+         routing_table = new RoutingTable(num_mid_routers);
+         for (UInt32 i = 0; i < num_mid_routers; i++)
+         {
+            Router::Id router_id(middle_coreID_list[i], MIDDLE_ROUTER);
+            vector<Channel::Endpoint> output_endpoint_vec(1, network_node->getOutputEndpointFromRouterId(router_id));
+            routing_table->setRoute(i, output_endpoint_vec);
+         }
+      }
+      else // (router_index == MIDDLE_ROUTER || router_index == EGRESS_ROUTER)
+      {
+         routing_table = new RoutingTable(getNumRoutes());
+         for (core_id_t core_id = 0; core_id < (core_id_t) Config::getSingleton()->getTotalCores(); core_id ++)
+         {
+            // An egress router only reaches the cores connected to it
+            if ( (router_index == MIDDLE_ROUTER) ||
+                 (egress_coreID_list[core_id/num_router_ports] == _core_id) )
+            {
+               vector<Channel::Endpoint> unicast_endpoint_vec;
+               computeOutputEndpointVec(network_node, core_id, unicast_endpoint_vec);
+               routing_table->setRoute(computeRouteNum(_core_id, core_id), unicast_endpoint_vec);
+            }
+
+            vector<Channel::Endpoint> broadcast_endpoint_vec;
+            computeOutputEndpointVec(network_node, NetPacket::BROADCAST, broadcast_endpoint_vec);
+            routing_table->setRoute(computeRouteNum(core_id, NetPacket::BROADCAST), broadcast_endpoint_vec);
+         }
+      }
+      _routing_table_map[router_index] = routing_table;
+   }
+}
+
+// Output endpoints of a middle or an egress router
+void
+FiniteBufferNetworkModelClos::computeOutputEndpointVec(NetworkNode* curr_network_node, core_id_t receiver,
+                                                       vector<Channel::Endpoint>& output_endpoint_vec)
+{
+   Router::Id curr_router_id = curr_network_node->getRouterId();
+   core_id_t curr_core_id = curr_router_id._core_id;
+   SInt32 curr_router_index = curr_router_id._index;
+
    // if at MIDDLE_ROUTER
-   else if (curr_router_index == MIDDLE_ROUTER)
+   if (curr_router_index == MIDDLE_ROUTER)
    {
-      if (head_flit->_receiver == NetPacket::BROADCAST)
+      if (receiver == NetPacket::BROADCAST)
       {
          // multicast it to all egress routers
          for (UInt32 i = 0; i < num_in_routers; i++)
@@ -165,23 +215,20 @@ FiniteBufferNetworkModelClos::computeOutputEndpointList(HeadFlit* head_flit, Net
             output_endpoint_vec.push_back(Channel::Endpoint(i,0));
          }
       }
-      else // (head_flit->_receiver != NetPacket::BROADCAST)
+      else // (receiver != NetPacket::BROADCAST)
       {
          LOG_PRINT("At MIDDLE_ROUTER with core_id %i. Compute next destination.", curr_core_id);
          // next destination is the correct output router
          
          // compute coreID of egress router the receiving core is connected to (based on coreID)
          // simular computation as for sending core connections to ingress routers
-         core_id_t next_coreID = egress_coreID_list[head_flit->_receiver/num_router_ports];     
+         core_id_t next_coreID = egress_coreID_list[receiver/num_router_ports];     
          
          // this is the router id for next destination
          Router::Id router_id(next_coreID, EGRESS_ROUTER);
          LOG_PRINT("Next destination Router Id [%i,%i]", router_id._core_id, router_id._index);
          
-         // add it to the list
-         next_dest_list.push_back(router_id);
-         
-         // add corresponding channel endpoint to the vector (will later be added to the head flit object)
+         // add corresponding channel endpoint to the vector
          Channel::Endpoint& output_endpoint = curr_network_node->getOutputEndpointFromRouterId(router_id);
          output_endpoint_vec.push_back(output_endpoint);
       }
@@ -190,7 +237,7 @@ FiniteBufferNetworkModelClos::computeOutputEndpointList(HeadFlit* head_flit, Net
    // if at EGRESS_ROUTER
    else if (curr_router_index == EGRESS_ROUTER)
    {
-      if (head_flit->_receiver == NetPacket::BROADCAST)
+      if (receiver == NetPacket::BROADCAST)
       {
          // Multicast it to all output ports (all cores connected to this router)
          for (UInt32 i = 0; i < num_router_ports ; i++)
@@ -198,20 +245,15 @@ FiniteBufferNetworkModelClos::computeOutputEndpointList(HeadFlit* head_flit, Net
             output_endpoint_vec.push_back(Channel::Endpoint(i,0));
          }
       }
-      else // (head_flit->_receiver != NetPacket::BROADCAST)
+      else // (receiver != NetPacket::BROADCAST)
       {
          LOG_PRINT("At EGRESS_ROUTER with core_id %i. Compute next destination.", curr_core_id);
          // next destination is the correct receiving core
-         core_id_t next_coreID = head_flit->_receiver;
-         
-         // this is the router id for next destination
-         Router::Id  router_id(next_coreID, CORE_INTERFACE);
+         Router::Id router_id(receiver, CORE_INTERFACE);
          LOG_PRINT("Next destination Router Id [%i,%i]", router_id._core_id, router_id._index);
-          //add it to the list
-         next_dest_list.push_back(router_id);
          
-         //add corresponding channel endpoint to the vector (will later be added to the head flit object)
-         Channel::Endpoint& output_endpoint = curr_network_node->getOutputEndpointFromRouterId(router_id);        //check that the routerID in param of function is supposed to be *next* (not curr) router!!!
+         // add corresponding channel endpoint to the vector
+         Channel::Endpoint& output_endpoint = curr_network_node->getOutputEndpointFromRouterId(router_id);
          output_endpoint_vec.push_back(output_endpoint);
       }
    }
@@ -220,13 +262,6 @@ FiniteBufferNetworkModelClos::computeOutputEndpointList(HeadFlit* head_flit, Net
    {
       LOG_PRINT_ERROR("Unrecognized Node Type(%i)", curr_router_index);
    }
-     
-   LOG_PRINT("Initialize head flit's channel endpoint list...");
-   // In all cases...
-   // Initialize the output channel struct inside head_flit
-   head_flit->_output_endpoint_list = new vector<Channel::Endpoint>(output_endpoint_vec);
-   
-   LOG_PRINT("computeOutputEndpointList(%p, %p) end", head_flit, curr_network_node);
 }
 
 
@@ -21,7 +21,6 @@ class FiniteBufferNetworkModelClos : public FiniteBufferNetworkModel
 
       volatile float getFrequency() { return _frequency; }
       void outputSummary(ostream& out);            // prints to output_files/sim.out
-      void reset() {}
      
       static pair<bool,UInt32> computeCoreCountConstraints(SInt32 core_count); 
       static pair<bool,vector<core_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers);
@@ -52,6 +51,10 @@ class FiniteBufferNetworkModelClos : public FiniteBufferNetworkModel
       // Main Routing Function ************************
       // Compute the next router to send the head packet to
       void computeOutputEndpointList(HeadFlit* head_flit, NetworkNode* curr_network_node);
+      // Build the routing tables of the routers on this core
+      void initializeRoutingTables();
+      void computeOutputEndpointVec(NetworkNode* curr_network_node, core_id_t receiver,
+                                    vector<Channel::Endpoint>& output_endpoint_vec);
       
       // Compute which ingress router the sender core is connected to
       Router::Id computeIngressRouterId(core_id_t core_id);
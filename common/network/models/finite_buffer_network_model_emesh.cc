@@ -12,18 +12,22 @@
 
 FiniteBufferNetworkModelEMesh::FiniteBufferNetworkModelEMesh(Network* net, SInt32 network_id)
    : FiniteBufferNetworkModel(net, network_id)
+   , _neighbor_routing_table(NULL)
 {
    _emesh_network = "network/emesh/";
    // Initialize EMesh Topology Parameters
    computeEMeshTopologyParameters(_emesh_width, _emesh_height);
 
    // Get Network Parameters
+   SInt32 num_virtual_channels = 1;
    try
    {
       _frequency = Sim()->getCfg()->getFloat(_emesh_network + "frequency");
       _flit_width = Sim()->getCfg()->getInt(_emesh_network + "flit_width");
       _flow_control_scheme = FlowControlScheme::parse(
             Sim()->getCfg()->getString(_emesh_network + "flow_control_scheme"));
+      num_virtual_channels = Sim()->getCfg()->getInt(_emesh_network + "router/num_virtual_channels");
+      _routing_algorithm = parseRoutingAlgorithm(Sim()->getCfg()->getString(_emesh_network + "routing_algorithm"));
    }
    catch (...)
    {
@@ -33,9 +37,12 @@ FiniteBufferNetworkModelEMesh::FiniteBufferNetworkModelEMesh(Network* net, SInt3
    // Instantiate the routers and links
    _network_node_map[NET_PACKET_INJECTOR] = createNetPacketInjectorNode(Router::Id(_core_id, EMESH),
          BufferManagementScheme::parse(Sim()->getCfg()->getString(_emesh_network + "buffer_management_scheme")),
-         Sim()->getCfg()->getInt(_emesh_network + "router/input_buffer_size") );
+         Sim()->getCfg()->getInt(_emesh_network + "router/input_buffer_size"),
+         num_virtual_channels);
    
    _network_node_map[EMESH] = createNetworkNode();
+
+   initializeRoutingTable();
 }
 
 FiniteBufferNetworkModelEMesh::~FiniteBufferNetworkModelEMesh()
@@ -44,6 +51,23 @@ FiniteBufferNetworkModelEMesh::~FiniteBufferNetworkModelEMesh()
    map<SInt32, NetworkNode*>::iterator it = _network_node_map.begin();
    for ( ; it != _network_node_map.end(); it ++)
       delete (*it).second;
+   delete _neighbor_routing_table;
+}
+
+FiniteBufferNetworkModelEMesh::RoutingAlgorithm
+FiniteBufferNetworkModelEMesh::parseRoutingAlgorithm(string routing_algorithm_str)
+{
+   if (routing_algorithm_str == "xy")
+      return XY;
+   else if (routing_algorithm_str == "west_first")
+      return WEST_FIRST;
+   else if (routing_algorithm_str == "odd_even")
+      return ODD_EVEN;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Routing Algorithm(%s)", routing_algorithm_str.c_str());
+      return NUM_ROUTING_ALGORITHMS;
+   }
 }
 
 NetworkNode*
@@ -54,6 +78,7 @@ FiniteBufferNetworkModelEMesh::createNetworkNode()
    SInt32 data_pipeline_delay = 0;
    SInt32 credit_pipeline_delay = 0;
    SInt32 router_input_buffer_size = 0;
+   SInt32 num_virtual_channels = 1;
    string link_type;
    double link_length = _tile_width;
 
@@ -63,12 +88,16 @@ FiniteBufferNetworkModelEMesh::createNetworkNode()
       data_pipeline_delay = Sim()->getCfg()->getInt(_emesh_network + "router/data_pipeline_delay");
       credit_pipeline_delay = Sim()->getCfg()->getInt(_emesh_network + "router/credit_pipeline_delay");
       router_input_buffer_size = Sim()->getCfg()->getInt(_emesh_network + "router/input_buffer_size");
+      num_virtual_channels = Sim()->getCfg()->getInt(_emesh_network + "router/num_virtual_channels");
       link_type = Sim()->getCfg()->getString(_emesh_network + "link_type");
    }
    catch (...)
    {
       LOG_PRINT_ERROR("Could not read Electrical mesh parameters from the cfg file");
    }
+   // Only the wormhole_virtual_channel scheme splits the input buffers into VCs
+   if (_flow_control_scheme != FlowControlScheme::WORMHOLE_VIRTUAL_CHANNEL)
+      num_virtual_channels = 1;
      
    BufferManagementScheme::Type buffer_management_scheme =
          BufferManagementScheme::parse(buffer_management_scheme_str);
@@ -135,12 +164,13 @@ FiniteBufferNetworkModelEMesh::createNetworkNode()
              num_input_channels, num_output_channels,
              num_input_endpoints_list, num_output_endpoints_list,
              input_buffer_management_schemes, downstream_buffer_management_schemes,
-             input_buffer_size_list, downstream_buffer_size_list);
+             input_buffer_size_list, downstream_buffer_size_list,
+             num_virtual_channels);
 
-   // Create the router power model
+   // Create the router power model (input_buffer_size flits per VC)
    RouterPowerModel* router_power_model =
          RouterPowerModel::create(num_input_channels, num_output_channels,
-                                  router_input_buffer_size, _flit_width);
+                                  router_input_buffer_size * num_virtual_channels, _flit_width);
 
    // Create the output link performance and power models
    vector<LinkPerformanceModel*> link_performance_model_list;
@@ -175,18 +205,175 @@ FiniteBufferNetworkModelEMesh::computeOutputEndpointList(HeadFlit* head_flit, Ne
 {
    LOG_PRINT("computeOutputEndpointList(%p,%p) enter", head_flit, curr_network_node);
 
+   if ( (_routing_algorithm == XY) ||
+        (head_flit->_receiver == NetPacket::BROADCAST) || (head_flit->_receiver == _core_id) )
+   {
+      RoutingTable* routing_table = _routing_table_map[EMESH];
+      head_flit->_output_endpoint_list = routing_table->getRoute(computeRouteNum(head_flit->_sender, head_flit->_receiver));
+   }
+   else
+   {
+      head_flit->_output_endpoint_list = computeAdaptiveRoute(head_flit, curr_network_node);
+   }
+   
+   LOG_PRINT("computeOutputEndpointList(%p,%p) exit, channel_endpoint_list.size(%u)",
+         head_flit, curr_network_node, head_flit->_output_endpoint_list->size());
+}
+
+void
+FiniteBufferNetworkModelEMesh::initializeRoutingTable()
+{
+   // Unicast routes depend only on the receiver and broadcast routes only on the sender
+   NetworkNode* network_node = _network_node_map[EMESH];
+   RoutingTable* routing_table = new RoutingTable(getNumRoutes());
+   
+   SInt32 total_cores = Config::getSingleton()->getTotalCores();
+   for (core_id_t core_id = 0; core_id < total_cores; core_id ++)
+   {
+      vector<Channel::Endpoint> unicast_endpoint_vec;
+      computeOutputEndpointVec(network_node, _core_id, core_id, unicast_endpoint_vec);
+      routing_table->setRoute(computeRouteNum(_core_id, core_id), unicast_endpoint_vec);
+
+      vector<Channel::Endpoint> broadcast_endpoint_vec;
+      computeOutputEndpointVec(network_node, core_id, NetPacket::BROADCAST, broadcast_endpoint_vec);
+      routing_table->setRoute(computeRouteNum(core_id, NetPacket::BROADCAST), broadcast_endpoint_vec);
+   }
+
+   _routing_table_map[EMESH] = routing_table;
+
+   if (_routing_algorithm != XY)
+   {
+      // Adaptive routes are chosen at every hop among the neighboring routers
+      _neighbor_routing_table = new RoutingTable(network_node->getNumOutputChannels());
+
+      SInt32 cx, cy;
+      computeEMeshPosition(_core_id, cx, cy);
+      SInt32 dx[4] = {-1,1,0,0};
+      SInt32 dy[4] = {0,0,-1,1};
+      for (SInt32 i = 0; i < 4; i++)
+      {
+         core_id_t core_id = computeCoreId(cx+dx[i], cy+dy[i]);
+         if (core_id != INVALID_CORE_ID)
+         {
+            Router::Id router_id(core_id, EMESH);
+            Channel::Endpoint& output_endpoint = network_node->getOutputEndpointFromRouterId(router_id);
+            _neighbor_routing_table->setRoute(output_endpoint._channel_id, vector<Channel::Endpoint>(1, output_endpoint));
+         }
+      }
+   }
+}
+
+vector<Channel::Endpoint>*
+FiniteBufferNetworkModelEMesh::computeAdaptiveRoute(HeadFlit* head_flit, NetworkNode* curr_network_node)
+{
+   vector<core_id_t> neighbor_vec;
+   computeProductiveNeighbors(head_flit->_sender, head_flit->_receiver, neighbor_vec);
+   LOG_ASSERT_ERROR(!neighbor_vec.empty(), "No productive output: Sender(%i), Receiver(%i), Curr Core(%i)",
+         head_flit->_sender, head_flit->_receiver, _core_id);
+
+   // Selection: the output with the most free downstream buffers (the first one on a tie)
+   FlowControlScheme* flow_control_object = curr_network_node->getRouterPerformanceModel()->getFlowControlObject();
+   SInt32 selected_channel = Channel::INVALID;
+   SInt32 max_free_buffers = -1;
+   for (vector<core_id_t>::iterator it = neighbor_vec.begin(); it != neighbor_vec.end(); it ++)
+   {
+      Router::Id router_id(*it, EMESH);
+      Channel::Endpoint& output_endpoint = curr_network_node->getOutputEndpointFromRouterId(router_id);
+      SInt32 num_free_buffers = flow_control_object->getNumFreeDownstreamBuffers(output_endpoint);
+      if (num_free_buffers > max_free_buffers)
+      {
+         selected_channel = output_endpoint._channel_id;
+         max_free_buffers = num_free_buffers;
+      }
+   }
+
+   LOG_PRINT("Adaptive Route: Sender(%i), Receiver(%i), Output Channel(%i), Free Buffers(%i)",
+         head_flit->_sender, head_flit->_receiver, selected_channel, max_free_buffers);
+   return _neighbor_routing_table->getRoute(selected_channel);
+}
+
+// Neighbors on a minimal path to 'receiver' that the routing algorithm allows
+// (the X direction first)
+void
+FiniteBufferNetworkModelEMesh::computeProductiveNeighbors(core_id_t sender, core_id_t receiver,
+                                                          vector<core_id_t>& neighbor_vec)
+{
+   SInt32 sx, sy, cx, cy, dx, dy;
+   computeEMeshPosition(sender, sx, sy);
+   computeEMeshPosition(_core_id, cx, cy);
+   computeEMeshPosition(receiver, dx, dy);
+
+   SInt32 ex = dx - cx;
+   SInt32 ey = dy - cy;
+   SInt32 step_y = (ey > 0) ? 1 : -1;
+
+   switch (_routing_algorithm)
+   {
+      case WEST_FIRST:
+         // All the west hops come first, after that any productive direction
+         if (ex < 0)
+         {
+            neighbor_vec.push_back(computeCoreId(cx-1, cy));
+         }
+         else
+         {
+            if (ex > 0)
+               neighbor_vec.push_back(computeCoreId(cx+1, cy));
+            if (ey != 0)
+               neighbor_vec.push_back(computeCoreId(cx, cy+step_y));
+         }
+         break;
+
+      case ODD_EVEN:
+         // No east->north/south turns in even columns and
+         // no north/south->west turns in odd columns (G.-M. Chiu, 2000)
+         if (ex == 0)
+         {
+            neighbor_vec.push_back(computeCoreId(cx, cy+step_y));
+         }
+         else if (ex > 0)
+         {
+            if (ey == 0)
+            {
+               neighbor_vec.push_back(computeCoreId(cx+1, cy));
+            }
+            else
+            {
+               if ((dx % 2 == 1) || (ex != 1))
+                  neighbor_vec.push_back(computeCoreId(cx+1, cy));
+               if ((cx % 2 == 1) || (cx == sx))
+                  neighbor_vec.push_back(computeCoreId(cx, cy+step_y));
+            }
+         }
+         else // (ex < 0)
+         {
+            neighbor_vec.push_back(computeCoreId(cx-1, cy));
+            if ((ey != 0) && (cx % 2 == 0))
+               neighbor_vec.push_back(computeCoreId(cx, cy+step_y));
+         }
+         break;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized Adaptive Routing Algorithm(%u)", _routing_algorithm);
+         break;
+   }
+}
+
+void
+FiniteBufferNetworkModelEMesh::computeOutputEndpointVec(NetworkNode* curr_network_node,
+      core_id_t sender, core_id_t receiver, vector<Channel::Endpoint>& output_endpoint_vec)
+{
    Router::Id curr_router_id = curr_network_node->getRouterId();
    core_id_t curr_core_id = curr_router_id._core_id;
    SInt32 cx, cy;
    computeEMeshPosition(curr_core_id, cx, cy);
 
    list<core_id_t> next_dest_list;
-   vector<Channel::Endpoint> output_endpoint_vec;
 
-   if (head_flit->_receiver == NetPacket::BROADCAST)
+   if (receiver == NetPacket::BROADCAST)
    {
       SInt32 sx, sy;
-      computeEMeshPosition(head_flit->_sender, sx, sy);
+      computeEMeshPosition(sender, sx, sy);
 
       if (cy >= sy)
          next_dest_list.push_back(computeCoreId(cx,cy+1));
@@ -217,10 +404,10 @@ FiniteBufferNetworkModelEMesh::computeOutputEndpointList(HeadFlit* head_flit, Ne
          }
       }
    }
-   else // (head_flit->_receiver != NetPacket::BROADCAST)
+   else // (receiver != NetPacket::BROADCAST)
    {
       SInt32 dx, dy;
-      computeEMeshPosition(head_flit->_receiver, dx, dy);
+      computeEMeshPosition(receiver, dx, dy);
 
       if (cx > dx)
       {
@@ -258,19 +445,13 @@ FiniteBufferNetworkModelEMesh::computeOutputEndpointList(HeadFlit* head_flit, Ne
       output_endpoint_vec.push_back(output_endpoint);
       
       LOG_PRINT("Sender(%i), Receiver(%i), Curr Router(%i,%i), Next Router(%i,%i), Output Endpoint(%i,%i)",
-            head_flit->_sender, head_flit->_receiver, curr_core_id, curr_router_id._index,
+            sender, receiver, curr_core_id, curr_router_id._index,
             router_id._core_id, router_id._index,
             output_endpoint._channel_id, output_endpoint._index);
       LOG_PRINT("Next Router(%i,%i), Output Endpoint(%i,%i)",
             router_id._core_id, router_id._index,
             output_endpoint._channel_id, output_endpoint._index);
    }
-
-   // Initialize the output channel struct inside head_flit
-   head_flit->_output_endpoint_list = new vector<Channel::Endpoint>(output_endpoint_vec);
-   
-   LOG_PRINT("computeOutputEndpointList(%p,%p) exit, channel_endpoint_list.size(%u)",
-         head_flit, curr_network_node, head_flit->_output_endpoint_list->size());
 }
 
 void
@@ -370,6 +551,40 @@ FiniteBufferNetworkModelEMesh::computeMemoryControllerPositions(SInt32 num_memor
    return (make_pair(true, core_id_list_with_memory_controllers));
 }
 
+UInt64
+FiniteBufferNetworkModelEMesh::computeMinimumLatency()
+{
+   // Flits between neighboring routers incur (data_pipeline_delay + link_delay)
+   // Credits (or on/off signals) incur (credit_pipeline_delay + link_delay)
+   SInt32 data_pipeline_delay = 0;
+   SInt32 credit_pipeline_delay = 0;
+   volatile float frequency = 0;
+   UInt32 flit_width = 0;
+   double link_length = 0;
+   string link_type;
+
+   try
+   {
+      frequency = Sim()->getCfg()->getFloat("network/emesh/frequency");
+      flit_width = Sim()->getCfg()->getInt("network/emesh/flit_width");
+      data_pipeline_delay = Sim()->getCfg()->getInt("network/emesh/router/data_pipeline_delay");
+      credit_pipeline_delay = Sim()->getCfg()->getInt("network/emesh/router/credit_pipeline_delay");
+      link_length = Sim()->getCfg()->getFloat("general/tile_width");
+      link_type = Sim()->getCfg()->getString("network/emesh/link_type");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read Electrical mesh parameters from the cfg file");
+   }
+
+   ElectricalLinkPerformanceModel* link_performance_model =
+      ElectricalLinkPerformanceModel::create(link_type, frequency, link_length, flit_width, 1);
+   UInt64 link_delay = link_performance_model->getDelay();
+   delete link_performance_model;
+
+   return ((UInt64) min<SInt32>(data_pipeline_delay, credit_pipeline_delay)) + link_delay;
+}
+
 void
 FiniteBufferNetworkModelEMesh::outputSummary(ostream& out)
 {
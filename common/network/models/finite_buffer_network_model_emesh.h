@@ -15,6 +15,7 @@ class FiniteBufferNetworkModelEMesh : public FiniteBufferNetworkModel
 
       static pair<bool,SInt32> computeCoreCountConstraints(SInt32 core_count);
       static pair<bool,vector<core_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers);
+      static UInt64 computeMinimumLatency();
    
    private:
       enum NodeType
@@ -22,6 +23,18 @@ class FiniteBufferNetworkModelEMesh : public FiniteBufferNetworkModel
          EMESH = 1 // Always start at 1
       };
 
+      // Unicast routing algorithms (broadcasts always follow the XY tree)
+      // WEST_FIRST and ODD_EVEN are minimal and adaptive; they pick the productive
+      // output with the most free downstream buffers
+      enum RoutingAlgorithm
+      {
+         XY = 0,
+         WEST_FIRST,
+         ODD_EVEN,
+         NUM_ROUTING_ALGORITHMS
+      };
+      static RoutingAlgorithm parseRoutingAlgorithm(string routing_algorithm_str);
+
       // Private Functions
       NetworkNode* createNetworkNode();
 
@@ -34,6 +47,13 @@ class FiniteBufferNetworkModelEMesh : public FiniteBufferNetworkModel
 
       // Main Routing Function
       void computeOutputEndpointList(HeadFlit* head_flit, NetworkNode* curr_network_node);
+      // Routing Table
+      void initializeRoutingTable();
+      void computeOutputEndpointVec(NetworkNode* curr_network_node, core_id_t sender, core_id_t receiver,
+                                    vector<Channel::Endpoint>& output_endpoint_vec);
+      // Adaptive Routing
+      vector<Channel::Endpoint>* computeAdaptiveRoute(HeadFlit* head_flit, NetworkNode* curr_network_node);
+      void computeProductiveNeighbors(core_id_t sender, core_id_t receiver, vector<core_id_t>& neighbor_vec);
 
       // Event Count Summary
       void outputEventCountersSummary(ostream& out);
@@ -45,6 +65,10 @@ class FiniteBufferNetworkModelEMesh : public FiniteBufferNetworkModel
       
       string _emesh_network;
 
+      RoutingAlgorithm _routing_algorithm;
+      // Single hop routes to the neighboring routers, indexed by output channel
+      RoutingTable* _neighbor_routing_table;
+
       // Topology Parameters
       SInt32 _emesh_width;
       SInt32 _emesh_height;
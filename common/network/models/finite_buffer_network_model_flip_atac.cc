@@ -115,6 +115,13 @@ FiniteBufferNetworkModelFlipAtac::FiniteBufferNetworkModelFlipAtac(Network* netw
    
    // Seed the buffer for random number generation --> will be used for MIDDLE_ROUTER stage in Clos
    srand48_r(core_id, &_rand_data_buffer);
+
+   // Routing Tables: one route per middle router at the ingress router, one route per receiver elsewhere
+   _routing_table_map[BCAST_ROUTER] = new RoutingTable(getNumRoutes());
+   _routing_table_map[MUX_ROUTER] = new RoutingTable(getNumRoutes());
+   _routing_table_map[INGRESS_ROUTER] = new RoutingTable(_num_mid_routers);
+   _routing_table_map[MIDDLE_ROUTER] = new RoutingTable(getNumRoutes());
+   _routing_table_map[EGRESS_ROUTER] = new RoutingTable(getNumRoutes());
    
    LOG_PRINT("Exit FiniteBufferNetworkModelFlipAtac constructor core_id %i", core_id);
 }
@@ -151,7 +158,42 @@ FiniteBufferNetworkModelFlipAtac::computeOutputEndpointList(HeadFlit* head_flit,
 {
    LOG_PRINT("computeOutputEndpointList: head_flit, curr_network _node =(%p,%p) enter", head_flit, curr_network_node);
    LOG_PRINT("head_flit->_sender %i, head_flit->_receiver %i", head_flit->_sender, head_flit->_receiver);
+   LOG_ASSERT_ERROR(head_flit->_receiver != NetPacket::BROADCAST, "Broadcasts not supported on Flip-ATAC");
+
+   SInt32 curr_router_index = curr_network_node->getRouterId()._index;
+
+   // At the ingress router, the next destination is a random middle router *in same cluster*
+   UInt32 middle_router_idx = 0;
+   SInt32 route_num;
+   if (curr_router_index == INGRESS_ROUTER)
+   {
+      middle_router_idx = getRandNum(0, _num_mid_routers);                 // get random index
+      route_num = middle_router_idx;
+   }
+   else
+   {
+      route_num = computeRouteNum(head_flit->_sender, head_flit->_receiver);
+   }
+
+   // The routers on a core are not all used, so the routes are computed on first use
+   RoutingTable* routing_table = _routing_table_map[curr_router_index];
+   head_flit->_output_endpoint_list = routing_table->getRoute(route_num);
+   if (!head_flit->_output_endpoint_list)
+   {
+      vector<Channel::Endpoint> output_endpoint_vec;
+      computeOutputEndpointVec(curr_network_node, head_flit->_receiver, middle_router_idx, output_endpoint_vec);
+      head_flit->_output_endpoint_list = routing_table->setRoute(route_num, output_endpoint_vec);
+   }
    
+   LOG_PRINT("computeOutputEndpointList(%p, %p) end", head_flit, curr_network_node);
+}
+
+// Output endpoints of a router for a packet to 'receiver'
+// (through middle router 'middle_router_idx' of this cluster at an ingress router)
+void
+FiniteBufferNetworkModelFlipAtac::computeOutputEndpointVec(NetworkNode* curr_network_node,
+      core_id_t receiver, UInt32 middle_router_idx, vector<Channel::Endpoint>& output_endpoint_vec)
+{
    // get the current router id
    Router::Id curr_router_id = curr_network_node->getRouterId();
    core_id_t curr_core_id = curr_router_id._core_id;
@@ -161,7 +203,6 @@ FiniteBufferNetworkModelFlipAtac::computeOutputEndpointList(HeadFlit* head_flit,
    assert(_core_id == curr_router_id._core_id);
    
    list<Router::Id> next_dest_list;                   // list of next destination routerIDs
-   vector<Channel::Endpoint> output_endpoint_vec;     // list of endpoints to go to
 
    if (curr_router_index == BCAST_ROUTER){
       LOG_PRINT("At BCAST_ROUTER with core_id %i. Compute next destination.", curr_core_id);
@@ -174,7 +215,7 @@ FiniteBufferNetworkModelFlipAtac::computeOutputEndpointList(HeadFlit* head_flit,
       // this channel is considered utilized whether you send to one endpoint (one cluster) or all endpoints (all clusters)
             
       //find cluster ID of receiving core
-      core_id_t receiving_clusterID = (head_flit->_receiver) / _num_cores_per_cluster;
+      core_id_t receiving_clusterID = (receiver) / _num_cores_per_cluster;
       
       core_id_t mux_coreID = receiving_clusterID * _num_cores_per_cluster + (curr_core_id / _num_clusters); //mux_index =(node_coreID/_num_clusters);
       Router::Id router_id(mux_coreID, MUX_ROUTER);
@@ -196,7 +237,7 @@ FiniteBufferNetworkModelFlipAtac::computeOutputEndpointList(HeadFlit* head_flit,
       // actually, don't need to drop packets in this version of code, but keep this in as an error check
       bool core_in_cluster = false;
       for (UInt32 i = 0; i < cluster_mux_coreID_list.size(); i++){
-         if (head_flit->_receiver == cluster_mux_coreID_list[i]){
+         if (receiver == cluster_mux_coreID_list[i]){
              // receiver core is in this cluster
              core_in_cluster = true;
          }
@@ -205,8 +246,7 @@ FiniteBufferNetworkModelFlipAtac::computeOutputEndpointList(HeadFlit* head_flit,
       
       if (!core_in_cluster){ //if receiver core not in this cluster  --> should never be the case in this version of the code, since only send packet to receiving cluster
          // drop the packet!!!
-         LOG_PRINT("Drop packet at MUX_ROUTER with core id %i because receiver core %i is not in this cluster %i.", curr_core_id, head_flit->_receiver, _cluster_id);
-         head_flit->_output_endpoint_list = new vector<Channel::Endpoint>(vector<Channel::Endpoint>());
+         LOG_PRINT("Drop packet at MUX_ROUTER with core id %i because receiver core %i is not in this cluster %i.", curr_core_id, receiver, _cluster_id);
          return; 
       }
       
@@ -226,7 +266,6 @@ FiniteBufferNetworkModelFlipAtac::computeOutputEndpointList(HeadFlit* head_flit,
    else if (curr_router_index == INGRESS_ROUTER){
       LOG_PRINT("At INGRESS_ROUTER with core_id %i. Compute next destination.", curr_core_id);
       // next destination is a random middle router *in same cluster*
-      UInt32 middle_router_idx = getRandNum(0, _num_mid_routers);                 // get random index
       if (_cluster_id)                                                            // leave this index unchanged if _cluster_id = 0
       {      
          middle_router_idx = _cluster_id *_num_mid_routers + middle_router_idx;                    // get middle index at this cluster
@@ -250,7 +289,7 @@ FiniteBufferNetworkModelFlipAtac::computeOutputEndpointList(HeadFlit* head_flit,
       // next destination is the correct egress router
       
       // compute coreID of egress router the receiving core is connected to (based on coreID)
-      core_id_t next_coreID = _egress_coreID_list[(head_flit->_receiver/_num_router_ports)]; 
+      core_id_t next_coreID = _egress_coreID_list[(receiver/_num_router_ports)]; 
      
 	   // this is the router id for next destination
       Router::Id router_id(next_coreID, EGRESS_ROUTER); 
@@ -268,7 +307,7 @@ FiniteBufferNetworkModelFlipAtac::computeOutputEndpointList(HeadFlit* head_flit,
    else if (curr_router_index == EGRESS_ROUTER) {  
       LOG_PRINT("At EGRESS_ROUTER with core_id %i. Compute next destination.", curr_core_id);
       // next destination is the correct receiving core
-      core_id_t next_coreID = head_flit->_receiver;
+      core_id_t next_coreID = receiver;
       
       // this is the router id for next destination
       Router::Id  router_id(next_coreID, CORE_INTERFACE);
@@ -280,13 +319,6 @@ FiniteBufferNetworkModelFlipAtac::computeOutputEndpointList(HeadFlit* head_flit,
       Channel::Endpoint& output_endpoint = curr_network_node->getOutputEndpointFromRouterId(router_id); 
       output_endpoint_vec.push_back(output_endpoint);
    }
-     
-   LOG_PRINT("Initialize head flit's channel endpoint list...");
-   // In all cases...
-   // Initialize the output channel struct inside head_flit
-   head_flit->_output_endpoint_list = new vector<Channel::Endpoint>(output_endpoint_vec);
-   
-   LOG_PRINT("computeOutputEndpointList(%p, %p) end", head_flit, curr_network_node);
 }
 
 // creates network node of type router_index for the core with id node_coreID
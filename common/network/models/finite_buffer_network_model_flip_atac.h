@@ -24,7 +24,6 @@ class FiniteBufferNetworkModelFlipAtac : public FiniteBufferNetworkModel
 
       volatile float getFrequency() { return _frequency; }
       void outputSummary(ostream& out);
-      void reset() {}
      
       static pair<bool,UInt32> computeCoreCountConstraints(SInt32 core_count); 
       static pair<bool,vector<core_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers);
@@ -58,7 +57,9 @@ class FiniteBufferNetworkModelFlipAtac : public FiniteBufferNetworkModel
       // Virtual function in FiniteBufferNetworkModel 
       // Main Routing Function ************************
       // Compute the next router to send the head packet to
-      void computeOutputEndpointList(HeadFlit* head_flit, NetworkNode* curr_network_node);    	  
+      void computeOutputEndpointList(HeadFlit* head_flit, NetworkNode* curr_network_node);
+      void computeOutputEndpointVec(NetworkNode* curr_network_node, core_id_t receiver, UInt32 middle_router_idx,
+                                    vector<Channel::Endpoint>& output_endpoint_vec);    	  
       // Function to compute the first router that the sender core is connected to (for flip_atac, this is the BCAST router)
       Router::Id computeIngressRouterId(core_id_t core_id);             
             
@@ -6,6 +6,7 @@
 #include "config.h"
 #include "config.h"
 #include "core.h"
+#include "core_manager.h"
 #include "clock_converter.h"
 
 NetworkModelEMeshHopCounter::NetworkModelEMeshHopCounter(Network *net, SInt32 network_id)
@@ -17,9 +18,12 @@ NetworkModelEMeshHopCounter::NetworkModelEMeshHopCounter(Network *net, SInt32 ne
    _mesh_width = (SInt32) floor (sqrt(total_cores));
    _mesh_height = (SInt32) ceil (1.0 * total_cores / _mesh_width);
 
+   string link_contention_model_type;
    try
    {
       _frequency = Sim()->getCfg()->getFloat("network/emesh/frequency");
+      _link_contention_model_enabled = Sim()->getCfg()->getBool("network/emesh/link_contention_model/enabled");
+      link_contention_model_type = Sim()->getCfg()->getString("network/emesh/link_contention_model/type");
    }
    catch (...)
    {
@@ -36,6 +40,14 @@ NetworkModelEMeshHopCounter::NetworkModelEMeshHopCounter(Network *net, SInt32 ne
    // Create Sender and Receiver Contention Models
    _sender_contention_model = new QueueModelSimple();
    _receiver_contention_model = new QueueModelSimple();
+
+   // Create Link Contention Models
+   if (_link_contention_model_enabled)
+   {
+      // A packet occupies a link for at least one cycle
+      for (SInt32 i = 0; i < NUM_LINK_DIRECTIONS; i++)
+         _link_contention_model_list.push_back(QueueModel::create(link_contention_model_type, 1));
+   }
 }
 
 NetworkModelEMeshHopCounter::~NetworkModelEMeshHopCounter()
@@ -43,6 +55,9 @@ NetworkModelEMeshHopCounter::~NetworkModelEMeshHopCounter()
    // Destroy Sender & Receiver Contention Models
    delete _sender_contention_model;
    delete _receiver_contention_model;
+   // Destroy Link Contention Models
+   for (UInt32 i = 0; i < _link_contention_model_list.size(); i++)
+      delete _link_contention_model_list[i];
 
    // Destroy the Router & Link Models
    destroyRouterAndLinkModels();
@@ -103,6 +118,37 @@ NetworkModelEMeshHopCounter::createRouterAndLinkModels()
    initializeEventCounters();
 }
 
+UInt64
+NetworkModelEMeshHopCounter::computeMinimumLatency()
+{
+   // Messages between two different cores traverse at least one hop
+   UInt64 router_delay = 0;
+   volatile float frequency = 0;
+   UInt32 flit_width = 0;
+   double link_length = 0;
+   string link_type;
+
+   try
+   {
+      frequency = Sim()->getCfg()->getFloat("network/emesh/frequency");
+      flit_width = Sim()->getCfg()->getInt("network/emesh/flit_width");
+      link_length = Sim()->getCfg()->getFloat("general/tile_width");
+      link_type = Sim()->getCfg()->getString("network/emesh/link_type");
+      router_delay = (UInt64) Sim()->getCfg()->getInt("network/emesh/router/data_pipeline_delay");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read emesh_hop_counter link and router parameters");
+   }
+
+   ElectricalLinkPerformanceModel* link_performance_model = ElectricalLinkPerformanceModel::create(link_type,
+         frequency, link_length, flit_width, 1 /* fanout */);
+   UInt64 link_delay = link_performance_model->getDelay();
+   delete link_performance_model;
+
+   return router_delay + link_delay;
+}
+
 void
 NetworkModelEMeshHopCounter::initializeEventCounters()
 {
@@ -142,6 +188,67 @@ NetworkModelEMeshHopCounter::computeLatency(core_id_t sender, core_id_t receiver
    return (computeDistance(sender, receiver) * _hop_latency);
 }
 
+// Total queueing delay on the links of the XY path from 'sender' to 'receiver' for a packet
+// that leaves the sender router at 'time'. Computed at once when the packet is sent:
+// the delay at each link is looked up at the time the packet would reach it
+UInt64
+NetworkModelEMeshHopCounter::computeLinkContentionDelay(core_id_t sender, core_id_t receiver, PacketType packet_type,
+                                                        UInt64 time, UInt64 serialization_latency)
+{
+   SInt32 cx, cy, dx, dy;
+   computePosition(sender, cx, cy);
+   computePosition(receiver, dx, dy);
+
+   UInt64 link_contention_delay = 0;
+   while ((cx != dx) || (cy != dy))
+   {
+      // The output links of a router are modeled by the network model of its core
+      core_id_t core_id = cy * _mesh_width + cx;
+      Core* core = Sim()->getCoreManager()->getCoreFromID(core_id);
+      LOG_ASSERT_ERROR(core, "Link contention model needs Core(%i) in this process", core_id);
+      NetworkModelEMeshHopCounter* network_model = (NetworkModelEMeshHopCounter*)
+            core->getNetwork()->getFastNetworkModelFromPacketType(packet_type);
+
+      LinkDirection direction;
+      if (cx > dx)
+      {
+         direction = LEFT;
+         cx --;
+      }
+      else if (cx < dx)
+      {
+         direction = RIGHT;
+         cx ++;
+      }
+      else if (cy > dy)
+      {
+         direction = DOWN;
+         cy --;
+      }
+      else
+      {
+         direction = UP;
+         cy ++;
+      }
+
+      UInt64 queue_delay = network_model->computeLinkQueueDelay(direction, time, serialization_latency);
+      link_contention_delay += queue_delay;
+      time += (queue_delay + _hop_latency);
+   }
+
+   LOG_PRINT("Link Contention Delay(%llu): Sender(%i), Receiver(%i)", link_contention_delay, sender, receiver);
+   return link_contention_delay;
+}
+
+UInt64
+NetworkModelEMeshHopCounter::computeLinkQueueDelay(LinkDirection direction, UInt64 time, UInt64 serialization_latency)
+{
+   LOG_ASSERT_ERROR(_link_contention_model_enabled, "Link Contention Model not enabled on Core(%i)", _core_id);
+
+   ScopedLock sl(_link_contention_lock);
+   return _link_contention_model_list[direction]->computeQueueDelay(time, serialization_latency);
+}
+
 UInt32
 NetworkModelEMeshHopCounter::computeAction(const NetPacket& pkt)
 {
@@ -228,6 +335,13 @@ NetworkModelEMeshHopCounter::routePacket(const NetPacket &pkt,
             UInt64 sender_contention_delay = _sender_contention_model->computeQueueDelay(pkt.time, serialization_latency);
 
             latency += sender_contention_delay;
+
+            // Contention Delay on the links of the path
+            if (_link_contention_model_enabled)
+            {
+               latency += computeLinkContentionDelay(pkt.sender, pkt.receiver, pkt.type,
+                     pkt.time + sender_contention_delay, serialization_latency);
+            }
             next_module = RECEIVER_ROUTER;
          }
 
@@ -6,6 +6,8 @@
 #include "electrical_link_performance_model.h"
 #include "electrical_link_power_model.h"
 #include "queue_model_simple.h"
+#include "queue_model.h"
+#include "lock.h"
 
 class NetworkModelEMeshHopCounter : public NetworkModel
 {
@@ -32,6 +34,8 @@ public:
 
    void reset() {}
 
+   static UInt64 computeMinimumLatency();
+
 private:
    volatile float _frequency;
 
@@ -51,6 +55,20 @@ private:
    QueueModelSimple* _sender_contention_model;
    QueueModelSimple* _receiver_contention_model;
 
+   // Contention Models of the output links to the neighboring routers (indexed by LinkDirection)
+   // The senders of all the packets crossing a link update its model, hence the lock
+   enum LinkDirection
+   {
+      LEFT = 0,
+      RIGHT,
+      DOWN,
+      UP,
+      NUM_LINK_DIRECTIONS
+   };
+   bool _link_contention_model_enabled;
+   std::vector<QueueModel*> _link_contention_model_list;
+   Lock _link_contention_lock;
+
    // Event Counters
    UInt64 _total_switch_allocator_requests;
    UInt64 _total_crossbar_traversals;
@@ -60,6 +78,9 @@ private:
    void computePosition(core_id_t core, SInt32 &x, SInt32 &y);
    SInt32 computeDistance(core_id_t sender, core_id_t receiver);
    UInt64 computeLatency(core_id_t sender, core_id_t receiver);
+   UInt64 computeLinkContentionDelay(core_id_t sender, core_id_t receiver, PacketType packet_type,
+                                     UInt64 time, UInt64 serialization_latency);
+   UInt64 computeLinkQueueDelay(LinkDirection direction, UInt64 time, UInt64 serialization_latency);
 
    void initializeEventCounters();
 
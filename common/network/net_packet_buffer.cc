@@ -0,0 +1,41 @@
+#include "net_packet_buffer.h"
+#include "log.h"
+
+SlabAllocator NetPacketBuffer::_allocator(NetPacketBuffer::MAX_POOLED_BUFFER_SIZE);
+
+Byte*
+NetPacketBuffer::allocate(UInt32 length)
+{
+   size_t size = sizeof(Header) + length;
+   Header* header;
+   if (size > _allocator.getBlockSize())
+      header = (Header*) new Byte[size];
+   else
+      header = (Header*) _allocator.allocate();
+
+   header->_ref_count = 1;
+   header->_length = length;
+   return (Byte*) (header + 1);
+}
+
+void
+NetPacketBuffer::addReference(const void* data)
+{
+   Header* header = getHeader(data);
+   LOG_ASSERT_ERROR(header->_ref_count > 0, "Payload(%p) already freed", data);
+   __sync_fetch_and_add(&header->_ref_count, 1);
+}
+
+void
+NetPacketBuffer::release(const void* data)
+{
+   Header* header = getHeader(data);
+   LOG_ASSERT_ERROR(header->_ref_count > 0, "Payload(%p) already freed", data);
+   if (__sync_sub_and_fetch(&header->_ref_count, 1) > 0)
+      return;
+
+   if ((sizeof(Header) + header->_length) > _allocator.getBlockSize())
+      delete [] (Byte*) header;
+   else
+      _allocator.deallocate(header);
+}
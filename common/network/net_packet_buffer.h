@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "fixed_types.h"
+#include "slab_allocator.h"
+
+// Reference-counted payload of a raw NetPacket
+// The clones of a raw packet (one per hop, one per broadcast receiver) share
+// the payload instead of copying it; the last release() frees it.
+// Payloads are read-only once the first packet referring to them is sent.
+// Small payloads (e.g., shared memory messages with a cache line) come from a
+// SlabAllocator, larger ones from the heap.
+class NetPacketBuffer
+{
+   public:
+      // Returns a payload of 'length' bytes with a reference count of 1
+      static Byte* allocate(UInt32 length);
+      static void addReference(const void* data);
+      static void release(const void* data);
+
+   private:
+      class Header
+      {
+         public:
+            volatile UInt32 _ref_count;
+            UInt32 _length;
+      } __attribute__ ((aligned(16)));
+
+      // Largest payload (incl. Header) served from the slab
+      static const size_t MAX_POOLED_BUFFER_SIZE = 256;
+
+      static SlabAllocator _allocator;
+
+      static Header* getHeader(const void* data)
+      { return ((Header*) data) - 1; }
+};
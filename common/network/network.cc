@@ -3,18 +3,23 @@
 
 #include "core.h"
 #include "network.h"
+#include "net_packet_buffer.h"
 #include "memory_manager.h"
 #include "simulator.h"
 #include "core_manager.h"
 #include "clock_converter.h"
 #include "finite_buffer_network_model.h"
+#include "network_msg.h"
 #include "event.h"
 #include "log.h"
 
 using namespace std;
 
 Network::Network(Core *core)
-      : _core(core)
+      : _detailed_models_enabled(true)
+      , _sampling_period(0)
+      , _detailed_interval(0)
+      , _core(core)
       , _enabled(false)
 {
    LOG_ASSERT_ERROR(sizeof(g_type_to_static_network_map) / sizeof(EStaticNetwork) == NUM_PACKET_TYPES,
@@ -36,7 +41,35 @@ Network::Network(Core *core)
    {
       UInt32 network_model = NetworkModel::parseNetworkType(Config::getSingleton()->getNetworkType(i));
       _models[i] = NetworkModel::createModel(this, i, network_model);
+
+      _fast_models[i] = NULL;
+      if (Config::getSingleton()->isHybridNetwork(i))
+      {
+         UInt32 fast_network_model = NetworkModel::parseNetworkType(Config::getSingleton()->getFastNetworkType(i));
+         _fast_models[i] = NetworkModel::createModel(this, i, fast_network_model);
+         LOG_ASSERT_ERROR(_models[i]->isFiniteBuffer() && !_fast_models[i]->isFiniteBuffer(),
+                          "Hybrid Network(%i): needs a finite-buffer detailed model and a fast model that is not", i);
+         LOG_ASSERT_ERROR(_models[i]->getFrequency() == _fast_models[i]->getFrequency(),
+                          "Hybrid Network(%i): detailed model frequency(%f) != fast model frequency(%f)",
+                          i, _models[i]->getFrequency(), _fast_models[i]->getFrequency());
+      }
+   }
+
+   // Schedule of the hybrid networks
+   try
+   {
+      config::Config *cfg = Sim()->getCfg();
+      _detailed_models_enabled = cfg->getBool("network/hybrid/detailed_at_startup", true);
+      _sampling_period = (UInt64) cfg->getInt("network/hybrid/sampling_period", 0);
+      _detailed_interval = (UInt64) cfg->getInt("network/hybrid/detailed_interval", 0);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read the hybrid network parameters from the cfg file");
    }
+   LOG_ASSERT_ERROR((_sampling_period == 0) || (_detailed_interval <= _sampling_period),
+                    "Hybrid networks: detailed_interval(%llu) > sampling_period(%llu)",
+                    _detailed_interval, _sampling_period);
 
    LOG_PRINT("Initialized.");
 }
@@ -44,7 +77,11 @@ Network::Network(Core *core)
 Network::~Network()
 {
    for (SInt32 i = 0; i < NUM_STATIC_NETWORKS; i++)
+   {
       delete _models[i];
+      if (_fast_models[i])
+         delete _fast_models[i];
+   }
 
    delete [] _asyncRecvCallbackObjs;
    delete [] _asyncRecvCallbacks;
@@ -76,6 +113,8 @@ Network::enableModels()
    for (int i = 0; i < NUM_STATIC_NETWORKS; i++)
    {
       _models[i]->enable();
+      if (_fast_models[i])
+         _fast_models[i]->enable();
    }
 }
 
@@ -86,9 +125,37 @@ Network::disableModels()
    for (int i = 0; i < NUM_STATIC_NETWORKS; i++)
    {
       _models[i]->disable();
+      if (_fast_models[i])
+         _fast_models[i]->disable();
    }
 }
 
+// Hybrid Networks
+
+void
+Network::enableDetailedModels()
+{
+   LOG_PRINT("Enabling detailed network models");
+   _detailed_models_enabled = true;
+}
+
+void
+Network::disableDetailedModels()
+{
+   LOG_PRINT("Disabling detailed network models");
+   _detailed_models_enabled = false;
+}
+
+bool
+Network::isDetailedModelSelected(UInt64 time)
+{
+   if (!_detailed_models_enabled)
+      return false;
+   if (_sampling_period == 0)
+      return true;
+   return ((time % _sampling_period) < _detailed_interval);
+}
+
 // Output Summary
 
 void
@@ -99,6 +166,11 @@ Network::outputSummary(std::ostream &out) const
    {
       out << "  Network model " << i << ":\n";
       _models[i]->outputSummary(out);
+      if (_fast_models[i])
+      {
+         out << "  Network model " << i << " (fast):\n";
+         _fast_models[i]->outputSummary(out);
+      }
    }
 }
 
@@ -114,14 +186,17 @@ Network::processPacket(NetPacket* packet)
    LOG_ASSERT_ERROR(0 <= packet->type && packet->type < NUM_PACKET_TYPES,
          "Packet type: %d not between 0 and %d", packet->type, NUM_PACKET_TYPES);
 
-   NetworkModel* model = getNetworkModelFromPacketType(packet->type);
+   NetworkModel* model = getNetworkModel(packet);
 
    if (model->isFiniteBuffer())
    {
       FiniteBufferNetworkModel* finite_buffer_model = (FiniteBufferNetworkModel*) model;
 
-      list<NetPacket*> net_packet_list_to_send;
-      list<NetPacket*> net_packet_list_to_receive;
+      // Reuse the storage of the packet lists
+      vector<NetPacket*>& net_packet_list_to_send = _net_packet_list_to_send;
+      vector<NetPacket*>& net_packet_list_to_receive = _net_packet_list_to_receive;
+      net_packet_list_to_send.clear();
+      net_packet_list_to_receive.clear();
       finite_buffer_model->receiveNetPacket(packet, net_packet_list_to_send, net_packet_list_to_receive);
       
       // Send packets destined for other cores
@@ -156,7 +231,7 @@ Network::receivePacket(NetPacket* packet)
 {
    LOG_PRINT("receivePacket(%p) enter", packet);
 
-   NetworkModel* model = getNetworkModelFromPacketType(packet->type);
+   NetworkModel* model = getNetworkModel(packet);
    
    // I have accepted the packet - process the received packet
    model->processReceivedPacket(packet);
@@ -165,7 +240,7 @@ Network::receivePacket(NetPacket* packet)
    
    // Convert time (cycle count) from network frequency to core frequency
    packet->time = convertCycleCount(packet->time,
-         getNetworkModelFromPacketType(packet->type)->getFrequency(),
+         model->getFrequency(),
          _core->getPerformanceModel()->getFrequency());
 
    LOG_PRINT("After Converting Cycle Count: packet->time(%llu)", packet->time);
@@ -204,11 +279,11 @@ Network::receivePacket(NetPacket* packet)
 }
 
 void
-Network::receivePacketList(const list<NetPacket*>& net_packet_list_to_receive)
+Network::receivePacketList(const vector<NetPacket*>& net_packet_list_to_receive)
 {
    LOG_PRINT("receivePacketList() enter");
    
-   list<NetPacket*>::const_iterator it = net_packet_list_to_receive.begin();
+   vector<NetPacket*>::const_iterator it = net_packet_list_to_receive.begin();
    for ( ; it != net_packet_list_to_receive.end(); it ++)
    {
       NetPacket* packet_to_receive = *it;
@@ -222,15 +297,13 @@ Network::receivePacketList(const list<NetPacket*>& net_packet_list_to_receive)
 void
 Network::sendPacket(const NetPacket* packet, SInt32 next_hop)
 {
-   NetworkModel* network_model = getNetworkModelFromPacketType(packet->type);
+   NetworkModel* network_model = getNetworkModel(packet);
    LOG_PRINT("sendPacket(%p) enter", packet);
    LOG_PRINT("sendPacket(): time(%llu), type(%i), sender(%i), receiver(%i), network_name(%s)",
          packet->time, packet->type, packet->sender, next_hop,
          network_model->getNetworkName().c_str());
 
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << next_hop << packet;
-   EventNetwork* event = new EventNetwork(packet->time, event_args);
+   EventNetwork* event = new EventNetwork(packet->time, next_hop, const_cast<NetPacket*>(packet));
   
    assert(_enabled && network_model->isModeled(packet)); 
    Event::processInOrder(event, next_hop, EventQueue::ORDERED);
@@ -239,12 +312,12 @@ Network::sendPacket(const NetPacket* packet, SInt32 next_hop)
 }
 
 void
-Network::sendPacketList(const list<NetPacket*>& net_packet_list_to_send)
+Network::sendPacketList(const vector<NetPacket*>& net_packet_list_to_send)
 {
    LOG_PRINT("sendPacketList() enter");
    
    // Send the network packets
-   list<NetPacket*>::const_iterator it = net_packet_list_to_send.begin();
+   vector<NetPacket*>::const_iterator it = net_packet_list_to_send.begin();
    for ( ; it != net_packet_list_to_send.end(); it ++)
    {
       NetPacket* packet_to_send = *it;
@@ -260,7 +333,7 @@ Network::forwardPacket(const NetPacket* packet)
    LOG_ASSERT_ERROR((packet->type >= 0) && (packet->type < NUM_PACKET_TYPES),
          "packet->type(%u)", packet->type);
 
-   NetworkModel *model = getNetworkModelFromPacketType(packet->type);
+   NetworkModel *model = getNetworkModel(packet);
 
    vector<NetworkModel::Hop> hopVec;
    model->routePacket(*packet, hopVec);
@@ -290,6 +363,20 @@ Network::getNetworkModelFromPacketType(PacketType packet_type)
    return _models[g_type_to_static_network_map[packet_type]];
 }
 
+NetworkModel*
+Network::getFastNetworkModelFromPacketType(PacketType packet_type)
+{
+   EStaticNetwork network_id = g_type_to_static_network_map[packet_type];
+   return (_fast_models[network_id]) ? _fast_models[network_id] : _models[network_id];
+}
+
+NetworkModel*
+Network::getNetworkModel(const NetPacket* packet)
+{
+   return (packet->fast_model) ? getFastNetworkModelFromPacketType(packet->type)
+                               : getNetworkModelFromPacketType(packet->type);
+}
+
 PacketType
 Network::getPacketTypeFromNetworkId(SInt32 network_id)
 {
@@ -496,6 +583,15 @@ Network::netSend(NetPacket& packet, UInt64 start_time)
 
    // Get network model
    NetworkModel* network_model = getNetworkModelFromPacketType(packet.type);
+
+   // Hybrid networks: outside of the detailed intervals, the packet goes on the fast model.
+   // The packets already in flight on the other model are drained by that model
+   packet.fast_model = false;
+   if (_fast_models[g_type_to_static_network_map[packet.type]] && !isDetailedModelSelected(packet.time))
+   {
+      packet.fast_model = true;
+      network_model = getFastNetworkModelFromPacketType(packet.type);
+   }
    
    // Update Packet Send Counters
    network_model->updatePacketSendStatistics(&packet);
@@ -510,7 +606,7 @@ Network::netSend(NetPacket& packet, UInt64 start_time)
       FiniteBufferNetworkModel* finite_buffer_network_model = (FiniteBufferNetworkModel*) network_model;
       
       // Divide Packet into flits
-      list<NetPacket*> net_packet_list_to_send;
+      vector<NetPacket*> net_packet_list_to_send;
       finite_buffer_network_model->sendNetPacket(packet_to_send, net_packet_list_to_send);
      
       // Send out raw packets
@@ -565,6 +661,8 @@ Network::netBroadcast(PacketType type, const void *buf, UInt32 len)
 
 // -- NetPacket
 
+SlabAllocator NetPacket::_allocator(sizeof(NetPacket));
+
 NetPacket::NetPacket()
    : start_time(0)
    , time(0)
@@ -576,6 +674,8 @@ NetPacket::NetPacket()
    , is_raw(true)
    , sequence_num(0)
    , specific(0)
+   , shared_data(false)
+   , fast_model(false)
 {
 }
 
@@ -592,6 +692,8 @@ NetPacket::NetPacket(UInt64 t, PacketType ty,
    , is_raw(raw)
    , sequence_num(seq_num)
    , specific(0)
+   , shared_data(false)
+   , fast_model(false)
 {
 }
 
@@ -609,6 +711,8 @@ NetPacket::NetPacket(UInt64 t, PacketType ty,
    , is_raw(raw)
    , sequence_num(seq_num)
    , specific(0)
+   , shared_data(false)
+   , fast_model(false)
 {
 }
 
@@ -618,9 +722,20 @@ NetPacket::NetPacket(Byte *buffer)
    memcpy(this, buffer, sizeof(*this));
 
    // LOG_ASSERT_ERROR(length > 0, "type(%u), sender(%i), receiver(%i), length(%u)", type, sender, receiver, length);
+   shared_data = false;
    if (length > 0)
    {
-      Byte* data_buffer = new Byte[length];
+      Byte* data_buffer;
+      if (is_raw)
+      {
+         data_buffer = NetPacketBuffer::allocate(length);
+         shared_data = true;
+      }
+      else
+      {
+         // Modeling packets carry a NetworkMsg
+         data_buffer = (Byte*) NetworkMsg::operator new(length);
+      }
       memcpy(data_buffer, buffer + sizeof(*this), length);
       data = data_buffer;
    }
@@ -657,8 +772,24 @@ NetPacket* NetPacket::clone() const
    NetPacket* cloned_net_packet = new NetPacket(*this);
    if (length > 0)
    {
-      cloned_net_packet->data = new Byte[length];
-      memcpy((void*) cloned_net_packet->data, data, length);
+      if (shared_data)
+      {
+         // Only the header is copied
+         NetPacketBuffer::addReference(data);
+      }
+      else if (is_raw)
+      {
+         // The payload is copied once (when the packet is sent), the clones of
+         // the cloned packet share it
+         cloned_net_packet->data = NetPacketBuffer::allocate(length);
+         cloned_net_packet->shared_data = true;
+         memcpy((void*) cloned_net_packet->data, data, length);
+      }
+      else
+      {
+         // Modeling packets: every clone carries its own (mutable) flit
+         cloned_net_packet->data = ((NetworkMsg*) data)->clone();
+      }
    }
 
    return cloned_net_packet;
@@ -668,10 +799,30 @@ void NetPacket::release()
 {
    assert((data == NULL) == (length == 0));
    if (length > 0)
-      delete [] (Byte*) data;
+   {
+      if (shared_data)
+         NetPacketBuffer::release(data);
+      else if (is_raw)
+         delete [] (Byte*) data;
+      else
+         delete (NetworkMsg*) data;
+   }
    delete this;
 }
 
+void*
+NetPacket::operator new(size_t size)
+{
+   assert(size <= _allocator.getBlockSize());
+   return _allocator.allocate();
+}
+
+void
+NetPacket::operator delete(void* ptr, size_t size)
+{
+   _allocator.deallocate(ptr);
+}
+
 // NetMatch
 NetMatch::NetMatch()
 {}
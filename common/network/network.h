@@ -9,6 +9,7 @@ using namespace std;
 #include "packet_type.h"
 #include "fixed_types.h"
 #include "cond.h"
+#include "slab_allocator.h"
 #include "network_model.h"
 
 class Core;
@@ -36,6 +37,13 @@ public:
 
    // This field may be used by specific network models in whatever way they please
    UInt32 specific;
+
+   // 'data' is a NetPacketBuffer shared with the clones of this packet
+   // (set on the raw packets created by clone())
+   bool shared_data;
+
+   // Sent on the fast model of a hybrid network (see Network::netSend())
+   bool fast_model;
    
    // Constructors
    NetPacket();
@@ -48,12 +56,19 @@ public:
              UInt32 length, const void *data,
              bool is_raw = true, UInt32 sequence_num = 0);
 
+   // Heap-allocated NetPackets come from a per-thread slab, not the general heap
+   static void* operator new(size_t size);
+   static void operator delete(void* ptr, size_t size);
+
    UInt32 bufferSize() const;
    Byte* makeBuffer() const;
    NetPacket* clone() const;
    void release();
 
    static const SInt32 BROADCAST = 0xDEADBABE;
+
+private:
+   static SlabAllocator _allocator;
 };
 
 typedef list<NetPacket*> NetQueue;
@@ -114,14 +129,31 @@ public:
    void enableModels();
    void disableModels();
 
+   // -- Hybrid Networks -- //
+
+   // Switch the hybrid networks between their detailed and fast models
+   // (the packets in flight finish on the model they were sent on)
+   void enableDetailedModels();
+   void disableDetailedModels();
+
    // -- Network Models -- //
 
    NetworkModel* getNetworkModelFromPacketType(PacketType packet_type);
+   // Fast model of a hybrid network (the only model of the other networks)
+   NetworkModel* getFastNetworkModelFromPacketType(PacketType packet_type);
    PacketType getPacketTypeFromNetworkId(SInt32 network_id);
 
 
 private:
    NetworkModel * _models[NUM_STATIC_NETWORKS];
+   // NULL unless the network is hybrid
+   NetworkModel * _fast_models[NUM_STATIC_NETWORKS];
+
+   // Hybrid networks: the packets are sent on the detailed model if it is enabled and
+   // (time % _sampling_period) < _detailed_interval, on the fast model otherwise
+   bool _detailed_models_enabled;
+   UInt64 _sampling_period;
+   UInt64 _detailed_interval;
 
    // For Asynchronous Recvs'
    NetRecvCallback *_asyncRecvCallbacks;
@@ -137,14 +169,23 @@ private:
 
    NetQueue _netQueue;
 
+   // Packets sent/received by the finite-buffer models in processPacket()
+   // (storage reused across calls)
+   vector<NetPacket*> _net_packet_list_to_send;
+   vector<NetPacket*> _net_packet_list_to_receive;
+
    bool _enabled;
 
+   // Model that the packet was sent on
+   NetworkModel* getNetworkModel(const NetPacket* packet);
+   bool isDetailedModelSelected(UInt64 time);
+
    // Processing Packets
    SInt32 forwardPacket(const NetPacket* packet);
    void sendPacket(const NetPacket* packet, SInt32 receiver);
-   void sendPacketList(const list<NetPacket*>& net_packet_list_to_send);
+   void sendPacketList(const vector<NetPacket*>& net_packet_list_to_send);
    void receivePacket(NetPacket* packet);
-   void receivePacketList(const list<NetPacket*>& net_packet_list_to_receive);
+   void receivePacketList(const vector<NetPacket*>& net_packet_list_to_receive);
 
    // Sync NetRecv
    void processSyncRecv();
@@ -161,6 +161,36 @@ NetworkModel::computeMemoryControllerPositions(UInt32 network_type, SInt32 num_m
    }
 }
 
+UInt64
+NetworkModel::computeMinimumLatency(UInt32 network_type)
+{
+   switch (network_type)
+   {
+      case NETWORK_MAGIC:
+         // A latency of '1' (see NetworkModelMagic::routePacket())
+         return 1;
+
+      case NETWORK_EMESH_HOP_COUNTER:
+         return NetworkModelEMeshHopCounter::computeMinimumLatency();
+
+      case FINITE_BUFFER_NETWORK_EMESH:
+         return FiniteBufferNetworkModelEMesh::computeMinimumLatency();
+
+      case FINITE_BUFFER_NETWORK_ATAC:
+         return FiniteBufferNetworkModelAtac::computeMinimumLatency();
+
+      case FINITE_BUFFER_NETWORK_CLOS:
+      case FINITE_BUFFER_NETWORK_FLIP_ATAC:
+         // The NetPacket injector on a core feeds an ingress router that may be
+         // located on another core with zero delay, so no lookahead is available
+         return 1;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized network type(%u)", network_type);
+         return 1;
+   }
+}
+
 core_id_t
 NetworkModel::getRequester(const NetPacket* packet)
 {
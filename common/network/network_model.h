@@ -93,6 +93,8 @@ public:
 
    static std::pair<bool,SInt32> computeCoreCountConstraints(UInt32 network_type, SInt32 core_count);
    static std::pair<bool, std::vector<core_id_t> > computeMemoryControllerPositions(UInt32 network_type, SInt32 num_memory_controllers);
+   // Minimum latency (in network clock cycles) of any message exchanged between two different cores
+   static UInt64 computeMinimumLatency(UInt32 network_type);
 
 protected:
    // If the network model is enabled
@@ -116,6 +118,8 @@ protected:
 
    // Update Statistics on Packet Receive
    void updatePacketReceiveStatistics(const NetPacket* pkt, SInt32 zero_load_delay);
+   // Reset the Packet Send/Receive Statistics
+   void resetPerformanceCounters() { initializePerformanceCounters(); }
 
 private:
    Network *_network;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <assert.h>
+
+#include "fixed_types.h"
+#include "instruction.h"
+
+// One dynamic instruction as sent from the app thread to the sim thread
+// Fixed size so that it can be copied into the per-core instruction queue
+// without any heap allocation. Memory accesses are in the order
+// the instrumentation reports them (reads first, then the write).
+class InstructionRecord
+{
+public:
+   // At most 2 memory reads and 1 memory write per instruction
+   static const UInt32 MAX_MEMORY_ACCESSES = 3;
+
+   InstructionRecord()
+      : _instruction(NULL), _atomic_memory_update(false), _num_memory_accesses(0) {}
+   InstructionRecord(Instruction* instruction, bool atomic_memory_update)
+      : _instruction(instruction), _atomic_memory_update(atomic_memory_update), _num_memory_accesses(0) {}
+
+   void addMemoryAccess(IntPtr address, UInt32 size)
+   {
+      assert(_num_memory_accesses < MAX_MEMORY_ACCESSES);
+      _address[_num_memory_accesses] = address;
+      _size[_num_memory_accesses] = size;
+      _num_memory_accesses ++;
+   }
+
+   Instruction* _instruction; // Created at instrumentation time (SHOULD NOT BE DELETED !!)
+   bool _atomic_memory_update;
+   UInt32 _num_memory_accesses;
+   IntPtr _address[MAX_MEMORY_ACCESSES];
+   UInt32 _size[MAX_MEMORY_ACCESSES];
+};
@@ -33,6 +33,7 @@ PerformanceModel::PerformanceModel(Core *core, float frequency)
    _total_instructions_issued = 0;
 
    _max_outstanding_instructions = (UInt64) Sim()->getCfg()->getInt("general/max_outstanding_instructions", 1);
+   _l1_hit_fast_path_enabled = Sim()->getCfg()->getBool("general/enable_l1_hit_fast_path", true);
 }
 
 PerformanceModel::~PerformanceModel()
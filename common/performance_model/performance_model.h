@@ -5,6 +5,7 @@ using std::vector;
 using std::pair;
 #include "packetize.h"
 #include "instruction.h"
+#include "instruction_record.h"
 
 class Core;
 
@@ -18,8 +19,9 @@ public:
 
    static PerformanceModel* create(Core* core);
    
-   virtual bool handleInstruction(Instruction* ins, bool atomic_memory_update,
-         MemoryAccessList* memory_access_list) = 0;
+   // Returns true if the instruction completed right away (the caller then resumes the
+   // thread); false if the model resumes the thread with an event once it completes
+   virtual bool handleInstruction(const InstructionRecord& instruction_record) = 0;
    virtual void handleCompletedMemoryAccess(UInt64 time, UInt32 memory_access_id) = 0;
    virtual void flushPipeline() = 0;
 
@@ -39,6 +41,8 @@ public:
    void incrTotalInstructionsIssued() { _total_instructions_issued ++; }
    UInt64 getTotalInstructionsIssued() { return _total_instructions_issued; }
    UInt64 getMaxOutstandingInstructions() { return _max_outstanding_instructions; }
+   // Model L1 hits (and the instructions that follow them) without events when it is safe
+   bool isL1HitFastPathEnabled() { return _l1_hit_fast_path_enabled; }
 
    void enable() { _enabled = true; }
    void disable() { _enabled = false; }
@@ -51,6 +55,7 @@ protected:
    UInt64 _cycle_count;
    
    UInt64 _max_outstanding_instructions;
+   bool _l1_hit_fast_path_enabled;
 
    // Performance Counters
    UInt64 _total_instructions_executed;
@@ -1,5 +1,6 @@
 #include <iostream>
 #include "simulator.h"
+#include "event_manager.h"
 #include "thread_interface.h"
 #include "simple_performance_model.h"
 #include "core.h"
@@ -22,19 +23,17 @@ SimplePerformanceModel::outputSummary(ostream& out)
 }
 
 bool
-SimplePerformanceModel::handleInstruction(Instruction* instruction,
-                                          bool atomic_memory_update,
-                                          MemoryAccessList* memory_access_list)
+SimplePerformanceModel::handleInstruction(const InstructionRecord& instruction_record)
 {
-   LOG_PRINT("handleInstruction(Instruction[%p], atomic_memory_update[%s], memory_access_list[%u])",
-         instruction, atomic_memory_update ? "YES" : "NO", memory_access_list->size());
+   LOG_PRINT("handleInstruction(Instruction[%p], atomic_memory_update[%s], num_memory_accesses[%u])",
+         instruction_record._instruction, instruction_record._atomic_memory_update ? "YES" : "NO",
+         instruction_record._num_memory_accesses);
 
    LOG_ASSERT_ERROR(isEnabled(), "Not Enabled Currently");
 
-   _curr_instruction_status.update(_cycle_count, instruction, atomic_memory_update, memory_access_list);
+   _curr_instruction_status.update(_cycle_count, instruction_record);
    
-   bool cont = issueNextMemoryRequest();
-   return cont;
+   return issueNextMemoryRequest();
 }
 
 void
@@ -51,22 +50,27 @@ SimplePerformanceModel::handleCompletedMemoryAccess(UInt64 time, UInt32 memory_a
    }
 
    // Issue memory request to next address
-   issueNextMemoryRequest();
+   if (issueNextMemoryRequest())
+   {
+      EventResumeThread* event = new EventResumeThread(_cycle_count, getCore()->getId());
+      Event::processInOrder(event, getCore()->getId(), EventQueue::ORDERED);
+   }
 }
 
 bool
 SimplePerformanceModel::issueNextMemoryRequest()
 {
-   UInt32 operand_num = _curr_instruction_status._curr_memory_operand_num;
-   if (operand_num == _curr_instruction_status._total_memory_operands)
+   while (true)
    {
-      completeInstruction();
-      return true;
-   }
-   else
-   {
-      IntPtr address = (*_curr_instruction_status._memory_access_list)[operand_num].first;
-      UInt32 size = (*_curr_instruction_status._memory_access_list)[operand_num].second;
+      UInt32 operand_num = _curr_instruction_status._curr_memory_operand_num;
+      if (operand_num == _curr_instruction_status._total_memory_operands)
+      {
+         completeInstruction();
+         return true;
+      }
+
+      IntPtr address = _curr_instruction_status._instruction_record._address[operand_num];
+      UInt32 size = _curr_instruction_status._instruction_record._size[operand_num];
 
       Core::lock_signal_t lock_signal;
       Core::mem_op_t mem_op_type;
@@ -83,6 +87,21 @@ SimplePerformanceModel::issueNextMemoryRequest()
          mem_op_type = Core::WRITE;
       }
 
+      // An L1 hit is modeled right away (no events) if no other event of this core
+      // can come in between. The first access starts at the time of the event that
+      // is being processed (the instruction's start time)
+      UInt64 time = _curr_instruction_status._cycle_count;
+      UInt64 completion_time;
+      if ( isL1HitFastPathEnabled() && (size <= SCRATCHPAD_SIZE) &&
+           ((operand_num == 0) || Sim()->getEventManager()->isSafeToSkipTo(getCore()->getId(), time)) &&
+           getCore()->tryFastMemoryAccess(time, MemComponent::L1_DCACHE, lock_signal, mem_op_type,
+                                          address, _data_buffer, size, true /* modeled */, completion_time) )
+      {
+         _curr_instruction_status._cycle_count = completion_time;
+         _curr_instruction_status._curr_memory_operand_num ++;
+         continue;
+      }
+
       Byte* data_buffer;
       assert(size > 0);
       if (size <= SCRATCHPAD_SIZE)
@@ -96,15 +115,12 @@ SimplePerformanceModel::issueNextMemoryRequest()
          data_buffer = _large_data_buffer;
       }
 
-      UnstructuredBuffer* event_args = new UnstructuredBuffer();
-      (*event_args) << getCore()
-                    << _last_memory_access_id ++
-                    << MemComponent::L1_DCACHE << lock_signal << mem_op_type
-                    << address << data_buffer << size
-                    << true /* modeled */;
-      LOG_PRINT("Event args size(%u)", event_args->size());
       EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(_curr_instruction_status._cycle_count,
-                                                                       event_args);
+                                                                       getCore(),
+                                                                       _last_memory_access_id ++,
+                                                                       MemComponent::L1_DCACHE, lock_signal, mem_op_type,
+                                                                       address, data_buffer, size,
+                                                                       true /* modeled */);
       Event::processInOrder(event, getCore()->getId(), EventQueue::ORDERED);
 
       return false;
@@ -118,7 +134,6 @@ SimplePerformanceModel::completeInstruction()
    _cycle_count = _curr_instruction_status._cycle_count;
 
    _curr_instruction_status._instruction = (Instruction*) NULL;
-   delete _curr_instruction_status._memory_access_list;
 
    // Update Performance Counters
    _total_instructions_executed ++;
@@ -126,18 +141,12 @@ SimplePerformanceModel::completeInstruction()
    {
       Sim()->getThreadInterface(getCore()->getId())->sendSimInsReply(_max_outstanding_instructions);
    }
-
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << getCore()->getId();
-   EventResumeThread* event = new EventResumeThread(_cycle_count, event_args);
-   Event::processInOrder(event, getCore()->getId(), EventQueue::ORDERED);
 }
 
 SimplePerformanceModel::InstructionStatus::InstructionStatus()
    : _cycle_count(0)
    , _instruction(NULL)
    , _atomic_memory_update(false)
-   , _memory_access_list(NULL)
    , _curr_memory_operand_num(0)
    , _total_read_memory_operands(0)
    , _total_write_memory_operands(0)
@@ -149,17 +158,15 @@ SimplePerformanceModel::InstructionStatus::~InstructionStatus()
 
 void
 SimplePerformanceModel::InstructionStatus::update(UInt64 cycle_count,
-                                                  Instruction* instruction,
-                                                  bool atomic_memory_update,
-                                                  MemoryAccessList* memory_access_list)
+                                                  const InstructionRecord& instruction_record)
 {
    _cycle_count = cycle_count;
-   _instruction = instruction;
-   _atomic_memory_update = atomic_memory_update;
-   _memory_access_list = memory_access_list;
+   _instruction = instruction_record._instruction;
+   _atomic_memory_update = instruction_record._atomic_memory_update;
+   _instruction_record = instruction_record;
    _curr_memory_operand_num = 0;
-   _total_read_memory_operands = instruction->getNumOperands(Operand::MEMORY, Operand::READ);
-   _total_write_memory_operands = instruction->getNumOperands(Operand::MEMORY, Operand::WRITE);
-   _total_memory_operands = memory_access_list->size();
+   _total_read_memory_operands = _instruction->getNumOperands(Operand::MEMORY, Operand::READ);
+   _total_write_memory_operands = _instruction->getNumOperands(Operand::MEMORY, Operand::WRITE);
+   _total_memory_operands = instruction_record._num_memory_accesses;
    assert(_total_memory_operands == (_total_read_memory_operands + _total_write_memory_operands));
 }
@@ -9,9 +9,7 @@ public:
    SimplePerformanceModel(Core* core, float frequency);
    ~SimplePerformanceModel();
 
-   bool handleInstruction(Instruction* ins,
-                          bool atomic_memory_update,
-                          MemoryAccessList* memory_access_list);
+   bool handleInstruction(const InstructionRecord& instruction_record);
    void handleCompletedMemoryAccess(UInt64 time, UInt32 memory_access_id);
    void flushPipeline() {}
 
@@ -24,12 +22,12 @@ private:
       InstructionStatus();
       ~InstructionStatus();
       
-      void update(UInt64 time, Instruction* instruction, bool atomic_memory_update, MemoryAccessList* memory_access_list);
+      void update(UInt64 time, const InstructionRecord& instruction_record);
 
       UInt64 _cycle_count;
       Instruction* _instruction; // Created at instrumentation time (SHOULD NOT BE DELETED !!)
       bool _atomic_memory_update;
-      MemoryAccessList* _memory_access_list; // Created at analysis time
+      InstructionRecord _instruction_record; // Copied out of the instruction queue
       UInt32 _curr_memory_operand_num;
       UInt32 _total_read_memory_operands;
       UInt32 _total_write_memory_operands;
@@ -42,6 +40,7 @@ private:
    Byte _data_buffer[SCRATCHPAD_SIZE]; // Only 1 outstanding memory request allowed in the simple core model
    Byte* _large_data_buffer;
 
+   // Returns true if the instruction completed without waiting for an event
    bool issueNextMemoryRequest();
    void completeInstruction();
 };
@@ -5,6 +5,7 @@
 #include "syscall_manager.h"
 #include "thread_manager.h"
 #include "app_request.h"
+#include "event.h"
 
 bool
 AppRequest::process(Core* req_core)
@@ -26,8 +27,19 @@ AppRequest::process(Core* req_core)
          PerformanceModel::MemoryAccessList* memory_access_list;
          (*_request) >> ins >> atomic_memory_update >> memory_access_list;
 
+         InstructionRecord instruction_record(ins, atomic_memory_update);
+         for (UInt32 i = 0; i < memory_access_list->size(); i++)
+            instruction_record.addMemoryAccess((*memory_access_list)[i].first, (*memory_access_list)[i].second);
+         delete memory_access_list;
+
          // FIXME: Set 'cont' here
-         req_core->getPerformanceModel()->handleInstruction(ins, atomic_memory_update, memory_access_list);
+         PerformanceModel* performance_model = req_core->getPerformanceModel();
+         if (performance_model->handleInstruction(instruction_record))
+         {
+            // Completed right away, so the performance model did not create an event to resume the thread
+            EventResumeThread* event = new EventResumeThread(performance_model->getCycleCount(), req_core->getId());
+            Event::processInOrder(event, req_core->getId(), EventQueue::ORDERED);
+         }
          break;
       }
 
@@ -8,9 +8,10 @@
 #include "performance_model.h"
 
 std::map<UInt32,Event::Handler> Event::_handler_map;
+SlabAllocator Event::_allocator(Event::MAX_POOLED_EVENT_SIZE);
 
 Event::Event(Type type, UInt64 time, UnstructuredBuffer* event_args)
-   : _type(type), _time(time), _event_args(event_args)
+   : _type(type), _time(time), _event_args(event_args), _core_id(INVALID_CORE_ID)
 {}
 
 Event::~Event()
@@ -19,6 +20,23 @@ Event::~Event()
       delete _event_args;
 }
 
+void*
+Event::operator new(size_t size)
+{
+   if (size > _allocator.getBlockSize())
+      return ::operator new(size);
+   return _allocator.allocate();
+}
+
+void
+Event::operator delete(void* ptr, size_t size)
+{
+   if (size > _allocator.getBlockSize())
+      ::operator delete(ptr);
+   else
+      _allocator.deallocate(ptr);
+}
+
 void
 Event::processInOrder(Event* event, core_id_t recv_core_id, EventQueue::Type event_queue_type)
 {
@@ -74,112 +92,56 @@ Event::unregisterHandler(UInt32 type)
 void
 EventNetwork::__process()
 {
-   core_id_t next_hop;
-   NetPacket* net_packet;
-
-   (*_event_args) >> next_hop >> net_packet;
-
-   Core* core = Sim()->getCoreManager()->getCoreFromID(next_hop);
+   Core* core = Sim()->getCoreManager()->getCoreFromID(_next_hop);
    assert(core);
    Network* network = core->getNetwork();
-   network->processPacket(net_packet);
+   network->processPacket(_packet);
 }
 
 void
 EventInitiateMemoryAccess::__process()
 {
-   Core* core;
-   UInt32 memory_access_id;
-   MemComponent::component_t mem_component;
-   Core::lock_signal_t lock_signal;
-   Core::mem_op_t mem_op_type;
-   IntPtr address;
-   Byte* data_buffer;
-   UInt32 bytes;
-   bool modeled;
-
-   (*_event_args) >> core >> memory_access_id >> mem_component >> lock_signal >> mem_op_type
-                  >> address >> data_buffer >> bytes >> modeled;
-   
-   core->initiateMemoryAccess(_time, memory_access_id, mem_component, lock_signal, mem_op_type,
-         address, data_buffer, bytes, modeled);
+   _core->initiateMemoryAccess(_time, _memory_access_id, _mem_component, _lock_signal, _mem_op_type,
+         _address, _data_buffer, _bytes, _modeled);
 }
 
 void
 EventCompleteMemoryAccess::__process()
 {
-   Core* core;
-   UInt32 memory_access_id;
-
-   (*_event_args) >> core >> memory_access_id;
-
-   PerformanceModel* performance_model = core->getPerformanceModel();
+   PerformanceModel* performance_model = _core->getPerformanceModel();
    assert(performance_model);
 
-   performance_model->handleCompletedMemoryAccess(_time, memory_access_id);
+   performance_model->handleCompletedMemoryAccess(_time, _memory_access_id);
 }
 
 void
 EventInitiateCacheAccess::__process()
 {
-   MemoryManager* memory_manager;
-   MemComponent::component_t mem_component;
-   UInt32 memory_access_id;
-   Core::lock_signal_t lock_signal;
-   Core::mem_op_t mem_op_type;
-   IntPtr ca_address;
-   UInt32 offset;
-   Byte* data_buffer;
-   UInt32 bytes;
-   bool modeled;
-
-   (*_event_args) >> memory_manager >> mem_component >> memory_access_id
-                  >> lock_signal >> mem_op_type >> ca_address >> offset
-                  >> data_buffer >> bytes >> modeled;
-
-   memory_manager->initiateCacheAccess(_time, mem_component,
-         memory_access_id, lock_signal, mem_op_type,
-         ca_address, offset, data_buffer, bytes, modeled);
-   
+   _memory_manager->initiateCacheAccess(_time, _mem_component,
+         _memory_access_id, _lock_signal, _mem_op_type,
+         _ca_address, _offset, _data_buffer, _bytes, _modeled);
 }
 
 void
 EventReInitiateCacheAccess::__process()
 {
-   MemoryManager* memory_manager;
-   MemComponent::component_t mem_component;
-   MissStatus* miss_status;
-
-   (*_event_args) >> memory_manager >> mem_component >> miss_status;
-
-   memory_manager->reInitiateCacheAccess(_time, mem_component, miss_status);
+   _memory_manager->reInitiateCacheAccess(_time, _mem_component, _miss_status);
 }
 
 void
 EventCompleteCacheAccess::__process()
 {
-   Core* core;
-   UInt32 memory_access_id;
-
-   (*_event_args) >> core >> memory_access_id;
-
-   core->completeCacheAccess(_time, memory_access_id);
+   _core->completeCacheAccess(_time, _memory_access_id);
 }
 
 void
 EventStartThread::__process()
 {
-   core_id_t core_id;
-   (*_event_args) >> core_id;
-
-   Sim()->getThreadInterface(core_id)->iterate();
+   Sim()->getThreadInterface(_core_id)->iterate();
 }
 
 void
 EventResumeThread::__process()
 {
-   core_id_t core_id;
-   (*_event_args) >> core_id;
-
-   Sim()->getThreadInterface(core_id)->iterate();
+   Sim()->getThreadInterface(_core_id)->iterate();
 }
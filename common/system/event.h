@@ -5,10 +5,18 @@
 
 #include "fixed_types.h"
 #include "packetize.h"
+#include "slab_allocator.h"
+#include "mpsc_queue.h"
 #include "event_queue.h"
+#include "core.h"
+#include "mem_component.h"
 #include "log.h"
 
-class Event
+class MemoryManager;
+class MissStatus;
+
+// Events are linked into the (lock-free) UnorderedEventQueue through MPSCQueueNode
+class Event : public MPSCQueueNode
 {
 public:
    typedef void(*Handler)(Event*);
@@ -37,6 +45,10 @@ public:
    Event(Type type, UInt64 time, UnstructuredBuffer* event_args = NULL);
    virtual ~Event();
 
+   // Events are allocated from a per-thread slab, not the general heap
+   static void* operator new(size_t size);
+   static void operator delete(void* ptr, size_t size);
+
    static void processInOrder(Event* event, core_id_t recv_core_id, EventQueue::Type event_queue_type);
    static void registerHandler(UInt32 type, Handler handler);
    static void unregisterHandler(UInt32 type);
@@ -46,94 +58,181 @@ public:
    Type getType() { return _type; }
    UInt64 getTime() { return _time; }
    UnstructuredBuffer* getArgs() { return _event_args; }
+   // Core on whose behalf the event is processed (set when it is queued)
+   core_id_t getCoreId() { return _core_id; }
+   void setCoreId(core_id_t core_id) { _core_id = core_id; }
 
 protected:
    Type _type;
    UInt64 _time;
    UnstructuredBuffer* _event_args;
+   core_id_t _core_id;
 
 private:
+   // Largest event (incl. TypedEvent<Args>) served from the slab
+   static const size_t MAX_POOLED_EVENT_SIZE = 128;
+
    static std::map<UInt32,Handler> _handler_map;
+   static SlabAllocator _allocator;
    virtual void __process() {}
 };
 
+// Event with a typed argument struct, for types registered through
+// Event::registerHandler(). The handler gets the arguments back with
+// TypedEvent<Args>::getTypedArgs(event)
+template <class Args>
+class TypedEvent : public Event
+{
+public:
+   TypedEvent(UInt32 type, UInt64 time, const Args& args)
+      : Event((Type) type, time), _args(args) {}
+   ~TypedEvent() {}
+
+   static const Args& getTypedArgs(Event* event)
+   { return ((TypedEvent<Args>*) event)->_args; }
+
+private:
+   Args _args;
+};
+
 class EventNetwork : public Event
 {
 public:
-   EventNetwork(UInt64 time, UnstructuredBuffer* event_args)
-      : Event(NETWORK, time, event_args) {}
+   EventNetwork(UInt64 time, core_id_t next_hop, NetPacket* packet)
+      : Event(NETWORK, time)
+      , _next_hop(next_hop), _packet(packet) {}
    ~EventNetwork() {}
 private:
+   core_id_t _next_hop;
+   NetPacket* _packet;
+
    void __process();
 };
 
 class EventInitiateMemoryAccess : public Event
 {
 public:
-   EventInitiateMemoryAccess(UInt64 time, UnstructuredBuffer* event_args)                       
-      : Event(INITIATE_MEMORY_ACCESS, time, event_args) {}
+   EventInitiateMemoryAccess(UInt64 time, Core* core, UInt32 memory_access_id,
+                             MemComponent::component_t mem_component,
+                             Core::lock_signal_t lock_signal, Core::mem_op_t mem_op_type,
+                             IntPtr address, Byte* data_buffer, UInt32 bytes, bool modeled)
+      : Event(INITIATE_MEMORY_ACCESS, time)
+      , _core(core), _memory_access_id(memory_access_id), _mem_component(mem_component)
+      , _lock_signal(lock_signal), _mem_op_type(mem_op_type)
+      , _address(address), _data_buffer(data_buffer), _bytes(bytes), _modeled(modeled) {}
    ~EventInitiateMemoryAccess() {}
 private:
+   Core* _core;
+   UInt32 _memory_access_id;
+   MemComponent::component_t _mem_component;
+   Core::lock_signal_t _lock_signal;
+   Core::mem_op_t _mem_op_type;
+   IntPtr _address;
+   Byte* _data_buffer;
+   UInt32 _bytes;
+   bool _modeled;
+
    void __process();
 };
 
 class EventCompleteMemoryAccess : public Event
 {
 public:
-   EventCompleteMemoryAccess(UInt64 time, UnstructuredBuffer* event_args)
-      : Event(COMPLETE_MEMORY_ACCESS, time, event_args) {}
+   EventCompleteMemoryAccess(UInt64 time, Core* core, UInt32 memory_access_id)
+      : Event(COMPLETE_MEMORY_ACCESS, time)
+      , _core(core), _memory_access_id(memory_access_id) {}
    ~EventCompleteMemoryAccess() {}
 private:
+   Core* _core;
+   UInt32 _memory_access_id;
+
    void __process();
 };
 
 class EventInitiateCacheAccess : public Event
 {
 public:
-   EventInitiateCacheAccess(UInt64 time, UnstructuredBuffer* event_args)
-      : Event(INITIATE_CACHE_ACCESS, time, event_args) {}
+   EventInitiateCacheAccess(UInt64 time, MemoryManager* memory_manager,
+                            MemComponent::component_t mem_component, UInt32 memory_access_id,
+                            Core::lock_signal_t lock_signal, Core::mem_op_t mem_op_type,
+                            IntPtr ca_address, UInt32 offset,
+                            Byte* data_buffer, UInt32 bytes, bool modeled)
+      : Event(INITIATE_CACHE_ACCESS, time)
+      , _memory_manager(memory_manager), _mem_component(mem_component)
+      , _memory_access_id(memory_access_id)
+      , _lock_signal(lock_signal), _mem_op_type(mem_op_type)
+      , _ca_address(ca_address), _offset(offset)
+      , _data_buffer(data_buffer), _bytes(bytes), _modeled(modeled) {}
    ~EventInitiateCacheAccess() {}
 private:
+   MemoryManager* _memory_manager;
+   MemComponent::component_t _mem_component;
+   UInt32 _memory_access_id;
+   Core::lock_signal_t _lock_signal;
+   Core::mem_op_t _mem_op_type;
+   IntPtr _ca_address;
+   UInt32 _offset;
+   Byte* _data_buffer;
+   UInt32 _bytes;
+   bool _modeled;
+
    void __process();
 };
 
 class EventReInitiateCacheAccess : public Event
 {
 public:
-   EventReInitiateCacheAccess(UInt64 time, UnstructuredBuffer* event_args)
-      : Event(RE_INITIATE_CACHE_ACCESS, time, event_args) {}
+   EventReInitiateCacheAccess(UInt64 time, MemoryManager* memory_manager,
+                              MemComponent::component_t mem_component, MissStatus* miss_status)
+      : Event(RE_INITIATE_CACHE_ACCESS, time)
+      , _memory_manager(memory_manager), _mem_component(mem_component)
+      , _miss_status(miss_status) {}
    ~EventReInitiateCacheAccess() {}
 private:
+   MemoryManager* _memory_manager;
+   MemComponent::component_t _mem_component;
+   MissStatus* _miss_status;
+
    void __process();
 };
 
 class EventCompleteCacheAccess : public Event
 {
 public:
-   EventCompleteCacheAccess(UInt64 time, UnstructuredBuffer* event_args)
-      : Event(COMPLETE_CACHE_ACCESS, time, event_args) {}
+   EventCompleteCacheAccess(UInt64 time, Core* core, UInt32 memory_access_id)
+      : Event(COMPLETE_CACHE_ACCESS, time)
+      , _core(core), _memory_access_id(memory_access_id) {}
    ~EventCompleteCacheAccess() {}
 private:
+   Core* _core;
+   UInt32 _memory_access_id;
+
    void __process();
 };
 
 class EventStartThread : public Event
 {
 public:
-   EventStartThread(UInt64 time, UnstructuredBuffer* event_args)
-      : Event(START_THREAD, time, event_args) {}
+   EventStartThread(UInt64 time, core_id_t core_id)
+      : Event(START_THREAD, time)
+      , _core_id(core_id) {}
    ~EventStartThread() {}
    void setTime(UInt64 time) { _time = time; }
 private:
+   core_id_t _core_id;
+
    void __process();
 };
 
 class EventResumeThread : public Event
 {
 public:
-   EventResumeThread(UInt64 time, UnstructuredBuffer* event_args)
-      : Event(RESUME_THREAD, time, event_args) {}
+   EventResumeThread(UInt64 time, core_id_t core_id)
+      : Event(RESUME_THREAD, time)
+      , _core_id(core_id) {}
    ~EventResumeThread() {}
 private:
+   core_id_t _core_id;
+
    void __process();
 };
@@ -6,23 +6,54 @@
 #include "meta_event_heap.h"
 #include "event_queue_manager.h"
 
-using std::make_pair;
-
 EventHeap::EventHeap(EventQueueManager* event_queue_manager,
       MetaEventHeap* parent_event_heap, SInt32 event_heap_index_in_parent):
    EventQueue(event_queue_manager),
    _first_event_time(UINT64_MAX_),
+   _calendar_queue(NULL),
    _parent_event_heap(parent_event_heap),
    _event_heap_index_in_parent(event_heap_index_in_parent)
 {
+   UInt32 calendar_queue_num_buckets = 0;
+   try
+   {
+      _queue_type = parseQueueType(Sim()->getCfg()->getString("general/event_queue_type", "min_heap"));
+      calendar_queue_num_buckets = Sim()->getCfg()->getInt("general/calendar_queue_num_buckets", 1024);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [general/event_queue_type] or [general/calendar_queue_num_buckets] from the cfg file");
+   }
+
+   if (_queue_type == CALENDAR_QUEUE)
+   {
+      LOG_ASSERT_ERROR(calendar_queue_num_buckets > 0, "Calendar Queue Num Buckets(%u)", calendar_queue_num_buckets);
+      _calendar_queue = new CalendarQueue(calendar_queue_num_buckets);
+   }
+
    // At initialization, leaf_event_heap has no events
-   _heap.insert(UINT64_MAX_, NULL);
+   insert(UINT64_MAX_, NULL);
 }
 
 EventHeap::~EventHeap()
 {
-   assert(_heap.size() == 1);
-   assert( _heap.min() == (make_pair<UInt64,void*>(UINT64_MAX_,NULL)) );
+   assert(size() == 1);
+   assert(min() == NULL);
+   delete _calendar_queue;
+}
+
+EventHeap::QueueType
+EventHeap::parseQueueType(string queue_type_str)
+{
+   if (queue_type_str == "min_heap")
+      return MIN_HEAP;
+   else if (queue_type_str == "calendar_queue")
+      return CALENDAR_QUEUE;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Event Queue Type(%s)", queue_type_str.c_str());
+      return NUM_QUEUE_TYPES;
+   }
 }
 
 void
@@ -36,10 +67,12 @@ EventHeap::push(Event* event, bool is_locked)
 
    // Insert new packet into event queue
    // If new event = most recent event, update the sim_thread_time_heap also
-   bool top_of_heap_change = _heap.insert(event->getTime(), (void*) event);
-   if (top_of_heap_change)
+   // While events are being processed, _first_event_time holds the earliest of their
+   // times (they are no longer on the heap), so only an earlier event changes the local time
+   bool top_of_heap_change = insert(event->getTime(), event);
+   if (top_of_heap_change && (event->getTime() < _first_event_time))
    {
-      UInt64 next_event_time = (_heap.min()).first;
+      UInt64 next_event_time = min()->getTime();
       assert(next_event_time == event->getTime());
 
       // Update parent meta_event_heap
@@ -65,57 +98,152 @@ EventHeap::processEvents()
    _lock.acquire();
    
    LOG_PRINT("EventHeap(%i): processEvents(First Time[%llu]), Size(%u) enter",
-         getEventQueueManager()->getId(), _first_event_time, _heap.size());
+         getEventQueueManager()->getId(), _first_event_time, size());
    
-   while (Sim()->getEventManager()->isReady(_first_event_time))
+   Event* event = min();
+   while (event && Sim()->getEventManager()->isReady(event->getTime()))
    {
-      // Process the event at the top of the heap
-      Event* event = (Event*) (_heap.min()).second;
-      LOG_ASSERT_ERROR(event && (Sim()->getEventManager()->isReady(event->getTime())),
-            "event(%p)", event);
+      if (!processFirstEvent())
+      {
+         // An event of the same core is being processed by a sim thread that stole it
+         _lock.release();
+         __asm__ __volatile__ ("rep; nop" : : : "memory");
+         _lock.acquire();
+      }
+      event = min();
+   }
+      
+   LOG_PRINT("EventHeap(%i): processEvents(First Time[%llu]), Size(%u) exit",
+         getEventQueueManager()->getId(), _first_event_time, size());
+   
+   _lock.release(); 
+}
 
-      _lock.release();
+UInt64
+EventHeap::getNextEventTime()
+{
+   _lock.acquire();
+   Event* event = min();
+   UInt64 next_event_time = (event) ? event->getTime() : UINT64_MAX_;
+   _lock.release();
+   return next_event_time;
+}
 
-      // Network, Instruction, Memory Modeling 
-      event->process();
-      
-      _lock.acquire();
+bool
+EventHeap::stealEvent()
+{
+   // Check without locking first
+   if (!Sim()->getEventManager()->isReady(_first_event_time))
+      return false;
 
-      // Remove the event from the top of the heap
-      Event* curr_event = (Event*) ((_heap.extractMin()).second);
-      LOG_ASSERT_ERROR(event == curr_event, "Old Event(%p)[%llu,%i], New Event(%p)[%llu,%i]",
-            event, event->getTime(), event->getType(),
-            curr_event, curr_event->getTime(), curr_event->getType());
-      
-      // Get next event in order of time
-      Event* next_event = (Event*) ((_heap.min()).second);
-      UInt64 next_event_time = (next_event) ? next_event->getTime() : UINT64_MAX_;
-      Event::Type next_event_type = (next_event) ? next_event->getType() : Event::INVALID;
+   bool stolen = false;
+   _lock.acquire();
+   Event* event = min();
+   if (event && Sim()->getEventManager()->isReady(event->getTime()))
+      stolen = processFirstEvent();
+   _lock.release();
+
+   return stolen;
+}
 
-      LOG_PRINT("EventHeap(%i): After extractMin(), Next Event (Type[%u],Time[%llu])",
-            getEventQueueManager()->getId(), next_event_type, next_event_time);
+bool
+EventHeap::processFirstEvent()
+{
+   EventManager* event_manager = Sim()->getEventManager();
 
-      LOG_ASSERT_ERROR(next_event_time >= event->getTime(), "Next Event Time(%llu), Curr Event Time(%llu)",
-            next_event_time, event->getTime());
+   // Remove the event at the top of the heap before processing it.
+   // With a lookahead > 1, other sim threads may push events with an earlier
+   // time (e.g., raw packets) onto this heap while it is being processed
+   Event* event = min();
+   LOG_ASSERT_ERROR(event && (event->getTime() >= _first_event_time),
+         "event(%p), First Event Time(%llu)", event, _first_event_time);
 
-      if (next_event_time > event->getTime())
-      {
-         // Update Local Time - Global Time is always updated since top of heap changes
-         _parent_event_heap->updateTime(_event_heap_index_in_parent, next_event_time);
+   // With work stealing, the events of a core are processed by one sim thread at a time
+   // (in order of time, since they are all on this heap)
+   core_id_t core_id = event->getCoreId();
+   if (event_manager->isWorkStealingEnabled() && !event_manager->acquireCoreToken(core_id))
+      return false;
+
+   extractMin();
+   // The local time cannot move past an event that is still being processed
+   _in_flight_event_time_list.push_back(event->getTime());
 
-         // Update _first_event_time
-         _first_event_time = next_event_time;
+   _lock.release();
+
+   // Network, Instruction, Memory Modeling 
+   event->process();
+   
+   if (event_manager->isWorkStealingEnabled())
+      event_manager->releaseCoreToken(core_id);
 
-         // Wake up others(/sim_threads) who are sleeping who have ready events
-         Sim()->getEventManager()->wakeUpWaiters();
+   _lock.acquire();
+
+   for (vector<UInt64>::iterator it = _in_flight_event_time_list.begin();
+         it != _in_flight_event_time_list.end(); it++)
+   {
+      if (*it == event->getTime())
+      {
+         _in_flight_event_time_list.erase(it);
+         break;
       }
+   }
+
+   // Get next event in order of time
+   Event* next_event = min();
+   UInt64 next_event_time = (next_event) ? next_event->getTime() : UINT64_MAX_;
+   Event::Type next_event_type = (next_event) ? next_event->getType() : Event::INVALID;
+   for (UInt32 i = 0; i < _in_flight_event_time_list.size(); i++)
+      next_event_time = std::min<UInt64>(next_event_time, _in_flight_event_time_list[i]);
+
+   LOG_PRINT("EventHeap(%i): After extractMin(), Next Event (Type[%u],Time[%llu])",
+         getEventQueueManager()->getId(), next_event_type, next_event_time);
+
+   if (next_event_time != _first_event_time)
+   {
+      // Update Local Time - Global Time is always updated since top of heap changes
+      _parent_event_heap->updateTime(_event_heap_index_in_parent, next_event_time);
+
+      // Update _first_event_time
+      _first_event_time = next_event_time;
 
-      // Delete the Curr Event
-      delete event;
+      // Wake up others(/sim_threads) who are sleeping who have ready events
+      event_manager->wakeUpWaiters();
    }
-      
-   LOG_PRINT("EventHeap(%i): processEvents(First Time[%llu]), Size(%u) exit",
-         getEventQueueManager()->getId(), _first_event_time, _heap.size());
-   
-   _lock.release(); 
+
+   // Delete the Curr Event
+   delete event;
+   return true;
+}
+
+bool
+EventHeap::insert(UInt64 time, Event* event)
+{
+   if (_queue_type == CALENDAR_QUEUE)
+      return _calendar_queue->insert(time, (void*) event);
+   else
+      return _heap.insert(time, (void*) event);
+}
+
+Event*
+EventHeap::min()
+{
+   if (_queue_type == CALENDAR_QUEUE)
+      return (Event*) ((_calendar_queue->min()).second);
+   else
+      return (Event*) ((_heap.min()).second);
+}
+
+Event*
+EventHeap::extractMin()
+{
+   if (_queue_type == CALENDAR_QUEUE)
+      return (Event*) ((_calendar_queue->extractMin()).second);
+   else
+      return (Event*) ((_heap.extractMin()).second);
+}
+
+size_t
+EventHeap::size()
+{
+   return (_queue_type == CALENDAR_QUEUE) ? _calendar_queue->size() : _heap.size();
 }
@@ -1,32 +1,58 @@
 #pragma once
 
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
 #include "event_queue.h"
 #include "lock.h"
 #include "meta_event_heap.h"
 #include "min_heap.h"
+#include "calendar_queue.h"
 
 class EventHeap : public EventQueue
 {
    public:
+      // Data structure used to keep the events sorted by time
+      enum QueueType
+      {
+         MIN_HEAP = 0,
+         CALENDAR_QUEUE,
+         NUM_QUEUE_TYPES
+      };
+
       EventHeap(EventQueueManager* event_queue_manager,
             MetaEventHeap* parent_event_heap, SInt32 event_heap_index_in_parent);
       ~EventHeap();
 
       // First Event Time
       UInt64 getFirstEventTime() { return _first_event_time; }
+      // Time of the earliest event still on the heap (not counting the events being processed)
+      UInt64 getNextEventTime();
 
       // get packet with the minimum time: dequeue may include waiting for the packet
       void processEvents();
       // enqueue the packet based on its time
       void push(Event* event, bool is_locked = false);
+      // process the first event if it is ready (called by a sim thread that does not own this heap)
+      bool stealEvent();
       // Acquire/Release Locks
       void acquireLock() { _lock.acquire(); }
       void releaseLock() { _lock.release(); }
+      // Leaf MetaEventHeap this event heap belongs to
+      MetaEventHeap* getParentEventHeap() { return _parent_event_heap; }
+
+      static QueueType parseQueueType(string queue_type_str);
 
    private:
       // Timestamp of the most recent event
       volatile UInt64 _first_event_time;
+      QueueType _queue_type;
       MinHeap _heap;
+      CalendarQueue* _calendar_queue;
+      // Times of the events (taken off the heap) that are being processed
+      vector<UInt64> _in_flight_event_time_list;
 
       // Locking the event heap
       Lock _lock;
@@ -34,4 +60,14 @@ class EventHeap : public EventQueue
       // Pointer to Parent & Event Queue index in the parent's event queue 
       MetaEventHeap* _parent_event_heap;
       SInt32 _event_heap_index_in_parent;
+
+      // Process the first event (called with _lock held). Returns false if the
+      // event's core is owned by another sim thread (work stealing)
+      bool processFirstEvent();
+
+      // Operations on the underlying MinHeap/CalendarQueue
+      bool insert(UInt64 time, Event* event);
+      Event* min();
+      Event* extractMin();
+      size_t size();
 };
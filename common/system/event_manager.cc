@@ -10,14 +10,40 @@
 #include "event_queue.h"
 #include "meta_event_heap.h"
 #include "event.h"
+#include "network_model.h"
+#include "network_types.h"
+#include "packet_type.h"
 #include "config.h"
 #include "log.h"
 
 // 1) One EventManager per process
-// 2) One _global_meta_event_heap for the entire simulation
-EventManager::EventManager()
+// 2) One _global_meta_event_heap (root of a tree of MetaEventHeaps) for the entire simulation
+EventManager::EventManager():
+   _last_wakeup_global_time(UINT64_MAX_)
 {
-   _global_meta_event_heap = new MetaEventHeap(Config::getSingleton()->getTotalSimThreads());
+   _lookahead = computeLookahead();
+   LOG_PRINT("Event Lookahead(%llu)", _lookahead);
+
+   UInt32 sim_thread_spin_count = 0;
+   try
+   {
+      _meta_event_heap_fan_out = Sim()->getCfg()->getInt("general/meta_event_heap_fan_out", 8);
+      sim_thread_spin_count = Sim()->getCfg()->getInt("general/sim_thread_spin_count", 1000);
+      _work_stealing_enabled = Sim()->getCfg()->getBool("general/enable_work_stealing", false);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [general/meta_event_heap_fan_out], [general/sim_thread_spin_count] "
+            "or [general/enable_work_stealing] from the cfg file");
+   }
+   if (_work_stealing_enabled)
+      _core_token_list.resize(Config::getSingleton()->getTotalCores(), 0);
+   LOG_ASSERT_ERROR(_meta_event_heap_fan_out >= 2, "Meta Event Heap Fan Out(%i)", _meta_event_heap_fan_out);
+
+   vector<pair<MetaEventHeap*,SInt32> > leaf_event_heap_list(Config::getSingleton()->getTotalSimThreads());
+   _global_meta_event_heap = createMetaEventHeapTree(0, Config::getSingleton()->getTotalSimThreads(),
+         NULL, -1, leaf_event_heap_list);
+   _leaf_first_sim_thread_id_list.push_back(Config::getSingleton()->getTotalSimThreads());
 
    // sim thread event queue managers
    for (UInt32 i = 0; i < Config::getSingleton()->getTotalSimThreads(); i++)
@@ -31,8 +57,9 @@ EventManager::EventManager()
       // 1) The events on the EventHeap are processed in the order of simulated timestamps
       // 2) The events on the UnorderedEventQueue are processed as and when they come
       //                (in the order of real time)
-      EventQueueManager* event_queue_manager = new EventQueueManager(i);
-      EventHeap* event_heap = new EventHeap(event_queue_manager, _global_meta_event_heap, i);
+      EventQueueManager* event_queue_manager = new EventQueueManager(i, sim_thread_spin_count);
+      EventHeap* event_heap = new EventHeap(event_queue_manager,
+            leaf_event_heap_list[i].first, leaf_event_heap_list[i].second);
       UnorderedEventQueue* unordered_event_queue = new UnorderedEventQueue(event_queue_manager);
       event_queue_manager->setEventQueues(event_heap, unordered_event_queue);
 
@@ -48,7 +75,42 @@ EventManager::~EventManager()
       delete _event_queue_manager_list[i]->getEventQueue(EventQueue::ORDERED);
       delete _event_queue_manager_list[i];
    }
-   delete _global_meta_event_heap;
+   for (UInt32 i = 0; i < _meta_event_heap_list.size(); i++)
+      delete _meta_event_heap_list[i];
+}
+
+MetaEventHeap*
+EventManager::createMetaEventHeapTree(SInt32 first_sim_thread_id, SInt32 num_sim_threads,
+      MetaEventHeap* parent_event_heap, SInt32 event_heap_index_in_parent,
+      vector<pair<MetaEventHeap*,SInt32> >& leaf_event_heap_list)
+{
+   if (num_sim_threads <= _meta_event_heap_fan_out)
+   {
+      // Leaf: the children are the event heaps of the sim threads
+      MetaEventHeap* meta_event_heap = new MetaEventHeap(num_sim_threads, parent_event_heap, event_heap_index_in_parent);
+      _meta_event_heap_list.push_back(meta_event_heap);
+      _leaf_meta_event_heap_list.push_back(meta_event_heap);
+      _leaf_first_sim_thread_id_list.push_back(first_sim_thread_id);
+      for (SInt32 i = 0; i < num_sim_threads; i++)
+         leaf_event_heap_list[first_sim_thread_id + i] = make_pair(meta_event_heap, i);
+      return meta_event_heap;
+   }
+
+   // Split the sim threads evenly among (at most) _meta_event_heap_fan_out children
+   SInt32 num_sim_threads_per_child = (num_sim_threads + _meta_event_heap_fan_out - 1) / _meta_event_heap_fan_out;
+   SInt32 num_children = (num_sim_threads + num_sim_threads_per_child - 1) / num_sim_threads_per_child;
+
+   MetaEventHeap* meta_event_heap = new MetaEventHeap(num_children, parent_event_heap, event_heap_index_in_parent);
+   _meta_event_heap_list.push_back(meta_event_heap);
+   for (SInt32 i = 0; i < num_children; i++)
+   {
+      SInt32 child_first_sim_thread_id = first_sim_thread_id + i * num_sim_threads_per_child;
+      SInt32 child_num_sim_threads = min<SInt32>(num_sim_threads_per_child,
+            first_sim_thread_id + num_sim_threads - child_first_sim_thread_id);
+      createMetaEventHeapTree(child_first_sim_thread_id, child_num_sim_threads,
+            meta_event_heap, i, leaf_event_heap_list);
+   }
+   return meta_event_heap;
 }
 
 EventQueueManager*
@@ -58,17 +120,52 @@ EventManager::getEventQueueManager(SInt32 sim_thread_id)
    return _event_queue_manager_list[sim_thread_id];
 }
 
+UInt64
+EventManager::computeLookahead()
+{
+   bool lookahead_enabled = false;
+   try
+   {
+      lookahead_enabled = Sim()->getCfg()->getBool("general/enable_event_lookahead", false);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read general/enable_event_lookahead from the cfg file");
+   }
+
+   // Exact-time lockstep
+   if (!lookahead_enabled)
+      return 1;
+
+   // Events on a sim thread can only schedule events on other sim threads by sending
+   // network packets. So, all events in [global_time, global_time + min_network_latency)
+   // are independent of each other and can be processed in parallel.
+   // The SYSTEM network is not modeled and never generates events.
+   UInt64 lookahead = UINT64_MAX_;
+   for (SInt32 i = 0; i < NUM_STATIC_NETWORKS; i++)
+   {
+      if (i == STATIC_NETWORK_SYSTEM)
+         continue;
+      UInt32 network_type = NetworkModel::parseNetworkType(Config::getSingleton()->getNetworkType(i));
+      lookahead = min<UInt64>(lookahead, NetworkModel::computeMinimumLatency(network_type));
+      if (Config::getSingleton()->isHybridNetwork(i))
+      {
+         UInt32 fast_network_type = NetworkModel::parseNetworkType(Config::getSingleton()->getFastNetworkType(i));
+         lookahead = min<UInt64>(lookahead, NetworkModel::computeMinimumLatency(fast_network_type));
+      }
+   }
+   
+   return (lookahead == 0) ? 1 : lookahead;
+}
+
 bool
 EventManager::isReady(UInt64 event_time)
 {
-   // UInt64 global_time = _global_meta_event_heap->getFirstEventTime();
-   // LOG_ASSERT_ERROR(event_time >= global_time,
-   //       "Event Time(%llu), Global Time(%llu)", 
-   //       event_time, global_time);
+   if (event_time == UINT64_MAX_)
+      return false;
 
    UInt64 global_time = _global_meta_event_heap->getFirstEventTime();
-   // TODO: Make this a range later
-   return ( (event_time == global_time) && (event_time != UINT64_MAX_) );
+   return ( (event_time <= global_time) || ((event_time - global_time) < _lookahead) );
 }
 
 bool
@@ -77,16 +174,83 @@ EventManager::hasEventsPending()
    return (_global_meta_event_heap->getFirstEventTime() != UINT64_MAX_);
 }
 
+bool
+EventManager::isSafeToSkipTo(core_id_t core_id, UInt64 time)
+{
+   if (!isReady(time))
+      return false;
+
+   SInt32 sim_thread_id = Sim()->getSimThreadManager()->getSimThreadIDFromCoreID(core_id);
+   EventHeap* event_heap = (EventHeap*) _event_queue_manager_list[sim_thread_id]->getEventQueue(EventQueue::ORDERED);
+   return (time < event_heap->getNextEventTime());
+}
+
 void
 EventManager::wakeUpWaiters()
 {
    LOG_PRINT("wakeUpWaiters()");
+
+   // A sim thread that changes its own first event time (or pushes onto another's heap)
+   // checks for itself if that event is ready (see EventQueueManager::signalEvent()).
+   // So, only the sim threads that become ready because the global time moved
+   // need to be woken up, and only once for each new global time
+   __sync_synchronize();
+   UInt64 global_time = _global_meta_event_heap->getFirstEventTime();
+   if ((global_time == UINT64_MAX_) || (global_time == _last_wakeup_global_time))
+      return;
+   _last_wakeup_global_time = global_time;
+   __sync_synchronize();
    
    // Wakes up only the sim threads for now
    // Once instruction and private cache modeling is made cycle-accurate,
    // wake up app threads also. Now, app threads run uncontrolled
-   for (UInt32 i = 0; i < Config::getSingleton()->getTotalSimThreads(); i++)
-      _event_queue_manager_list[i]->signalEvent();
+   // Skip the leaves that have no ready events
+   UInt32 num_ready_sim_threads = 0;
+   for (UInt32 i = 0; i < _leaf_meta_event_heap_list.size(); i++)
+   {
+      if (!isReady(_leaf_meta_event_heap_list[i]->getFirstEventTime()))
+         continue;
+      for (SInt32 j = _leaf_first_sim_thread_id_list[i]; j < _leaf_first_sim_thread_id_list[i+1]; j++)
+      {
+         EventHeap* event_heap = (EventHeap*) _event_queue_manager_list[j]->getEventQueue(EventQueue::ORDERED);
+         if (isReady(event_heap->getFirstEventTime()))
+         {
+            _event_queue_manager_list[j]->signalEvent();
+            num_ready_sim_threads ++;
+         }
+      }
+   }
+
+   if (!_work_stealing_enabled)
+      return;
+
+   // Wake up (at most) one idle sim thread per sim thread with ready events to help it out
+   for (UInt32 i = 0; (i < _event_queue_manager_list.size()) && (num_ready_sim_threads > 0); i++)
+   {
+      if (_event_queue_manager_list[i]->isIdle())
+      {
+         _event_queue_manager_list[i]->wakeUp();
+         num_ready_sim_threads --;
+      }
+   }
+}
+
+bool
+EventManager::stealEvents(SInt32 sim_thread_id)
+{
+   bool stolen = false;
+   SInt32 num_sim_threads = _event_queue_manager_list.size();
+   for (SInt32 i = 1; i < num_sim_threads; i++)
+   {
+      SInt32 victim_sim_thread_id = (sim_thread_id + i) % num_sim_threads;
+      EventHeap* event_heap = (EventHeap*) _event_queue_manager_list[victim_sim_thread_id]->getEventQueue(EventQueue::ORDERED);
+      while (event_heap->stealEvent())
+      {
+         LOG_PRINT("SimThread(%i) stole an event from SimThread(%i)", sim_thread_id, victim_sim_thread_id);
+         stolen = true;
+      }
+   }
+   return stolen;
 }
 
 void
@@ -95,6 +259,7 @@ EventManager::processEventInOrder(Event* event, core_id_t core_id, EventQueue::T
    LOG_PRINT("Queueing Event (Event[%p], Processing CoreId[%i], EventQueueType[%s]",
          event, core_id, EventQueue::getName(event_queue_type).c_str());
    
+   event->setCoreId(core_id);
    SInt32 sim_thread_id = Sim()->getSimThreadManager()->getSimThreadIDFromCoreID(core_id);
    // EventQueue is defined by (sim_thread_id, event_queue_type)
    EventQueueManager* event_queue_manager = getEventQueueManager(sim_thread_id);
@@ -104,10 +269,11 @@ EventManager::processEventInOrder(Event* event, core_id_t core_id, EventQueue::T
    {
       LOG_PRINT("Queueing Event (START_THREAD)");
 
-      // Acquire LocalHeap and GlobalHeap locks
+      // Acquire LocalHeap lock and the locks on the path to the GlobalHeap
       assert(event_queue_type == EventQueue::ORDERED);
+      MetaEventHeap* parent_event_heap = ((EventHeap*) event_queue)->getParentEventHeap();
       event_queue->acquireLock();
-      _global_meta_event_heap->acquireLock();
+      parent_event_heap->acquirePathLocks();
       
       // Get the current global time and set that as the event time
       EventStartThread* event_start_thread = (EventStartThread*) event;
@@ -123,8 +289,8 @@ EventManager::processEventInOrder(Event* event, core_id_t core_id, EventQueue::T
       // Push the event by using the pre-locked version of the function
       event_queue->push(event_start_thread, true /* is_locked */ );
 
-      // Release the Locks on the LocalHeap and GlobalHeap
-      _global_meta_event_heap->releaseLock();
+      // Release the Locks on the path to the GlobalHeap and the LocalHeap
+      parent_event_heap->releasePathLocks();
       event_queue->releaseLock();
    }
    else
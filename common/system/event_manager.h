@@ -5,6 +5,7 @@
 #include <vector>
 using std::map;
 using std::vector;
+using std::pair;
 
 #include "fixed_types.h"
 #include "meta_event_heap.h"
@@ -26,13 +27,30 @@ class EventManager
       void wakeUpWaiters();
       // Checks if a particular event is ready
       bool isReady(UInt64 event_time);
+      // Width of the window [global_time, global_time + lookahead) of events that can be processed in parallel
+      UInt64 getLookahead() { return _lookahead; }
 
       // Check if there are any more pending events
       bool hasEventsPending();
+      // Can 'core_id' be modeled up to 'time' right away, without processing any event
+      // in between ? True if no other sim thread can push an event for the core before
+      // 'time' (it is within the lookahead window) and none is pending on its heap
+      bool isSafeToSkipTo(core_id_t core_id, UInt64 time);
 
       // Create an event and push it onto the processing sim thread's queue
       void processEventInOrder(Event* event, core_id_t core_id, EventQueue::Type event_queue_type);
 
+      // Work stealing: an idle sim thread processes the ready events on other sim threads' heaps.
+      // A sim thread holds a core's token while it processes one of the core's events
+      bool isWorkStealingEnabled() { return _work_stealing_enabled; }
+      bool acquireCoreToken(core_id_t core_id)
+      { return __sync_bool_compare_and_swap(&_core_token_list[core_id], 0, 1); }
+      void releaseCoreToken(core_id_t core_id)
+      { __sync_lock_release(&_core_token_list[core_id]); }
+      // Process ready events on the heaps of sim threads other than 'sim_thread_id'
+      // Returns true if any event was processed
+      bool stealEvents(SInt32 sim_thread_id);
+
    private:
       // Different Thread Types
       enum TheadType
@@ -43,6 +61,30 @@ class EventManager
       };
 
       // The different event heaps - Works only with single process
+      // _global_meta_event_heap is the root of a tree of MetaEventHeaps with
+      // (at most) _meta_event_heap_fan_out children per node
       MetaEventHeap* _global_meta_event_heap;
+      vector<MetaEventHeap*> _meta_event_heap_list;
+      SInt32 _meta_event_heap_fan_out;
+      // Leaf MetaEventHeaps and the first sim thread in each (the sim threads in
+      // leaf i are [_leaf_first_sim_thread_id_list[i], _leaf_first_sim_thread_id_list[i+1]))
+      vector<MetaEventHeap*> _leaf_meta_event_heap_list;
+      vector<SInt32> _leaf_first_sim_thread_id_list;
+      // Global time at which the sim threads with ready events were last woken up
+      volatile UInt64 _last_wakeup_global_time;
+
+      bool _work_stealing_enabled;
+      vector<UInt32> _core_token_list;
       vector<EventQueueManager*> _event_queue_manager_list;
+
+      // Conservative lookahead (in cycles)
+      UInt64 _lookahead;
+
+      // Compute the lookahead from the minimum latency of the network models
+      UInt64 computeLookahead();
+      // Create the (sub-)tree of MetaEventHeaps over sim threads [first_sim_thread_id, first_sim_thread_id + num_sim_threads)
+      // leaf_event_heap_list[i] is set to the leaf MetaEventHeap and the index in it of sim thread i
+      MetaEventHeap* createMetaEventHeapTree(SInt32 first_sim_thread_id, SInt32 num_sim_threads,
+            MetaEventHeap* parent_event_heap, SInt32 event_heap_index_in_parent,
+            vector<pair<MetaEventHeap*,SInt32> >& leaf_event_heap_list);
 };
@@ -5,8 +5,10 @@
 #include "event_manager.h"
 #include "log.h"
 
-EventQueueManager::EventQueueManager(SInt32 id):
-   _id(id)
+EventQueueManager::EventQueueManager(SInt32 id, UInt32 spin_count):
+   _id(id),
+   _binary_semaphore(spin_count),
+   _idle(false)
 {}
 
 EventQueueManager::~EventQueueManager()
@@ -32,9 +34,14 @@ void
 EventQueueManager::processEvents()
 {
    LOG_PRINT("EventQueueManager(%i): processEvents() enter", getId());
+   _idle = true;
    _binary_semaphore.wait();
+   _idle = false;
    _event_heap->processEvents();
    _unordered_event_queue->processEvents();
+   // Help the other sim threads with their ready events
+   if (Sim()->getEventManager()->isWorkStealingEnabled())
+      Sim()->getEventManager()->stealEvents(getId());
    LOG_PRINT("EventQueueManager(%i): processEvents() exit", getId());
 }
 
@@ -42,6 +49,11 @@ void
 EventQueueManager::signalEvent()
 {
    LOG_PRINT("EventQueueManager(%i): signalEvent() enter", getId());
+   // The local/global event times (or the unordered event queue) were updated
+   // before this. Read them only after those writes are visible to the other
+   // sim threads, so that either this thread or EventManager::wakeUpWaiters()
+   // sees that the event is ready
+   __sync_synchronize();
    if ( (Sim()->getEventManager()->isReady(_event_heap->getFirstEventTime()))
          || (!_unordered_event_queue->empty()) )
    {
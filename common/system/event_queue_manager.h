@@ -14,7 +14,7 @@ class UnorderedEventQueue;
 class EventQueueManager
 {
 public:
-   EventQueueManager(SInt32 id);
+   EventQueueManager(SInt32 id, UInt32 spin_count);
    ~EventQueueManager();
 
    SInt32 getId() { return _id; }
@@ -22,6 +22,9 @@ public:
    // Polling, Waiting and Signalling an event
    void processEvents();
    void signalEvent();
+   // Sleeping with no ready events of its own (work stealing)
+   bool isIdle() { return _idle; }
+   void wakeUp() { _binary_semaphore.signal(); }
 
    void setEventQueues(EventHeap* event_heap, UnorderedEventQueue* unordered_event_queue);
    EventQueue* getEventQueue(EventQueue::Type type);
@@ -37,4 +40,5 @@ private:
    
    // Synchronization between event queues
    BinarySemaphore _binary_semaphore;
+   volatile bool _idle;
 };
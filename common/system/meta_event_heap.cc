@@ -52,3 +52,19 @@ MetaEventHeap::updateTime(SInt32 event_index, UInt64 time, bool is_locked)
    if (!is_locked)
       _lock.release();
 }
+
+void
+MetaEventHeap::acquirePathLocks()
+{
+   _lock.acquire();
+   if (_parent_event_heap)
+      _parent_event_heap->acquirePathLocks();
+}
+
+void
+MetaEventHeap::releasePathLocks()
+{
+   if (_parent_event_heap)
+      _parent_event_heap->releasePathLocks();
+   _lock.release();
+}
@@ -7,6 +7,10 @@ using std::vector;
 #include "lock.h"
 #include "min_heap.h"
 
+// Node in a tree of MetaEventHeaps. Each leaf has the EventHeaps of a few sim threads
+// as children and the root holds the global first event time. An update locks
+// a node and moves on to the parent (with the node still locked) only if the
+// node's first event time changed, so updates lock at most a leaf-to-root path
 class MetaEventHeap
 {
    public:
@@ -17,16 +21,24 @@ class MetaEventHeap
       UInt64 getFirstEventTime() { return _first_event_time; }
 
       // Update the time associated with an event. The event is addressed using its index
-      // in the event queue
+      // in the event queue. If is_locked is true, the caller holds the locks on the
+      // path from this node to the root (see acquirePathLocks())
       void updateTime(SInt32 event_index, UInt64 time, bool is_locked = false);
 
       // Acquire/Release Locks
       void acquireLock() { _lock.acquire(); }
       void releaseLock() { _lock.release(); }
+      // Acquire/Release the Locks on the path from this node to the root (bottom-up)
+      // Holding these freezes the global first event time
+      void acquirePathLocks();
+      void releasePathLocks();
 
    private:
       // Timestamp of the most recent event
+      // Read without locking (by EventManager::isReady()), so it is kept
+      // on a different cache line than the fields written on every update
       volatile UInt64 _first_event_time;
+      Byte _padding[64];
       MinHeap _heap;
 
       // Locking the event heap
@@ -253,6 +253,20 @@ __emulateRoutine(UInt64 time, core_id_t core_id, Routine::Id routine_id, Unstruc
          break;
       }
 
+   case Routine::ENABLE_DETAILED_NETWORK_MODELS:
+      {
+         Simulator::__enableDetailedNetworkModels();
+         cont = true;
+         break;
+      }
+
+   case Routine::DISABLE_DETAILED_NETWORK_MODELS:
+      {
+         Simulator::__disableDetailedNetworkModels();
+         cont = true;
+         break;
+      }
+
    default:
       LOG_PRINT_ERROR("Unrecongized Routine Id(%u)", routine_id);
       break;
@@ -36,6 +36,9 @@ public:
       // Enable/Disable Models
       ENABLE_PERFORMANCE_MODELS,
       DISABLE_PERFORMANCE_MODELS,
+      // Hybrid Networks
+      ENABLE_DETAILED_NETWORK_MODELS,
+      DISABLE_DETAILED_NETWORK_MODELS,
       NUM_ROUTINES
    };
 };
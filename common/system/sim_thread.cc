@@ -62,9 +62,7 @@ void SimThread::terminate()
 
 void SimThread::handleTerminationRequest(Event* event)
 {
-   UnstructuredBuffer* event_args = event->getArgs();
-   SimThread* sim_thread;
-   (*event_args) >> sim_thread;
+   SimThread* sim_thread = TypedEvent<SimThread*>::getTypedArgs(event);
    LOG_PRINT("Terminate(%p)", sim_thread);
    sim_thread->terminate();
 }
@@ -1,3 +1,6 @@
+#include <cmath>
+#include <algorithm>
+
 #include "sim_thread_manager.h"
 
 #include "lock.h"
@@ -5,6 +8,9 @@
 #include "config.h"
 #include "simulator.h"
 #include "event.h"
+#include "network_model.h"
+#include "network_types.h"
+#include "packet_type.h"
 
 SimThreadManager::SimThreadManager()
    : m_active_threads(0)
@@ -26,14 +32,36 @@ SimThreadManager::initializeSimThreadIDToCoreIDMappings()
    // Compute the mapping from core id to sim thread id
    SInt32 num_cores = Config::getSingleton()->getTotalCores();
    SInt32 num_sim_threads = Config::getSingleton()->getTotalSimThreads();
+
+   string sim_thread_mapping;
+   try
+   {
+      sim_thread_mapping = Sim()->getCfg()->getString("general/sim_thread_mapping", "linear");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [general/sim_thread_mapping] from the cfg file");
+   }
+
+   _sim_thread_id__to__core_id_list__mapping.resize(num_sim_threads);
+   _core_id__to__sim_thread_id__mapping.resize(num_cores);
+
+   if (sim_thread_mapping == "linear")
+      initializeLinearMappings(num_cores, num_sim_threads);
+   else if (sim_thread_mapping == "mesh_block")
+      initializeMeshBlockMappings(num_cores, num_sim_threads);
+   else
+      LOG_PRINT_ERROR("Unrecognized Sim Thread Mapping(%s)", sim_thread_mapping.c_str());
+}
+
+void
+SimThreadManager::initializeLinearMappings(SInt32 num_cores, SInt32 num_sim_threads)
+{
    // Compute a stupid mapping -- Refine Later
    SInt32 sim_thread_id = 0;
    
    SInt32 num_cores_per_sim_thread = num_cores / num_sim_threads;
 
-   _sim_thread_id__to__core_id_list__mapping.resize(num_sim_threads);
-   _core_id__to__sim_thread_id__mapping.resize(num_cores);
-
    for (core_id_t core_id = 0; core_id < num_cores; )
    {
       _core_id__to__sim_thread_id__mapping[core_id] = sim_thread_id;
@@ -47,6 +75,86 @@ SimThreadManager::initializeSimThreadIDToCoreIDMappings()
    }
 }
 
+SInt32
+SimThreadManager::computeMeshBlockRegion(core_id_t core_id, SInt32 mesh_width, SInt32 mesh_height,
+      SInt32 num_regions_x, SInt32 num_regions_y)
+{
+   SInt32 x = core_id % mesh_width;
+   SInt32 y = core_id / mesh_width;
+   SInt32 region_x = (x * num_regions_x) / mesh_width;
+   SInt32 region_y = (y * num_regions_y) / mesh_height;
+   return region_y * num_regions_x + region_x;
+}
+
+void
+SimThreadManager::initializeMeshBlockMappings(SInt32 num_cores, SInt32 num_sim_threads)
+{
+   // The regions follow the geometry of the EMesh network models. The magic
+   // network has no geometry, so any mapping suits it
+   SInt32 mesh_networks[] = {STATIC_NETWORK_USER_1, STATIC_NETWORK_USER_2,
+                             STATIC_NETWORK_MEMORY_1, STATIC_NETWORK_MEMORY_2};
+   for (UInt32 i = 0; i < sizeof(mesh_networks) / sizeof(mesh_networks[0]); i++)
+   {
+      string network_type_str = Config::getSingleton()->getNetworkType(mesh_networks[i]);
+      UInt32 network_type = NetworkModel::parseNetworkType(network_type_str);
+      LOG_ASSERT_ERROR((network_type == NETWORK_MAGIC) ||
+                       (network_type == NETWORK_EMESH_HOP_COUNTER) ||
+                       (network_type == FINITE_BUFFER_NETWORK_EMESH),
+                       "Sim Thread Mapping(mesh_block) needs EMesh user and memory networks, not (%s)",
+                       network_type_str.c_str());
+   }
+
+   // Same mesh as the EMesh network models
+   SInt32 mesh_width = (SInt32) floor(sqrt(num_cores));
+   SInt32 mesh_height = (SInt32) ceil(1.0 * num_cores / mesh_width);
+
+   // (num_regions_x * num_regions_y) regions, one per sim thread. Choose the
+   // regions with the smallest perimeter, so that the fewest links cross them.
+   // The last row of the mesh may not be full, so a partition can leave a
+   // region without cores: such partitions are skipped
+   SInt32 num_regions_x = 0;
+   SInt32 num_regions_y = 0;
+   double min_region_perimeter = 0.0;
+   for (SInt32 regions_x = 1; regions_x <= num_sim_threads; regions_x ++)
+   {
+      if ((num_sim_threads % regions_x) != 0)
+         continue;
+      SInt32 regions_y = num_sim_threads / regions_x;
+      if ((regions_x > mesh_width) || (regions_y > mesh_height))
+         continue;
+
+      vector<bool> region_has_cores(num_sim_threads, false);
+      for (core_id_t core_id = 0; core_id < num_cores; core_id ++)
+         region_has_cores[computeMeshBlockRegion(core_id, mesh_width, mesh_height, regions_x, regions_y)] = true;
+      if (find(region_has_cores.begin(), region_has_cores.end(), false) != region_has_cores.end())
+         continue;
+
+      double region_perimeter = ((double) mesh_width) / regions_x + ((double) mesh_height) / regions_y;
+      if ((num_regions_x == 0) || (region_perimeter < min_region_perimeter))
+      {
+         num_regions_x = regions_x;
+         num_regions_y = regions_y;
+         min_region_perimeter = region_perimeter;
+      }
+   }
+   if (num_regions_x == 0)
+   {
+      LOG_PRINT_WARNING("Could not divide a (%i x %i) mesh into %i non-empty regions, using the linear Sim Thread Mapping",
+            mesh_width, mesh_height, num_sim_threads);
+      initializeLinearMappings(num_cores, num_sim_threads);
+      return;
+   }
+   LOG_PRINT("Sim Thread Regions(%i x %i), Mesh(%i x %i)", num_regions_x, num_regions_y, mesh_width, mesh_height);
+
+   for (core_id_t core_id = 0; core_id < num_cores; core_id ++)
+   {
+      SInt32 sim_thread_id = computeMeshBlockRegion(core_id, mesh_width, mesh_height, num_regions_x, num_regions_y);
+
+      _core_id__to__sim_thread_id__mapping[core_id] = sim_thread_id;
+      _sim_thread_id__to__core_id_list__mapping[sim_thread_id].push_back(core_id);
+   }
+}
+
 vector<core_id_t>&
 SimThreadManager::getCoreIDListFromSimThreadID(SInt32 sim_thread_id)
 {
@@ -94,11 +202,10 @@ SimThreadManager::quitSimThreads()
    {
       // Get a single core id
       vector<core_id_t>& core_id_list = _sim_thread_id__to__core_id_list__mapping[i];
+      LOG_ASSERT_ERROR(!core_id_list.empty(), "Sim Thread(%u) has no cores", i);
       core_id_t core_id = core_id_list.front();
 
-      UnstructuredBuffer* event_args = new UnstructuredBuffer();
-      (*event_args) << &m_sim_threads[i];
-      Event* event = new Event((Event::Type) TERMINATE_SIM_THREAD, 0 /* time */, event_args);
+      Event* event = new TypedEvent<SimThread*>(TERMINATE_SIM_THREAD, 0 /* time */, &m_sim_threads[i]);
       Event::processInOrder(event, core_id, EventQueue::UNORDERED);
    }
 
@@ -36,6 +36,14 @@ private:
 
    // Initialization of core id --> sim thread id mapping
    void initializeSimThreadIDToCoreIDMappings();
+   // Contiguous blocks of core ids
+   void initializeLinearMappings(SInt32 num_cores, SInt32 num_sim_threads);
+   // Rectangular regions of the mesh of cores
+   void initializeMeshBlockMappings(SInt32 num_cores, SInt32 num_sim_threads);
+   // Region (i.e., sim thread) of 'core_id' when the mesh is divided into
+   // (num_regions_x * num_regions_y) regions
+   static SInt32 computeMeshBlockRegion(core_id_t core_id, SInt32 mesh_width, SInt32 mesh_height,
+         SInt32 num_regions_x, SInt32 num_regions_y);
 };
 
 #endif // SIM_THREAD_MANAGER
@@ -196,3 +196,35 @@ Simulator::__disablePerformanceModels()
       Sim()->getCoreManager()->getCoreFromID(i)->disablePerformanceModels();
    LOG_PRINT("Simulator::disablePerformanceModels end");
 }
+
+void
+Simulator::enableDetailedNetworkModels()
+{
+   LOG_PRINT("Simulator::enableDetailedNetworkModels()");
+   emulateRoutine(Routine::ENABLE_DETAILED_NETWORK_MODELS);
+}
+
+void
+Simulator::disableDetailedNetworkModels()
+{
+   LOG_PRINT("Simulator::disableDetailedNetworkModels()");
+   emulateRoutine(Routine::DISABLE_DETAILED_NETWORK_MODELS);
+}
+
+void
+Simulator::__enableDetailedNetworkModels()
+{
+   LOG_PRINT("Simulator::enableDetailedNetworkModels start");
+   for (UInt32 i = 0; i < Config::getSingleton()->getTotalCores(); i++)
+      Sim()->getCoreManager()->getCoreFromID(i)->getNetwork()->enableDetailedModels();
+   LOG_PRINT("Simulator::enableDetailedNetworkModels end");
+}
+
+void
+Simulator::__disableDetailedNetworkModels()
+{
+   LOG_PRINT("Simulator::disableDetailedNetworkModels start");
+   for (UInt32 i = 0; i < Config::getSingleton()->getTotalCores(); i++)
+      Sim()->getCoreManager()->getCoreFromID(i)->getNetwork()->disableDetailedModels();
+   LOG_PRINT("Simulator::disableDetailedNetworkModels end");
+}
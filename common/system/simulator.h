@@ -43,6 +43,10 @@ public:
    static void disablePerformanceModels();
    static void __enablePerformanceModels();
    static void __disablePerformanceModels();
+   static void enableDetailedNetworkModels();
+   static void disableDetailedNetworkModels();
+   static void __enableDetailedNetworkModels();
+   static void __disableDetailedNetworkModels();
 
    std::string getGraphiteHome() { return _graphite_home; }
 
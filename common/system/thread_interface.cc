@@ -1,15 +1,37 @@
+#include <sched.h>
+
 #include "core.h"
+#include "simulator.h"
 #include "thread_interface.h"
 #include "event.h"
+#include "event_manager.h"
+#include "performance_model.h"
 
 ThreadInterface::ThreadInterface(Core* core)
-   : _core(core)
+   : _num_pending_app_requests(0)
+   , _instruction_queue(core->getPerformanceModel()->getMaxOutstandingInstructions())
+   , _num_instructions_sent(0)
+   , _num_instructions_received(0)
+   , _core(core)
+   , _sim_thread_waiting(0)
 {
+   try
+   {
+      _instruction_batch_size = Sim()->getCfg()->getInt("general/instruction_batch_size", 32);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [general/instruction_batch_size] from the cfg file");
+   }
+   LOG_ASSERT_ERROR(_instruction_batch_size > 0, "Instruction Batch Size(%u)", _instruction_batch_size);
+   if (_instruction_batch_size > _instruction_queue.getCapacity())
+      _instruction_batch_size = _instruction_queue.getCapacity();
 }
 
 ThreadInterface::~ThreadInterface()
 {
    LOG_ASSERT_ERROR(_app_request_queue.empty(), "App Request Queue Size(%u)", _app_request_queue.size());
+   LOG_ASSERT_ERROR(_instruction_queue.empty(), "Instruction Queue not empty");
 }
 
 void
@@ -23,22 +45,92 @@ ThreadInterface::sendAppRequest(AppRequest app_request)
    }
    else // (Config::getSingleton()->getExecutionMode() != Config::NATIVE)
    {
+      // Instructions sent earlier must be processed before this request
+      flushInstructions();
+
       _lock.acquire();
-      _app_request_queue.push(app_request);
+      _app_request_queue.push(make_pair(_num_instructions_sent, app_request));
       _lock.release();
+      __sync_fetch_and_add(&_num_pending_app_requests, 1);
+      wakeUpSimThread();
+   }
+}
+
+void
+ThreadInterface::sendInstruction(const InstructionRecord& instruction_record)
+{
+   LOG_PRINT("CoreID(%i): sendInstruction(%p)", _core->getId(), instruction_record._instruction);
+
+   while (!_instruction_queue.push(instruction_record))
+   {
+      // Queue full, let the sim thread catch up
+      flushInstructions();
+      sched_yield();
+   }
+   _num_instructions_sent ++;
+
+   if (_instruction_queue.getNumUnpublished() >= _instruction_batch_size)
+      flushInstructions();
+}
+
+void
+ThreadInterface::flushInstructions()
+{
+   if (_instruction_queue.getNumUnpublished() == 0)
+      return;
+
+   _instruction_queue.publish();
+   wakeUpSimThread();
+}
+
+void
+ThreadInterface::wakeUpSimThread()
+{
+   // Pairs with the barrier in waitForAppRequest(): either the sim thread
+   // sees what was just sent, or we see that it is going to sleep
+   __sync_synchronize();
+   if (_sim_thread_waiting && __sync_bool_compare_and_swap(&_sim_thread_waiting, 1, 0))
       _request_semaphore.signal();
+}
+
+void
+ThreadInterface::waitForAppRequest()
+{
+   while (_instruction_queue.empty() && (_num_pending_app_requests == 0))
+   {
+      _sim_thread_waiting = 1;
+      __sync_synchronize();
+
+      if ( (!_instruction_queue.empty() || (_num_pending_app_requests > 0)) &&
+           __sync_bool_compare_and_swap(&_sim_thread_waiting, 1, 0) )
+      {
+         break;
+      }
+      // Either nothing has been sent, or the app thread has
+      // claimed the wake-up and is going to signal
+      _request_semaphore.wait();
    }
 }
 
+bool
+ThreadInterface::isNextRequestAnInstruction()
+{
+   if (_num_pending_app_requests == 0)
+      return true;
+
+   // An app request is due once all the instructions sent before it are in
+   ScopedLock sl(_lock);
+   return (_app_request_queue.front().first > _num_instructions_received);
+}
+
 AppRequest
 ThreadInterface::recvAppRequest()
 {
-   _request_semaphore.wait();
-
    _lock.acquire();
-   AppRequest app_request = _app_request_queue.front();
+   AppRequest app_request = _app_request_queue.front().second;
    _app_request_queue.pop();
    _lock.release();
+   __sync_fetch_and_sub(&_num_pending_app_requests, 1);
 
    LOG_PRINT("CoreID(%i): recvAppRequest(Type[%u])", _core->getId(), app_request.getType());
 
@@ -54,9 +146,7 @@ ThreadInterface::sendSimReply(UInt64 time, SimReply sim_reply)
    _core->getPerformanceModel()->updateTime(time);
 
    // Create an event that can accept further instructions
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << _core->getId();
-   EventResumeThread* event = new EventResumeThread(time, event_args);
+   EventResumeThread* event = new EventResumeThread(time, _core->getId());
    Event::processInOrder(event, _core->getId(), EventQueue::ORDERED);
 
    // Signal the App thread
@@ -75,6 +165,9 @@ ThreadInterface::sendSimInsReply(SimReply sim_reply)
 SimReply
 ThreadInterface::recvSimReply()
 {
+   // The sim thread may be waiting for the instructions that generate this reply
+   flushInstructions();
+
    // Wait for the Sim Thread
    _reply_semaphore.wait();
 
@@ -88,7 +181,44 @@ ThreadInterface::iterate()
    bool cont = true;
    while (cont)
    {
-      AppRequest app_request = recvAppRequest();
-      cont = app_request.process(_core);
+      waitForAppRequest();
+
+      // Process requests in the order the app thread sent them
+      if (isNextRequestAnInstruction())
+      {
+         InstructionRecord* instruction_record = _instruction_queue.front();
+         assert(instruction_record);
+
+         // The performance model resumes this thread with an event, unless the
+         // instruction completed right away (e.g., all its memory accesses hit in the L1)
+         PerformanceModel* performance_model = _core->getPerformanceModel();
+         bool completed = performance_model->handleInstruction(*instruction_record);
+         _instruction_queue.pop();
+         _num_instructions_received ++;
+         cont = false;
+
+         if (completed)
+         {
+            // Go on with the next instruction (if it is here already) instead of
+            // creating an event, as long as no other event of this core comes first
+            UInt64 cycle_count = performance_model->getCycleCount();
+            if ( performance_model->isL1HitFastPathEnabled() &&
+                 !_instruction_queue.empty() && isNextRequestAnInstruction() &&
+                 Sim()->getEventManager()->isSafeToSkipTo(_core->getId(), cycle_count) )
+            {
+               cont = true;
+            }
+            else
+            {
+               EventResumeThread* event = new EventResumeThread(cycle_count, _core->getId());
+               Event::processInOrder(event, _core->getId(), EventQueue::ORDERED);
+            }
+         }
+      }
+      else
+      {
+         AppRequest app_request = recvAppRequest();
+         cont = app_request.process(_core);
+      }
    }
 }
@@ -2,9 +2,12 @@
 
 #include <queue>
 using std::queue;
+using std::pair;
 #include "lock.h"
 #include "semaphore.h"
+#include "spsc_queue.h"
 #include "app_request.h"
+#include "instruction_record.h"
 
 class Core;
 
@@ -18,6 +21,10 @@ public:
    void iterate();
    // Send request from app thread to sim thread
    void sendAppRequest(AppRequest app_request);
+   // Send instruction from app thread to sim thread (batched, lock-free)
+   void sendInstruction(const InstructionRecord& instruction_record);
+   // Make all instructions sent so far visible to the sim thread
+   void flushInstructions();
    // Wait (in app thread) expecting a reply from the sim thread
    SimReply recvSimReply();
    // Send reply from sim thread to app thread
@@ -26,7 +33,15 @@ public:
    void sendSimInsReply(SimReply sim_reply);
 
 private:
-   queue<AppRequest> _app_request_queue;
+   // Each request is tagged with the number of instructions sent before it
+   queue<pair<UInt64,AppRequest> > _app_request_queue;
+   volatile UInt32 _num_pending_app_requests;
+   // Instructions are by far the most frequent request, so they bypass
+   // _app_request_queue and go through a single-producer/single-consumer queue
+   SPSCQueue<InstructionRecord> _instruction_queue;
+   UInt32 _instruction_batch_size;
+   UInt64 _num_instructions_sent;
+   UInt64 _num_instructions_received;
    SimReply _sim_reply;
 
    Core* _core;
@@ -35,7 +50,14 @@ private:
    Lock _lock;
    Semaphore _request_semaphore;
    Semaphore _reply_semaphore;
+   // Set by the sim thread before sleeping on _request_semaphore
+   volatile UInt32 _sim_thread_waiting;
    
-   // Wait (in sim thread) expecting a request from the app thread
+   // Wait (in sim thread) until the app thread has sent something
+   void waitForAppRequest();
+   bool isNextRequestAnInstruction();
+   // Wake up the sim thread (in app thread) if it is sleeping
+   void wakeUpSimThread();
+   // Receive a request (in sim thread) from the app thread
    AppRequest recvAppRequest();
 };
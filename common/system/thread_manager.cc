@@ -50,9 +50,7 @@ ThreadManager::onThreadStart(core_id_t core_id)
    LOG_PRINT("Initialized Thread to Core(%i)", core_id);
 
    // Initiate a service request to tell the sim thread to start processing on this core
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << core_id;
-   EventStartThread* event = new EventStartThread(0, event_args);
+   EventStartThread* event = new EventStartThread(0, core_id);
    Event::processInOrder(event, core_id, EventQueue::ORDERED);
    LOG_PRINT("Pushed START_THREAD event");
   
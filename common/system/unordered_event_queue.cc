@@ -13,19 +13,14 @@ UnorderedEventQueue::processEvents()
 {
    LOG_PRINT("UnorderedEventQueue(%i): processEvents() enter", getEventQueueManager()->getId());
    
-   _lock.acquire();
-   while(!_queue.empty())
+   // Events whose push() is still in progress are left for the next call;
+   // their producer signals this sim thread once the push is done
+   Event* event;
+   while ((event = _queue.pop()) != NULL)
    {
-      Event* event = _queue.front();
-      _queue.pop();
-      _lock.release();
-
       event->process();
       delete event;
-
-      _lock.acquire();
    }
-   _lock.release();
    
    LOG_PRINT("UnorderedEventQueue(%i): processEvents() exit", getEventQueueManager()->getId());
 }
@@ -37,11 +32,11 @@ UnorderedEventQueue::push(Event* event, bool is_locked)
          getEventQueueManager()->getId(), event, event->getType(), event->getTime(), is_locked ? "YES" : "NO");
 
    assert(!is_locked);
-   _lock.acquire();
    _queue.push(event);
-   _lock.release();
 
-   getEventQueueManager()->signalEvent();
+   // The queue may look empty to signalEvent() while the consumer is popping,
+   // so always wake up the sim thread
+   getEventQueueManager()->wakeUp();
    
    LOG_PRINT("UnorderedEventQueue(%i): push(Event[%p],Type[%u],Time[%llu]), is_locked(%s) exit", \
          getEventQueueManager()->getId(), event, event->getType(), event->getTime(), is_locked ? "YES" : "NO");
@@ -1,11 +1,11 @@
 #pragma once
 
-#include <queue>
-using std::queue;
-
 #include "event_queue.h"
-#include "lock.h"
+#include "event.h"
+#include "mpsc_queue.h"
 
+// Events pushed by any sim thread (or app thread) and processed (in FIFO order)
+// by the owning sim thread. Pushes are lock-free and never block the consumer
 class UnorderedEventQueue : public EventQueue
 {
    public:
@@ -14,12 +14,12 @@ class UnorderedEventQueue : public EventQueue
 
       void processEvents();
       void push(Event* event, bool is_locked = false);
-      void acquireLock() { _lock.acquire(); }
-      void releaseLock() { _lock.release(); }
+      // Nothing to lock: the producers never wait for each other or the consumer
+      void acquireLock() {}
+      void releaseLock() {}
 
       bool empty() { return _queue.empty(); }
 
    private:
-      queue<Event*> _queue;
-      Lock _lock;
+      MPSCQueue<Event> _queue;
 };
@@ -49,3 +49,34 @@ void CarbonDisableModels()
    // Acquire & Release a barrier again
    CarbonBarrierWait(&models_barrier);
 } 
+
+// Hybrid networks: send the packets on the detailed (finite-buffer) or on the fast models
+void CarbonEnableDetailedNetworkModels()
+{
+   // Acquire & Release a barrier
+   CarbonBarrierWait(&models_barrier);
+
+   if (Sim()->getCoreManager()->getCurrentCoreID() == 0)
+   {
+      fprintf(stderr, "[[Graphite]] --> [ Enabling Detailed Network Models ]\n");
+      Simulator::enableDetailedNetworkModels();
+   }
+
+   // Acquire & Release a barrier again
+   CarbonBarrierWait(&models_barrier);
+}
+
+void CarbonDisableDetailedNetworkModels()
+{
+   // Acquire & Release a barrier
+   CarbonBarrierWait(&models_barrier);
+
+   if (Sim()->getCoreManager()->getCurrentCoreID() == 0)
+   {
+      fprintf(stderr, "[[Graphite]] --> [ Disabling Detailed Network Models ]\n");
+      Simulator::disableDetailedNetworkModels();
+   }
+
+   // Acquire & Release a barrier again
+   CarbonBarrierWait(&models_barrier);
+}
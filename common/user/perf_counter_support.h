@@ -8,6 +8,8 @@ extern "C" {
 void CarbonInitModels(void);
 void CarbonEnableModels(void);
 void CarbonDisableModels(void);
+void CarbonEnableDetailedNetworkModels(void);
+void CarbonDisableDetailedNetworkModels(void);
 
 #ifdef __cplusplus
 }
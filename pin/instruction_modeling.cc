@@ -14,29 +14,22 @@ void handleInstruction(Instruction *instruction, bool atomic_memory_update, UInt
 
    if (core->getPerformanceModel()->isEnabled())
    {
-      UnstructuredBuffer* instruction_info = new UnstructuredBuffer();
-      
-      (*instruction_info) << instruction;
-      (*instruction_info) << atomic_memory_update;
+      InstructionRecord instruction_record(instruction, atomic_memory_update);
 
       va_list memory_args;
       va_start(memory_args, num_memory_args);
-      PerformanceModel::MemoryAccessList* memory_access_list = new PerformanceModel::MemoryAccessList();
       for (UInt32 i = 0; i < num_memory_args; i++)
       {
          IntPtr address = va_arg(memory_args, IntPtr);
          UInt32 size = va_arg(memory_args, UInt32);
         
-         memory_access_list->push_back(make_pair(address,size));
+         instruction_record.addMemoryAccess(address, size);
          LOG_PRINT("Address(0x%llx), Size(%u)", address, size);
       }
       va_end(memory_args);
 
-      (*instruction_info) << memory_access_list;
-
-      // Send request to sim thread
-      AppRequest app_request(AppRequest::HANDLE_INSTRUCTION, instruction_info);
-      Sim()->getThreadInterface(core->getId())->sendAppRequest(app_request);
+      // Send instruction to sim thread
+      Sim()->getThreadInterface(core->getId())->sendInstruction(instruction_record);
       
       // Increment the number of issued instructions
       core->getPerformanceModel()->incrTotalInstructionsIssued();
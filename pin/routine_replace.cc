@@ -44,6 +44,33 @@ void routineCallback(RTN rtn, void* v)
             IARG_END);
    }
 
+   // Enable/Disable Detailed Network Models
+   if (rtn_name == "CarbonEnableDetailedNetworkModels")
+   {
+      PROTO proto = PROTO_Allocate(PIN_PARG(void),
+            CALLINGSTD_DEFAULT,
+            "CarbonEnableDetailedNetworkModels",
+            PIN_PARG_END());
+
+      RTN_ReplaceSignature(rtn,
+            AFUNPTR(CarbonEnableDetailedNetworkModels),
+            IARG_PROTOTYPE, proto,
+            IARG_END);
+   }
+
+   if (rtn_name == "CarbonDisableDetailedNetworkModels")
+   {
+      PROTO proto = PROTO_Allocate(PIN_PARG(void),
+            CALLINGSTD_DEFAULT,
+            "CarbonDisableDetailedNetworkModels",
+            PIN_PARG_END());
+
+      RTN_ReplaceSignature(rtn,
+            AFUNPTR(CarbonDisableDetailedNetworkModels),
+            IARG_PROTOTYPE, proto,
+            IARG_END);
+   }
+
    // _start
    if (rtn_name == "_start")
    {
@@ -0,0 +1,296 @@
+#include <sys/time.h>
+#include <algorithm>
+#include "carbon_user.h"
+#include "simulator.h"
+#include "event_manager.h"
+#include "config.h"
+#include "utils.h"
+#include "lock.h"
+#include "semaphore.h"
+#include "min_heap.h"
+#include "calendar_queue.h"
+#include "event_engine.h"
+
+// Event engine microbenchmark.
+// Phase 1 measures the push/pop cost of the ordered event queues with the
+// classic 'hold' model (pop the earliest event, push one at time + increment).
+// Phase 2 runs chains of events through the event engine: each handler burns
+// a configurable number of cycles and pushes the next event of the chain,
+// either on the same core (time + [1,spread]) or on a random remote core
+// (time + lookahead + [0,spread)). Reports events/sec, the latency of
+// Event::processInOrder() (push), the delay from the push of an event to the
+// start of its handler (pop and dispatch by the EventManager/EventHeaps) and
+// the number of contended Lock acquires (if the simulator is built with
+// LOCK_CONTENTION_COUNTING = true in Makefile.config).
+
+// Configuration Parameters
+SInt32 _num_cores = 1;
+SInt32 _num_chains_per_core = 1;
+SInt32 _num_events_per_chain = 1000;
+SInt32 _time_spread = 10;
+SInt32 _handler_cost = 100;
+double _remote_fraction = 0.0;
+
+// Hold Benchmark Parameters
+const UInt32 HOLD_QUEUE_SIZE = 4096;
+const UInt32 HOLD_NUM_OPERATIONS = 1 << 20;
+
+// Per-core state (a core's events are processed by one sim thread at a time)
+vector<RandNum*> _rand_num_list;
+vector<vector<UInt64> > _push_latency_list;
+vector<vector<UInt64> > _dispatch_latency_list;
+
+// Synchronization
+Semaphore _semaphore;
+
+// Keeps the handler busy loop from being optimized away
+volatile UInt64 _handler_work;
+
+int main(int argc, char* argv[])
+{
+   // Initialize the Simulator
+   CarbonStartSim(argc, argv);
+
+   // Read Configuration Parameters
+   readConfigurationParameters(argc, argv);
+
+   runHoldBenchmark();
+
+   // Enable all the simulation models
+   Simulator::__enablePerformanceModels();
+
+   runEventStormBenchmark();
+
+   // Disable all the simulation models
+   Simulator::__disablePerformanceModels();
+
+   CarbonStopSim();
+
+   return 0;
+}
+
+void readConfigurationParameters(int argc, char* argv[])
+{
+   // Read Command Line Arguments
+   for (SInt32 i = 1; i < argc-1; i += 2)
+   {
+      if (string(argv[i]) == "-t")
+         _num_cores = atoi(argv[i+1]);
+      else if (string(argv[i]) == "-e")
+         _num_chains_per_core = atoi(argv[i+1]);
+      else if (string(argv[i]) == "-n")
+         _num_events_per_chain = atoi(argv[i+1]);
+      else if (string(argv[i]) == "-s")
+         _time_spread = atoi(argv[i+1]);
+      else if (string(argv[i]) == "-w")
+         _handler_cost = atoi(argv[i+1]);
+      else if (string(argv[i]) == "-r")
+         _remote_fraction = atof(argv[i+1]);
+      else if (string(argv[i]) == "-c") // Simulator arguments
+         break;
+      else if (string(argv[i]) == "-h")
+      {
+         printHelpMessage();
+         exit(0);
+      }
+      else
+      {
+         fprintf(stderr, "** ERROR **\n");
+         printHelpMessage();
+         exit(-1);
+      }
+   }
+
+   LOG_ASSERT_ERROR(_num_cores > 0 && _num_cores <= (SInt32) Config::getSingleton()->getTotalCores(),
+         "num_cores(%i), total cores(%u)", _num_cores, Config::getSingleton()->getTotalCores());
+   LOG_ASSERT_ERROR(_num_chains_per_core > 0 && _num_events_per_chain > 0 && _time_spread > 0,
+         "num_chains_per_core(%i), num_events_per_chain(%i), time_spread(%i)",
+         _num_chains_per_core, _num_events_per_chain, _time_spread);
+   LOG_ASSERT_ERROR(_remote_fraction >= 0.0 && _remote_fraction <= 1.0, "remote_fraction(%f)", _remote_fraction);
+
+   printf("Num Cores(%i)\nNum Chains per Core(%i)\nNum Events per Chain(%i)\nTime Spread(%i)\nHandler Cost(%i)\nRemote Fraction(%f)\n\n",
+         _num_cores, _num_chains_per_core, _num_events_per_chain, _time_spread, _handler_cost, _remote_fraction);
+}
+
+void printHelpMessage()
+{
+   fprintf(stderr, "[Usage]: ./event_engine -t <arg1> -e <arg2> -n <arg3> -s <arg4> -w <arg5> -r <arg6>\n");
+   fprintf(stderr, "where <arg1> = Number of Cores (default 1)\n");
+   fprintf(stderr, "      <arg2> = Number of Event Chains per Core (default 1)\n");
+   fprintf(stderr, "      <arg3> = Number of Events per Chain (default 1000)\n");
+   fprintf(stderr, "      <arg4> = Time Spread between successive Events in a Chain (default 10)\n");
+   fprintf(stderr, "      <arg5> = Handler Cost in loop iterations (default 100)\n");
+   fprintf(stderr, "      <arg6> = Fraction of Events pushed to a Remote Core (default 0.0)\n");
+}
+
+void runHoldBenchmark()
+{
+   UInt32 calendar_queue_num_buckets = 0;
+   try
+   {
+      calendar_queue_num_buckets = Sim()->getCfg()->getInt("general/calendar_queue_num_buckets", 1024);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read general/calendar_queue_num_buckets from the cfg file");
+   }
+
+   MinHeap min_heap;
+   runHoldBenchmark(min_heap, "MinHeap");
+   CalendarQueue calendar_queue(calendar_queue_num_buckets);
+   runHoldBenchmark(calendar_queue, "CalendarQueue");
+}
+
+template <class Queue>
+void runHoldBenchmark(Queue& queue, const char* name)
+{
+   RandNum rand_num(0, _time_spread);
+   
+   for (UInt32 i = 0; i < HOLD_QUEUE_SIZE; i++)
+      queue.insert((UInt64) rand_num.next());
+
+   vector<UInt64> push_latency_list;
+   vector<UInt64> pop_latency_list;
+   push_latency_list.reserve(HOLD_NUM_OPERATIONS);
+   pop_latency_list.reserve(HOLD_NUM_OPERATIONS);
+
+   for (UInt32 i = 0; i < HOLD_NUM_OPERATIONS; i++)
+   {
+      UInt64 start_time = rdtscll();
+      UInt64 key = queue.extractMin().first;
+      UInt64 pop_time = rdtscll();
+      queue.insert(key + 1 + (UInt64) rand_num.next());
+      UInt64 push_time = rdtscll();
+      
+      pop_latency_list.push_back(pop_time - start_time);
+      push_latency_list.push_back(push_time - pop_time);
+   }
+   
+   while (queue.size() > 0)
+      queue.extractMin();
+
+   printf("Hold(%s): ", name);
+   printLatencySummary("Push", push_latency_list);
+   printf(", ");
+   printLatencySummary("Pop", pop_latency_list);
+   printf("\n");
+}
+
+void runEventStormBenchmark()
+{
+   for (SInt32 i = 0; i < _num_cores; i++)
+   {
+      _rand_num_list.push_back(new RandNum(0, 1, i));
+      _push_latency_list.push_back(vector<UInt64>());
+      _push_latency_list.back().reserve(_num_chains_per_core * _num_events_per_chain);
+      _dispatch_latency_list.push_back(vector<UInt64>());
+      _dispatch_latency_list.back().reserve(_num_chains_per_core * _num_events_per_chain);
+   }
+
+   Event::registerHandler(EVENT_CHAIN, processChainEvent);
+   
+   UInt64 num_contended_acquires = Lock::getNumContendedAcquires();
+   struct timeval start_time;
+   gettimeofday(&start_time, NULL);
+
+   // Create the first event of every chain
+   for (SInt32 i = 0; i < _num_cores; i++)
+   {
+      for (SInt32 j = 0; j < _num_chains_per_core; j++)
+         pushChainEvent(j % _time_spread, i, _num_events_per_chain - 1);
+   }
+
+   // Wait for all chains to finish
+   for (SInt32 i = 0; i < _num_cores * _num_chains_per_core; i++)
+      _semaphore.wait();
+   
+   struct timeval end_time;
+   gettimeofday(&end_time, NULL);
+   num_contended_acquires = Lock::getNumContendedAcquires() - num_contended_acquires;
+
+   Event::unregisterHandler(EVENT_CHAIN);
+   
+   double elapsed_time = (end_time.tv_sec - start_time.tv_sec) + (end_time.tv_usec - start_time.tv_usec) / 1.0e6;
+   UInt64 total_events = ((UInt64) _num_cores) * _num_chains_per_core * _num_events_per_chain;
+
+   vector<UInt64> push_latency_list;
+   vector<UInt64> dispatch_latency_list;
+   for (SInt32 i = 0; i < _num_cores; i++)
+   {
+      push_latency_list.insert(push_latency_list.end(), _push_latency_list[i].begin(), _push_latency_list[i].end());
+      dispatch_latency_list.insert(dispatch_latency_list.end(), _dispatch_latency_list[i].begin(), _dispatch_latency_list[i].end());
+      delete _rand_num_list[i];
+   }
+
+   SInt32 num_sim_threads = Config::getSingleton()->getTotalSimThreads();
+   printf("EventEngine: Sim Threads(%i), Cores(%i), Spread(%i), Handler Cost(%i), Remote Fraction(%f), "
+          "Events(%llu), Time(%f sec), Events/sec(%.0f), ",
+          num_sim_threads, _num_cores, _time_spread, _handler_cost, _remote_fraction,
+          (long long unsigned int) total_events, elapsed_time, total_events / elapsed_time);
+   // Needs LOCK_CONTENTION_COUNTING = true in Makefile.config
+   if (Lock::isContentionCounted())
+      printf("Contended Lock Acquires(%llu), ", (long long unsigned int) num_contended_acquires);
+   else
+      printf("Contended Lock Acquires(NA), ");
+   printLatencySummary("Push", push_latency_list);
+   printf(", ");
+   printLatencySummary("Push-to-Handler", dispatch_latency_list);
+   printf("\n");
+}
+
+void processChainEvent(Event* event)
+{
+   const ChainArgs& args = TypedEvent<ChainArgs>::getTypedArgs(event);
+   core_id_t core_id = args._core_id;
+   _dispatch_latency_list[core_id].push_back(rdtscll() - args._push_tsc);
+
+   UInt64 work = 0;
+   for (SInt32 i = 0; i < _handler_cost; i++)
+      work += i;
+   _handler_work = work;
+
+   if (args._num_remaining_events == 0)
+   {
+      _semaphore.signal();
+      return;
+   }
+
+   RandNum* rand_num = _rand_num_list[core_id];
+   UInt64 time = event->getTime();
+   UInt64 increment = (UInt64) (rand_num->next() * _time_spread);
+   UInt64 start_time = rdtscll();
+   if (rand_num->next() < _remote_fraction)
+   {
+      // Other cores may be processing events up to (global_time + lookahead)
+      core_id_t remote_core_id = (core_id_t) (rand_num->next() * _num_cores);
+      UInt64 lookahead = Sim()->getEventManager()->getLookahead();
+      pushChainEvent(time + std::max(lookahead, (UInt64) 1) + increment, remote_core_id, args._num_remaining_events - 1);
+   }
+   else
+   {
+      pushChainEvent(time + 1 + increment, core_id, args._num_remaining_events - 1);
+   }
+   _push_latency_list[core_id].push_back(rdtscll() - start_time);
+}
+
+void pushChainEvent(UInt64 time, core_id_t core_id, UInt32 num_remaining_events)
+{
+   ChainArgs args = {core_id, num_remaining_events, rdtscll()};
+   Event::processInOrder(new TypedEvent<ChainArgs>(EVENT_CHAIN, time, args), core_id, EventQueue::ORDERED);
+}
+
+void printLatencySummary(const char* name, vector<UInt64>& latency_list)
+{
+   if (latency_list.empty())
+   {
+      printf("%s Latency (cycles): none", name);
+      return;
+   }
+
+   sort(latency_list.begin(), latency_list.end());
+   size_t size = latency_list.size();
+   printf("%s Latency (cycles): p50(%llu), p90(%llu), p99(%llu)", name,
+         (long long unsigned int) latency_list[size / 2],
+         (long long unsigned int) latency_list[(size * 9) / 10],
+         (long long unsigned int) latency_list[(size * 99) / 100]);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "event.h"
+#include "fixed_types.h"
+#include "rand_num.h"
+
+// Event types above the ones used by the simulator (and the sim thread manager)
+#define EVENT_CHAIN                          2000
+
+// Arguments of an EVENT_CHAIN event
+struct ChainArgs
+{
+   core_id_t _core_id;
+   UInt32 _num_remaining_events;
+   // rdtscll() when the event was pushed
+   UInt64 _push_tsc;
+};
+
+void readConfigurationParameters(int argc, char* argv[]);
+void printHelpMessage();
+
+// Phase 1: push/pop cost of the ordered queues (MinHeap, CalendarQueue) in isolation
+void runHoldBenchmark();
+template <class Queue> void runHoldBenchmark(Queue& queue, const char* name);
+
+// Phase 2: chains of events through the event engine (sim threads, heaps, wakeups)
+void runEventStormBenchmark();
+void processChainEvent(Event* event);
+void pushChainEvent(UInt64 time, core_id_t core_id, UInt32 num_remaining_events);
+
+void printLatencySummary(const char* name, vector<UInt64>& latency_list);
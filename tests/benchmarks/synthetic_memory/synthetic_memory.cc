@@ -475,13 +475,11 @@ SyntheticCore::initiateMemoryAccess(UInt64 time, IntPtr address, MemoryOperation
    SInt32 buffer = 0;
 
    // Initiate Memory Access Event
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << _core
-                 << _last_memory_access_id ++
-                 << MemComponent::L1_DCACHE << Core::NONE << core_mem_op
-                 << address << &buffer << sizeof(buffer)
-                 << true;
-   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(time, event_args);
+   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(time,
+                                                                    _core, _last_memory_access_id ++,
+                                                                    MemComponent::L1_DCACHE, Core::NONE, core_mem_op,
+                                                                    address, (Byte*) &buffer, sizeof(buffer),
+                                                                    true);
    Event::processInOrder(event, _core->getId(), EventQueue::ORDERED);
 }
 
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <time.h>
 #include <cmath>
+#include <fstream>
 #include "simulator.h"
 #include "core_manager.h"
 #include "event_manager.h"
@@ -35,6 +36,19 @@ SInt32 _num_cores_with_measurement_phase_completed = 0;
 // Type of each packet (so as to send on USER_2 network)
 PacketType _packet_type = USER_2;
 
+// Load-Latency Sweep: one simulation per (network, traffic pattern, offered load)
+bool _sweep_enabled = false;
+// Output CSV file
+string _sweep_output_filename;
+// Offered load increment between two simulations (in packets per core per cycle)
+double _sweep_load_step = 0.02;
+// A simulation is saturated if the accepted throughput is below this fraction of the offered load
+double _sweep_saturation_threshold = 0.9;
+// Time at which the next simulation starts (after the network has drained)
+UInt64 _simulation_start_time = 0;
+// Idle cycles between two simulations (lets the last credits reach the senders)
+UInt64 _simulation_gap = 1000;
+
 vector<SyntheticCore*> _synthetic_core_list;
 UInt64 _quantum = 100;
 
@@ -68,6 +82,13 @@ int main(int argc, char* argv[])
          _broadcast_packet_size = (SInt32) atoi(argv[i+1]);
       else if (string(argv[i]) == "-N")
          _total_packets = (UInt64) atoi(argv[i+1]);
+      else if (string(argv[i]) == "-sweep")
+      {
+         _sweep_enabled = true;
+         _sweep_output_filename = string(argv[i+1]);
+      }
+      else if (string(argv[i]) == "-ls")
+         _sweep_load_step = (double) atof(argv[i+1]);
       else if (string(argv[i]) == "-c") // Simulator arguments
          break;
       else if (string(argv[i]) == "-h")
@@ -88,6 +109,29 @@ int main(int argc, char* argv[])
    _num_cores = (SInt32) Config::getSingleton()->getTotalCores();
    log("Num Application Cores(%i)", _num_cores);
 
+   if (_sweep_enabled)
+   {
+      runLoadLatencySweep();
+   }
+   else
+   {
+      runSimulation();
+      // Delete Synthetic Core Objs
+      // deinitializeSyntheticCores();
+   }
+
+   Simulator::__disablePerformanceModels();
+   
+   printf("\n[SYNTHETIC NETWORK BENCHMARK]: Finished Test successfully\n\n");
+
+   CarbonStopSim();
+ 
+   return 0;
+}
+
+// Simulates the current (network, traffic pattern, offered load) till all packets are received
+void runSimulation()
+{
    // Initialize Synthetic Core Objs
    initializeSyntheticCores();
 
@@ -98,7 +142,7 @@ int main(int argc, char* argv[])
    Event::registerHandler(EVENT_START_SIMULATION, processStartSimulationEvent);
    
    // Push First Event
-   Event* start_simulation_event = new Event((Event::Type) EVENT_START_SIMULATION, 0 /* time */);
+   Event* start_simulation_event = new Event((Event::Type) EVENT_START_SIMULATION, _simulation_start_time /* time */);
    Event::processInOrder(start_simulation_event, 0 /* core_id */, EventQueue::ORDERED);
 
    // Wait till all packets are sent and received
@@ -109,17 +153,116 @@ int main(int argc, char* argv[])
    unregisterAsyncNetRecvHandler();
    Event::unregisterHandler(EVENT_NET_SEND);
    unregisterNetPacketInjectorExitHandler();
+}
 
-   // Delete Synthetic Core Objs
-   // deinitializeSyntheticCores();
+// Steps the offered load from _sweep_load_step till saturation for every traffic pattern
+// on every user network with a finite buffer model, in a single simulator process
+void runLoadLatencySweep()
+{
+   ofstream sweep_output(_sweep_output_filename.c_str());
+   LOG_ASSERT_ERROR(sweep_output.good(), "Could not open %s", _sweep_output_filename.c_str());
+   sweep_output << "network,network_model,traffic_pattern,offered_load,offered_flit_load,"
+                << "accepted_flit_throughput,average_latency,p99_latency,saturated" << endl;
 
-   Simulator::__disablePerformanceModels();
-   
-   printf("\n[SYNTHETIC NETWORK BENCHMARK]: Finished Test successfully\n\n");
+   PacketType packet_type_list[] = {USER_1, USER_2};
+   string network_model_cfg_list[] = {"network/user_model_1", "network/user_model_2"};
+   for (SInt32 n = 0; n < 2; n++)
+   {
+      _packet_type = packet_type_list[n];
+      NetworkModel* network_model = Sim()->getCoreManager()->getCoreFromID(0)->getNetwork()->getNetworkModelFromPacketType(_packet_type);
+      if (!network_model->isFiniteBuffer())
+         continue;
+      string network_model_name = Sim()->getCfg()->getString(network_model_cfg_list[n]);
 
-   CarbonStopSim();
- 
-   return 0;
+      for (SInt32 t = 0; t < NUM_NETWORK_TRAFFIC_TYPES; t++)
+      {
+         _traffic_pattern_type = (NetworkTrafficType) t;
+         if (!isTrafficPatternSupported(_traffic_pattern_type))
+         {
+            logimp("Skipping traffic pattern %s on %i cores", getTrafficPatternName(_traffic_pattern_type).c_str(), _num_cores);
+            continue;
+         }
+
+         bool saturated = false;
+         for (SInt32 step = 1; !saturated && ((step * _sweep_load_step) <= 1.0); step++)
+         {
+            _offered_load = step * _sweep_load_step;
+            logimp("Sweep: Network(%s), Traffic Pattern(%s), Offered Load(%g)",
+                   network_model->getNetworkName().c_str(), getTrafficPatternName(_traffic_pattern_type).c_str(), _offered_load);
+
+            // Reset the network counters
+            for (SInt32 i = 0; i < _num_cores; i++)
+               Sim()->getCoreManager()->getCoreFromID(i)->getNetwork()->getNetworkModelFromPacketType(_packet_type)->reset();
+            _num_cores_with_warmup_phase_completed = 0;
+            _num_cores_with_measurement_phase_completed = 0;
+
+            runSimulation();
+
+            saturated = outputSweepPoint(sweep_output, network_model->getNetworkName(), network_model_name);
+            deinitializeSyntheticCores();
+         }
+      }
+   }
+
+   sweep_output.close();
+}
+
+// Writes one line of the sweep CSV, returns true if the network is saturated
+bool outputSweepPoint(ostream& out, string network_name, string network_model_name)
+{
+   UInt64 total_packets_received = 0;
+   UInt64 total_packet_latency = 0;
+   double total_throughput = 0.0;
+   bool measurement_completed = true;
+   vector<UInt64> latency_histogram;
+   UInt64 last_event_time = _simulation_start_time;
+   for (SInt32 i = 0; i < _num_cores; i++)
+   {
+      SyntheticCore* synthetic_core = _synthetic_core_list[i];
+      measurement_completed = measurement_completed && synthetic_core->isMeasurementPhaseCompleted();
+      total_packets_received += synthetic_core->getTotalPacketsReceived();
+      total_packet_latency += synthetic_core->getTotalPacketLatency();
+      total_throughput += synthetic_core->getSustainedThroughput();
+      last_event_time = max<UInt64>(last_event_time, synthetic_core->getLastEventTime());
+
+      const vector<UInt64>& core_latency_histogram = synthetic_core->getLatencyHistogram();
+      latency_histogram.resize(core_latency_histogram.size(), 0);
+      for (UInt32 j = 0; j < core_latency_histogram.size(); j++)
+         latency_histogram[j] += core_latency_histogram[j];
+   }
+   // The next simulation starts after the network has drained
+   _simulation_start_time = last_event_time + _simulation_gap;
+
+   // Offered load (in flits per core per cycle)
+   FiniteBufferNetworkModel* network_model = (FiniteBufferNetworkModel*)
+         Sim()->getCoreManager()->getCoreFromID(0)->getNetwork()->getNetworkModelFromPacketType(_packet_type);
+   NetPacket unicast_packet(0, _packet_type, _unicast_packet_size, NULL);
+   NetPacket broadcast_packet(0, _packet_type, _broadcast_packet_size, NULL);
+   double offered_flit_load = _offered_load *
+         ( (1 - _fraction_broadcasts) * network_model->computeSerializationLatency(&unicast_packet) +
+           _fraction_broadcasts * network_model->computeSerializationLatency(&broadcast_packet) );
+   double accepted_throughput = total_throughput / _num_cores;
+
+   double average_latency = (total_packets_received > 0) ?
+                            ((double) total_packet_latency) / total_packets_received : 0.0;
+   UInt64 p99_latency = 0;
+   UInt64 num_samples = 0;
+   for ( ; p99_latency < latency_histogram.size(); p99_latency++)
+   {
+      num_samples += latency_histogram[p99_latency];
+      if (num_samples >= 0.99 * total_packets_received)
+         break;
+   }
+
+   bool saturated = (!measurement_completed) || (total_packets_received == 0) ||
+                    (accepted_throughput < (_sweep_saturation_threshold * offered_flit_load));
+
+   out << network_name << "," << network_model_name << ","
+       << getTrafficPatternName(_traffic_pattern_type) << ","
+       << _offered_load << "," << offered_flit_load << ","
+       << accepted_throughput << "," << average_latency << "," << p99_latency << ","
+       << (saturated ? 1 : 0) << endl;
+   return saturated;
 }
 
 void outputSummary(void* callback_obj, ostream& out)
@@ -164,7 +307,7 @@ void initializeSyntheticCores()
 
       // Populate the core specific structure
       Core* core = Sim()->getCoreManager()->getCoreFromID(i);
-      _synthetic_core_list[i] = new SyntheticCore(core, send_vec, receive_vec);
+      _synthetic_core_list[i] = new SyntheticCore(core, send_vec, receive_vec, _simulation_start_time);
    }
 }
 
@@ -181,7 +324,7 @@ void processStartSimulationEvent(Event* event)
    for (SInt32 i = 0; i < _num_cores; i++)
    {
       // Push the first events
-      _synthetic_core_list[i]->netSend(0 /* time */);
+      _synthetic_core_list[i]->netSend(event->getTime());
    }
 }
 
@@ -267,13 +410,16 @@ void waitForCompletion()
 
 void printHelpMessage()
 {
-   fprintf(stderr, "[Usage]: ./synthetic_network_traffic_generator -p <arg1> -l <arg2> -b <arg3> -us <arg4> -bs <arg5> -N <arg6>\n");
+   fprintf(stderr, "[Usage]: ./synthetic_network_traffic_generator -p <arg1> -l <arg2> -b <arg3> -us <arg4> -bs <arg5> -N <arg6> -sweep <arg7> -ls <arg8>\n");
    fprintf(stderr, "where <arg1> = Network Traffic Pattern Type (uniform_random, bit_complement, shuffle, transpose, tornado, nearest_neighbor) (default uniform_random)\n");
    fprintf(stderr, " and  <arg2> = Number of Packets injected into the Network per Core per Cycle (default 0.1)\n");
    fprintf(stderr, " and  <arg3> = Fraction of Broadcasts among Packets sent (default 0.0)\n");
    fprintf(stderr, " and  <arg4> = Payload Size of each Unicast Packet in Bytes (default 8)\n");
    fprintf(stderr, " and  <arg5> = Payload Size of each Broadcast Packet in Bytes (default 8)\n");
    fprintf(stderr, " and  <arg6> = Total Number of Packets injected into the Network per Core (default 10000)\n");
+   fprintf(stderr, " and  <arg7> = Load-Latency Sweep Output CSV File - sweeps the offered load till saturation for all traffic patterns\n");
+   fprintf(stderr, "               on all user networks with a finite buffer model (-p and -l are ignored) (default: no sweep)\n");
+   fprintf(stderr, " and  <arg8> = Offered Load Increment of the Sweep (default 0.02)\n");
 }
 
 void logimp(const char* fmt, ...)
@@ -298,7 +444,8 @@ void log(const char* fmt, ...)
 #endif
 }
 
-SyntheticCore::SyntheticCore(Core* core, const vector<int>& send_vec, const vector<int>& receive_vec)
+SyntheticCore::SyntheticCore(Core* core, const vector<int>& send_vec, const vector<int>& receive_vec,
+                             UInt64 start_time)
    : _core(core)
    , _send_vec(send_vec)
    , _receive_vec(receive_vec)
@@ -307,10 +454,14 @@ SyntheticCore::SyntheticCore(Core* core, const vector<int>& send_vec, const vect
    , _total_packets_received(0)
    , _total_flits_received(0)
    , _total_packet_latency(0)
-   , _last_packet_send_time(0)
-   , _last_packet_recv_time(0)
+   , _last_packet_send_time(start_time)
+   , _last_packet_recv_time(start_time)
+   , _last_event_time(start_time)
    , _warmup_phase_enabled(false)
    , _measurement_phase_enabled(false)
+   , _measurement_phase_completed(false)
+   // Only the load-latency sweep reads the histogram
+   , _latency_histogram(_sweep_enabled ? (_max_histogram_latency + 1) : 0, 0)
    , _measurement_phase_start_time(0)
    , _measurement_phase_end_time(0)
    , _cooldown_phase_enabled(false)
@@ -368,6 +519,7 @@ void SyntheticCore::netSend(UInt64 net_packet_injector_exit_time)
          SInt32 packet_size = (receiver == NetPacket::BROADCAST) ? _broadcast_packet_size : _unicast_packet_size;
 
          _last_packet_send_time = time;
+         _last_event_time = max<UInt64>(_last_event_time, time);
          
          // Construct packet
          Byte data[packet_size];
@@ -392,6 +544,7 @@ void SyntheticCore::netRecv(const NetPacket& net_packet)
    LOG_PRINT("Synthetic Core(%i): netRecv(%llu)", _core->getId(), net_packet.time);
 
    logNetRecv(net_packet.time);
+   _last_event_time = max<UInt64>(_last_event_time, net_packet.time);
 
    // Sample Latency
    UInt64 packet_latency = net_packet.time - net_packet.start_time;
@@ -415,6 +568,8 @@ void SyntheticCore::netRecv(const NetPacket& net_packet)
       _total_packets_received ++;
       _total_flits_received += _network_model->computeSerializationLatency(&net_packet);
       _total_packet_latency += packet_latency;
+      if (_sweep_enabled)
+         _latency_histogram[min<UInt64>(packet_latency, _max_histogram_latency)] ++;
    }
 }
 
@@ -500,6 +655,7 @@ void SyntheticCore::startMeasurementPhase(UInt64 time)
 bool SyntheticCore::endMeasurementPhase(UInt64 time)
 {
    _measurement_phase_enabled = false;
+   _measurement_phase_completed = true;
    _measurement_phase_end_time = time;
    _measurement_batch_list.clear();
 
@@ -691,6 +847,14 @@ void SyntheticCore::logNetRecv(UInt64 time)
    }
 }
 
+double SyntheticCore::getSustainedThroughput()
+{
+   if (!_measurement_phase_completed)
+      return 0.0;
+   UInt64 measurement_phase_time = _measurement_phase_end_time - _measurement_phase_start_time;
+   return (measurement_phase_time > 0) ? ((double) _total_flits_received) / measurement_phase_time : 0.0;
+}
+
 void SyntheticCore::outputSummary(ostream& out)
 {
    out << "Synthetic Core Summary: " << endl;
@@ -14,7 +14,8 @@ using std::string;
 class SyntheticCore
 {
 public:
-   SyntheticCore(Core* core, const vector<int>& send_vec, const vector<int>& receive_vec);
+   SyntheticCore(Core* core, const vector<int>& send_vec, const vector<int>& receive_vec,
+                 UInt64 start_time = 0);
    ~SyntheticCore();
 
    Core* getCore() { return _core; }
@@ -22,6 +23,15 @@ public:
    void netRecv(const NetPacket& net_packet);
    void outputSummary(ostream& out);
 
+   // Measurement Phase Results (for the load-latency sweep)
+   bool isMeasurementPhaseCompleted() { return _measurement_phase_completed; }
+   UInt64 getTotalPacketsReceived() { return _total_packets_received; }
+   UInt64 getTotalPacketLatency() { return _total_packet_latency; }
+   double getSustainedThroughput();
+   const vector<UInt64>& getLatencyHistogram() { return _latency_histogram; }
+   // Time of the last packet sent or received (in any phase)
+   UInt64 getLastEventTime() { return _last_event_time; }
+
 private:
    class Batch
    {
@@ -48,6 +58,7 @@ private:
    // For error-checking
    UInt64 _last_packet_send_time;
    UInt64 _last_packet_recv_time;
+   UInt64 _last_event_time;
 
    // -- Warmup Phase
    bool _warmup_phase_enabled;
@@ -60,6 +71,11 @@ private:
 
    // -- Measurement Phase
    bool _measurement_phase_enabled;
+   bool _measurement_phase_completed;
+   // Latency of each packet received (the last entry counts all latencies >= _max_histogram_latency)
+   // Empty unless the load-latency sweep is enabled
+   static const UInt64 _max_histogram_latency = 10000;
+   vector<UInt64> _latency_histogram;
    static const UInt64 _num_measurement_batches = 30;
    static const UInt64 _batch_size_increment = 1000;
    UInt64 _curr_measurement_batch_size;
@@ -109,6 +125,10 @@ enum NetworkTrafficType
    NUM_NETWORK_TRAFFIC_TYPES
 };
 
+void runSimulation();
+void runLoadLatencySweep();
+bool outputSweepPoint(ostream& out, string network_name, string network_model_name);
+
 void initializeSyntheticCores();
 void deinitializeSyntheticCores();
 
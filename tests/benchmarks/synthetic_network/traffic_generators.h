@@ -1,6 +1,8 @@
 #pragma once
 
 NetworkTrafficType parseTrafficPattern(string traffic_pattern);
+string getTrafficPatternName(NetworkTrafficType traffic_pattern_type);
+bool isTrafficPatternSupported(NetworkTrafficType traffic_pattern_type);
 void uniformRandomTrafficGenerator(int core_id, vector<int>& send_vec, vector<int>& receive_vec);
 void bitComplementTrafficGenerator(int core_id, vector<int>& send_vec, vector<int>& receive_vec);
 void shuffleTrafficGenerator(int core_id, vector<int>& send_vec, vector<int>& receive_vec);
@@ -35,6 +37,52 @@ NetworkTrafficType parseTrafficPattern(string traffic_pattern)
    }
 }
 
+string getTrafficPatternName(NetworkTrafficType traffic_pattern_type)
+{
+   switch (traffic_pattern_type)
+   {
+      case UNIFORM_RANDOM:
+         return "uniform_random";
+      case BIT_COMPLEMENT:
+         return "bit_complement";
+      case SHUFFLE:
+         return "shuffle";
+      case TRANSPOSE:
+         return "transpose";
+      case TORNADO:
+         return "tornado";
+      case NEAREST_NEIGHBOR:
+         return "nearest_neighbor";
+      default:
+         assert(false);
+         return "";
+   }
+}
+
+// Can the traffic pattern be generated for _num_cores cores ?
+bool isTrafficPatternSupported(NetworkTrafficType traffic_pattern_type)
+{
+   switch (traffic_pattern_type)
+   {
+      case BIT_COMPLEMENT:
+      case SHUFFLE:
+         return isPower2(_num_cores);
+      case TRANSPOSE:
+      case TORNADO:
+      case NEAREST_NEIGHBOR:
+         {
+            // Needs a complete mesh (a square one for transpose)
+            int mesh_width = (int) sqrt((float) _num_cores);
+            int mesh_height = (int) ceil(1.0 * _num_cores / mesh_width);
+            if (traffic_pattern_type == TRANSPOSE)
+               return (mesh_width == mesh_height) && (_num_cores == (mesh_width * mesh_height));
+            return (_num_cores == (mesh_width * mesh_height));
+         }
+      default:
+         return true;
+   }
+}
+
 void uniformRandomTrafficGenerator(int core_id, vector<int>& send_vec, vector<int>& receive_vec)
 {
    // Generate Random Numbers using Linear Congruential Generator
@@ -0,0 +1,212 @@
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "address_hash_map.h"
+
+#define NUM_WRAP_AROUND_TRIALS   1000
+#define NUM_RANDOM_OPERATIONS    200000
+#define NUM_RANDOM_ADDRESSES     4096
+
+typedef AddressHashMap<UInt64> TestMap;
+typedef map<IntPtr,UInt64> ReferenceMap;
+
+UInt32 num_errors = 0;
+
+// Access to the table layout (a friend of AddressHashMap)
+class AddressHashMapTest
+{
+   public:
+      static UInt32 getCapacity(const TestMap& test_map) { return test_map.getCapacity(); }
+      static UInt32 getHomeIndex(const TestMap& test_map, IntPtr address) { return test_map.getHomeIndex(address); }
+};
+
+// Checks that 'test_map' holds exactly the (address, value) pairs of 'reference_map',
+// probing the addresses in 'address_list' (which includes absent ones)
+void checkContents(TestMap& test_map, ReferenceMap& reference_map, const vector<IntPtr>& address_list)
+{
+   if (test_map.size() != reference_map.size())
+   {
+      printf("Size Mismatch: AddressHashMap(%u), map(%u)\n", test_map.size(), (UInt32) reference_map.size());
+      num_errors ++;
+   }
+   for (UInt32 i = 0; i < address_list.size(); i++)
+   {
+      UInt64* value = test_map.find(address_list[i]);
+      ReferenceMap::iterator it = reference_map.find(address_list[i]);
+      if ((value == NULL) != (it == reference_map.end()))
+      {
+         printf("Find(%#llx): %s in AddressHashMap, %s in map\n", (long long unsigned int) address_list[i],
+               value ? "present" : "absent", (it != reference_map.end()) ? "present" : "absent");
+         num_errors ++;
+      }
+      else if (value && (*value != it->second))
+      {
+         printf("Find(%#llx): AddressHashMap(%llu), map(%llu)\n", (long long unsigned int) address_list[i],
+               (long long unsigned int) *value, (long long unsigned int) it->second);
+         num_errors ++;
+      }
+   }
+}
+
+void insert(TestMap& test_map, ReferenceMap& reference_map, IntPtr address, UInt64 value)
+{
+   bool inserted = test_map.insert(address, value);
+   bool reference_inserted = reference_map.insert(make_pair(address, value)).second;
+   if (inserted != reference_inserted)
+   {
+      printf("Insert(%#llx): AddressHashMap(%i), map(%i)\n", (long long unsigned int) address, inserted, reference_inserted);
+      num_errors ++;
+   }
+}
+
+void erase(TestMap& test_map, ReferenceMap& reference_map, IntPtr address)
+{
+   bool erased = test_map.erase(address);
+   bool reference_erased = (reference_map.erase(address) == 1);
+   if (erased != reference_erased)
+   {
+      printf("Erase(%#llx): AddressHashMap(%i), map(%i)\n", (long long unsigned int) address, erased, reference_erased);
+      num_errors ++;
+   }
+}
+
+// Probe chains that wrap around the end of the table: addresses whose home is
+// one of the last slots share a chain that continues at slot 0, where addresses
+// whose home is slot 0 or 1 get displaced too. Erasing in any order must keep
+// every remaining address reachable
+void testWrapAround()
+{
+   const UInt32 capacity = 64;
+   TestMap probe_map(capacity);
+
+   // Pick the addresses by home slot (the capacity does not change below, as the
+   // table never gets more than half full)
+   vector<IntPtr> address_list;
+   UInt32 num_per_home[4] = {0, 0, 0, 0};
+   UInt32 max_per_home[4] = {6, 4, 3, 3};
+   UInt32 home_list[4] = {capacity - 1, capacity - 2, 0, 1};
+   for (IntPtr i = 1; address_list.size() < 16; i++)
+   {
+      IntPtr address = i << 6;
+      UInt32 home = AddressHashMapTest::getHomeIndex(probe_map, address);
+      for (UInt32 j = 0; j < 4; j++)
+      {
+         if ((home == home_list[j]) && (num_per_home[j] < max_per_home[j]))
+         {
+            num_per_home[j] ++;
+            address_list.push_back(address);
+         }
+      }
+   }
+   // Absent addresses with the same homes
+   vector<IntPtr> probe_address_list(address_list);
+   for (IntPtr i = 1; probe_address_list.size() < 24; i++)
+   {
+      IntPtr address = (i << 6) + 1;
+      UInt32 home = AddressHashMapTest::getHomeIndex(probe_map, address);
+      if ((home == capacity - 1) || (home == 0))
+         probe_address_list.push_back(address);
+   }
+
+   srand(1);
+   for (UInt32 trial = 0; trial < NUM_WRAP_AROUND_TRIALS; trial++)
+   {
+      TestMap test_map(capacity);
+      ReferenceMap reference_map;
+
+      random_shuffle(address_list.begin(), address_list.end());
+      for (UInt32 i = 0; i < address_list.size(); i++)
+         insert(test_map, reference_map, address_list[i], trial * 100 + i);
+      // Duplicate inserts fail
+      insert(test_map, reference_map, address_list[0], 0);
+      checkContents(test_map, reference_map, probe_address_list);
+
+      random_shuffle(address_list.begin(), address_list.end());
+      for (UInt32 i = 0; i < address_list.size(); i++)
+      {
+         erase(test_map, reference_map, address_list[i]);
+         // Erasing an absent address changes nothing
+         erase(test_map, reference_map, address_list[i]);
+         checkContents(test_map, reference_map, probe_address_list);
+
+         // Re-insert some of them while the chain is partly erased
+         if ((rand() % 4) == 0)
+         {
+            UInt32 j = rand() % (i + 1);
+            insert(test_map, reference_map, address_list[j], trial);
+            erase(test_map, reference_map, address_list[j]);
+            checkContents(test_map, reference_map, probe_address_list);
+         }
+      }
+
+      if (AddressHashMapTest::getCapacity(test_map) != capacity)
+      {
+         printf("Capacity changed(%u)\n", AddressHashMapTest::getCapacity(test_map));
+         num_errors ++;
+      }
+   }
+}
+
+// Random inserts/erases over a small set of addresses, starting from the
+// smallest table, so that it grows several times
+void testRandomOperations()
+{
+   vector<IntPtr> address_list;
+   for (UInt32 i = 0; i < NUM_RANDOM_ADDRESSES; i++)
+      address_list.push_back(((IntPtr) i) << 6);
+
+   TestMap test_map(1);
+   ReferenceMap reference_map;
+   UInt32 initial_capacity = AddressHashMapTest::getCapacity(test_map);
+
+   srand(2);
+   for (UInt32 i = 0; i < NUM_RANDOM_OPERATIONS; i++)
+   {
+      // Mostly inserts first (growth), then mostly erases
+      UInt32 insert_percentage = (i < NUM_RANDOM_OPERATIONS / 2) ? 70 : 30;
+      IntPtr address = address_list[rand() % NUM_RANDOM_ADDRESSES];
+      if ((UInt32) (rand() % 100) < insert_percentage)
+      {
+         UInt32 old_capacity = AddressHashMapTest::getCapacity(test_map);
+         insert(test_map, reference_map, address, i);
+         // All the addresses must survive a resize
+         if (AddressHashMapTest::getCapacity(test_map) != old_capacity)
+            checkContents(test_map, reference_map, address_list);
+      }
+      else
+      {
+         erase(test_map, reference_map, address);
+      }
+
+      if ((i % 1000) == 0)
+         checkContents(test_map, reference_map, address_list);
+   }
+   checkContents(test_map, reference_map, address_list);
+
+   if (AddressHashMapTest::getCapacity(test_map) <= initial_capacity)
+   {
+      printf("Table did not grow (capacity %u)\n", AddressHashMapTest::getCapacity(test_map));
+      num_errors ++;
+   }
+}
+
+// Checks AddressHashMap against std::map
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+
+   testWrapAround();
+   testRandomOperations();
+
+   printf("Address Hash Map Test: %s (%u errors)\n", (num_errors == 0) ? "PASSED" : "FAILED", num_errors);
+
+   CarbonStopSim();
+
+   return (num_errors == 0) ? 0 : -1;
+}
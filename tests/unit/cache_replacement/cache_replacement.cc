@@ -0,0 +1,190 @@
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+using std::list;
+using std::vector;
+
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "cache_set.h"
+
+#define ASSOCIATIVITY   8
+#define NUM_TAGS        12
+#define NUM_ACCESSES    100000
+// 4 sets per leader period of DRRIP: a SRRIP leader, a BRRIP leader and 2 followers
+#define NUM_DUELING_SETS   128
+#define NUM_DUELING_LOOPS  100
+
+// Accesses a tag; returns true on a hit
+// Like the cache controllers, a miss fills the line and then accesses it
+bool access(CacheSet* set, IntPtr tag)
+{
+   UInt32 line_index;
+   if (set->find(tag, &line_index))
+   {
+      set->read_line(line_index, 0, NULL, 0);
+      return true;
+   }
+
+   CacheBlockInfo* cache_block_info = CacheBlockInfo::create(CacheBase::PR_L1_CACHE);
+   CacheBlockInfo* evict_block_info = CacheBlockInfo::create(CacheBase::PR_L1_CACHE);
+   cache_block_info->setTag(tag);
+   bool eviction;
+   set->insert(cache_block_info, NULL, &eviction, evict_block_info, NULL);
+   delete cache_block_info;
+   delete evict_block_info;
+
+   set->find(tag, &line_index);
+   set->read_line(line_index, 0, NULL, 0);
+   return false;
+}
+
+// Compares the hits of 'policy' with those of a reference LRU model
+UInt32 checkAgainstLRU(std::string policy, UInt32 associativity)
+{
+   CacheSet* set = CacheSet::createCacheSet(policy, CacheBase::PR_L1_CACHE, associativity, 64, false, 0, NULL);
+   list<IntPtr> lru_list;
+   UInt32 num_errors = 0;
+
+   for (UInt32 i = 0; i < NUM_ACCESSES; i++)
+   {
+      IntPtr tag = rand() % NUM_TAGS;
+
+      // Invalidations are filled first
+      if ((rand() % 100) == 0)
+      {
+         set->invalidate(tag);
+         lru_list.remove(tag);
+         continue;
+      }
+
+      bool lru_hit = false;
+      for (list<IntPtr>::iterator it = lru_list.begin(); it != lru_list.end(); it++)
+      {
+         if (*it == tag)
+         {
+            lru_list.erase(it);
+            lru_hit = true;
+            break;
+         }
+      }
+      if (!lru_hit && (lru_list.size() == associativity))
+         lru_list.pop_back();
+      lru_list.push_front(tag);
+
+      if (access(set, tag) != lru_hit)
+         num_errors ++;
+   }
+
+   delete set;
+   return num_errors;
+}
+
+// Checks that a thrashing loop slightly larger than the set keeps some of its
+// lines with the scan-resistant policies, where LRU never hits
+UInt32 checkThrashing(std::string policy)
+{
+   CacheSet* set = CacheSet::createCacheSet(policy, CacheBase::PR_L1_CACHE, ASSOCIATIVITY, 64, false, 0, NULL);
+   UInt32 num_hits = 0;
+   for (UInt32 i = 0; i < NUM_ACCESSES; i++)
+   {
+      if (access(set, i % (ASSOCIATIVITY + 2)))
+         num_hits ++;
+   }
+   delete set;
+   return num_hits;
+}
+
+// Checks that with DRRIP, the misses of the SRRIP leader sets under a thrashing
+// loop move PSEL to BRRIP, and that the follower sets then keep some of their lines
+UInt32 checkSetDueling()
+{
+   RRIPSetDueling set_dueling(NUM_DUELING_SETS);
+   vector<CacheSet*> set_list;
+   for (UInt32 s = 0; s < NUM_DUELING_SETS; s++)
+      set_list.push_back(CacheSet::createCacheSet("drrip", CacheBase::PR_L1_CACHE, ASSOCIATIVITY, 64, false, s, &set_dueling));
+
+   UInt32 num_errors = 0;
+   if (set_dueling.isBRRIPSelected())
+   {
+      fprintf(stderr, "DRRIP: BRRIP selected before any miss\n");
+      num_errors ++;
+   }
+
+   UInt32 num_follower_hits = 0;
+   for (UInt32 l = 0; l < NUM_DUELING_LOOPS; l++)
+   {
+      for (UInt32 i = 0; i < (ASSOCIATIVITY + 2); i++)
+      {
+         for (UInt32 s = 0; s < NUM_DUELING_SETS; s++)
+         {
+            bool hit = access(set_list[s], i);
+            if (hit && (set_dueling.getRole(s) == RRIPSetDueling::FOLLOWER) && (l >= NUM_DUELING_LOOPS / 2))
+               num_follower_hits ++;
+         }
+      }
+   }
+
+   if (!set_dueling.isBRRIPSelected())
+   {
+      fprintf(stderr, "DRRIP: BRRIP not selected under a thrashing loop\n");
+      num_errors ++;
+   }
+   if (num_follower_hits == 0)
+   {
+      fprintf(stderr, "DRRIP: follower sets thrash\n");
+      num_errors ++;
+   }
+
+   for (UInt32 s = 0; s < NUM_DUELING_SETS; s++)
+      delete set_list[s];
+   return num_errors;
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   srand(1);
+
+   UInt32 num_errors = 0;
+
+   // The same as LRU: LRU itself, and tree-PLRU with 2 ways
+   num_errors += checkAgainstLRU("lru", ASSOCIATIVITY);
+   num_errors += checkAgainstLRU("tree_plru", 2);
+
+   // Fills go to the invalid ways first
+   const char* policies[] = { "round_robin", "lru", "tree_plru", "srrip", "brrip" };
+   for (UInt32 p = 0; p < sizeof(policies) / sizeof(policies[0]); p++)
+   {
+      CacheSet* set = CacheSet::createCacheSet(policies[p], CacheBase::PR_L1_CACHE, ASSOCIATIVITY, 64, false, 0, NULL);
+      for (UInt32 i = 0; i < ASSOCIATIVITY; i++)
+         access(set, i);
+      IntPtr invalidated_tag = ASSOCIATIVITY / 2;
+      set->invalidate(invalidated_tag);
+      access(set, ASSOCIATIVITY);
+      for (UInt32 i = 0; i < ASSOCIATIVITY; i++)
+      {
+         if ((i != invalidated_tag) && !access(set, i))
+         {
+            fprintf(stderr, "Policy(%s): tag(%u) replaced instead of an invalid way\n", policies[p], i);
+            num_errors ++;
+         }
+      }
+      delete set;
+   }
+
+   if (checkThrashing("lru") != 0)
+      num_errors ++;
+   if (checkThrashing("brrip") == 0)
+      num_errors ++;
+   num_errors += checkSetDueling();
+
+   if (num_errors == 0)
+      fprintf(stderr, "cache_replacement test: SUCCESS\n");
+   else
+      fprintf(stderr, "cache_replacement test: FAILURE (%u errors)\n", num_errors);
+
+   CarbonStopSim();
+   return (num_errors == 0) ? 0 : -1;
+}
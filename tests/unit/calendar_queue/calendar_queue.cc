@@ -0,0 +1,73 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "min_heap.h"
+#include "calendar_queue.h"
+
+#define NUM_BUCKETS     64
+#define NUM_OPERATIONS  100000
+
+// Checks that CalendarQueue orders keys the same way as MinHeap
+// Keys are mostly within a few cycles of the last extracted key, with some
+// beyond the calendar window and a few earlier than the window start
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+
+   MinHeap min_heap;
+   CalendarQueue calendar_queue(NUM_BUCKETS);
+   srand(1);
+
+   UInt64 curr_time = 0;
+   UInt32 num_errors = 0;
+   for (UInt32 i = 0; i < NUM_OPERATIONS; i++)
+   {
+      if ((rand() % 3) < 2)
+      {
+         UInt64 key;
+         if ((rand() % 50) == 0)
+            key = curr_time + (rand() % (4 * NUM_BUCKETS));
+         else if (((rand() % 50) == 0) && (curr_time > 10))
+            key = curr_time - (rand() % 10);
+         else
+            key = curr_time + (rand() % 20);
+
+         bool min_heap_top_change = (key < min_heap.min().first);
+         min_heap.insert(key);
+         bool calendar_queue_top_change = calendar_queue.insert(key);
+         if (min_heap_top_change != calendar_queue_top_change)
+         {
+            printf("Insert(%llu): Top Change Mismatch\n", (long long unsigned int) key);
+            num_errors ++;
+         }
+      }
+      else
+      {
+         UInt64 min_heap_key = min_heap.extractMin().first;
+         UInt64 calendar_queue_key = calendar_queue.extractMin().first;
+         if (min_heap_key != calendar_queue_key)
+         {
+            printf("ExtractMin: MinHeap(%llu), CalendarQueue(%llu)\n",
+                  (long long unsigned int) min_heap_key, (long long unsigned int) calendar_queue_key);
+            num_errors ++;
+         }
+         if (min_heap_key != UINT64_MAX_)
+            curr_time = min_heap_key;
+      }
+
+      if (min_heap.size() != calendar_queue.size())
+      {
+         printf("Size Mismatch: MinHeap(%u), CalendarQueue(%u)\n",
+               (UInt32) min_heap.size(), (UInt32) calendar_queue.size());
+         num_errors ++;
+      }
+   }
+
+   printf("Calendar Queue Test: %s (%u errors)\n", (num_errors == 0) ? "PASSED" : "FAILED", num_errors);
+   
+   CarbonStopSim();
+   
+   return (num_errors == 0) ? 0 : -1;
+}
@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <cstdlib>
+#include <pthread.h>
+
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "mpsc_queue.h"
+
+#define NUM_PRODUCERS            8
+#define NUM_ELEMENTS_PER_PRODUCER 200000
+
+class Element : public MPSCQueueNode
+{
+   public:
+      Element(UInt32 producer_id, UInt32 sequence_num)
+         : _producer_id(producer_id), _sequence_num(sequence_num) {}
+
+      UInt32 _producer_id;
+      UInt32 _sequence_num;
+};
+
+MPSCQueue<Element> _queue;
+volatile bool _producers_started = false;
+
+void* producer(void* arg)
+{
+   UInt32 producer_id = (UInt32) (long) arg;
+   while (!_producers_started) ;
+
+   for (UInt32 i = 0; i < NUM_ELEMENTS_PER_PRODUCER; i++)
+      _queue.push(new Element(producer_id, i));
+   return NULL;
+}
+
+// Checks that MPSCQueue delivers every element exactly once and, for each
+// producer, in the order it was pushed, while all producers push concurrently
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+
+   pthread_t threads[NUM_PRODUCERS];
+   for (long i = 0; i < NUM_PRODUCERS; i++)
+      pthread_create(&threads[i], NULL, producer, (void*) i);
+   _producers_started = true;
+
+   UInt32 next_sequence_num[NUM_PRODUCERS] = {0};
+   UInt32 num_popped = 0;
+   UInt32 num_errors = 0;
+   while (num_popped < (NUM_PRODUCERS * NUM_ELEMENTS_PER_PRODUCER))
+   {
+      // NULL while the queue is empty or a producer has not linked its element yet
+      Element* element = _queue.pop();
+      if (element == NULL)
+         continue;
+
+      if ( (element->_producer_id >= NUM_PRODUCERS) ||
+           (element->_sequence_num != next_sequence_num[element->_producer_id]) )
+      {
+         printf("Pop: Producer(%u), Sequence Num(%u): Out of order\n",
+               element->_producer_id, element->_sequence_num);
+         num_errors ++;
+      }
+      else
+      {
+         next_sequence_num[element->_producer_id] ++;
+      }
+      num_popped ++;
+      delete element;
+   }
+
+   for (UInt32 i = 0; i < NUM_PRODUCERS; i++)
+      pthread_join(threads[i], NULL);
+
+   if ((_queue.pop() != NULL) || !_queue.empty())
+   {
+      printf("Queue not empty at the end\n");
+      num_errors ++;
+   }
+
+   if (num_errors == 0)
+      printf("MPSC Queue test: SUCCESS\n");
+   else
+      printf("MPSC Queue test: FAILURE, Num Errors(%u)\n", num_errors);
+
+   CarbonStopSim();
+   return (num_errors == 0) ? 0 : -1;
+}
@@ -126,16 +126,16 @@ int main(int argc, char *argv[])
       finite_buffer_network_model->setNetworkNode(i, network_node);
    }
 
-   list<NetPacket*> input_net_packet_list = createNetPacketList(); 
+   vector<NetPacket*> input_net_packet_list = createNetPacketList(); 
    printNetPacketList(input_net_packet_list, true);
 
-   for (list<NetPacket*>::iterator it = input_net_packet_list.begin();
+   for (vector<NetPacket*>::iterator it = input_net_packet_list.begin();
          it != input_net_packet_list.end(); it ++)
    {
       fprintf(stderr, "\n==============================================================================\n\n");
       printNetPacket(*it, true);
 
-      list<NetPacket*> output_net_packet_list;
+      vector<NetPacket*> output_net_packet_list;
       network_node->processNetPacket(*it, output_net_packet_list);
       
       printNetPacketList(output_net_packet_list);
@@ -149,9 +149,9 @@ int main(int argc, char *argv[])
    return 0;
 }
 
-void printNetPacketList(list<NetPacket*>& net_packet_list, bool is_input_msg)
+void printNetPacketList(vector<NetPacket*>& net_packet_list, bool is_input_msg)
 {
-   for (list<NetPacket*>::iterator it = net_packet_list.begin(); it != net_packet_list.end(); it ++)
+   for (vector<NetPacket*>::iterator it = net_packet_list.begin(); it != net_packet_list.end(); it ++)
       printNetPacket(*it, is_input_msg);
 }
 
@@ -230,9 +230,9 @@ void printNetPacket(NetPacket* net_packet, bool is_input_msg)
    }
 }
 
-list<NetPacket*> createNetPacketList()
+vector<NetPacket*> createNetPacketList()
 {
-   list<NetPacket*> net_packet_list;
+   vector<NetPacket*> net_packet_list;
    UnstructuredBuffer output_endpoints;
 
    // Head Flit - 0 -> [ (0,1), (3,ALL), (4,0) ]
@@ -255,7 +255,7 @@ list<NetPacket*> createNetPacketList()
    return net_packet_list;
 }
 
-void addFlit(list<NetPacket*>& net_packet_list,
+void addFlit(vector<NetPacket*>& net_packet_list,
       Flit::Type flit_type, UInt64 time, SInt32 num_phits,
       Router::Id sender_router_id, Router::Id receiver_router_id,
       SInt32 num_output_endpoints, UnstructuredBuffer* output_endpoints_ptr)
@@ -301,7 +301,7 @@ void addFlit(list<NetPacket*>& net_packet_list,
    net_packet_list.push_back(net_packet);
 }
 
-void addCreditMsg(list<NetPacket*>& net_packet_list,
+void addCreditMsg(vector<NetPacket*>& net_packet_list,
       UInt64 time, SInt32 num_credits,
       Router::Id sender_router_id, Router::Id receiver_router_id)
 {
@@ -317,7 +317,7 @@ void addCreditMsg(list<NetPacket*>& net_packet_list,
    net_packet_list.push_back(net_packet);
 }
 
-void addOnOffMsg(list<NetPacket*>& net_packet_list,
+void addOnOffMsg(vector<NetPacket*>& net_packet_list,
       UInt64 time, bool on_off_status,
       Router::Id sender_router_id, Router::Id receiver_router_id)
 {
@@ -333,9 +333,9 @@ void addOnOffMsg(list<NetPacket*>& net_packet_list,
    net_packet_list.push_back(net_packet);
 }
 
-void destroyNetPacketList(list<NetPacket*>& net_packet_list)
+void destroyNetPacketList(vector<NetPacket*>& net_packet_list)
 {
-   for (list<NetPacket*>::iterator it = net_packet_list.begin(); it != net_packet_list.end(); it ++)
+   for (vector<NetPacket*>::iterator it = net_packet_list.begin(); it != net_packet_list.end(); it ++)
       destroyNetPacket(*it);
 }
 
@@ -54,13 +54,11 @@ void initiateMemoryAccess(UInt64 time, UInt32 access_id)
    if (mem_op_type == Core::WRITE)
       *((UInt32*) buf) = value;
 
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << core
-                 << access_id
-                 << MemComponent::L1_DCACHE << Core::NONE << mem_op_type
-                 << address << buf << size
-                 << true;
-   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(time, event_args);
+   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(time,
+                                                                    core, access_id,
+                                                                    MemComponent::L1_DCACHE, Core::NONE, mem_op_type,
+                                                                    address, buf, size,
+                                                                    true);
    Event::processInOrder(event, core->getId(), EventQueue::ORDERED);
 }
 
@@ -96,13 +96,11 @@ void initializeMemory()
    Core* core = Sim()->getCoreManager()->getCoreFromID(0);
    assert(core);
 
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << core
-                 << 0
-                 << MemComponent::L1_DCACHE << Core::NONE << Core::WRITE
-                 << _address << buf << size
-                 << true;
-   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(0, event_args);
+   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(0,
+                                                                    core, 0,
+                                                                    MemComponent::L1_DCACHE, Core::NONE, Core::WRITE,
+                                                                    _address, buf, size,
+                                                                    true);
    Event::processInOrder(event, 0, EventQueue::ORDERED);
 }
 
@@ -124,13 +122,11 @@ void checkResult()
    Core* core = Sim()->getCoreManager()->getCoreFromID(0);
    assert(core);
 
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << core
-                 << 1
-                 << MemComponent::L1_DCACHE << Core::NONE << Core::READ
-                 << _address << buf << size
-                 << true;
-   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(_max_time, event_args);
+   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(_max_time,
+                                                                    core, 1,
+                                                                    MemComponent::L1_DCACHE, Core::NONE, Core::READ,
+                                                                    _address, buf, size,
+                                                                    true);
    Event::processInOrder(event, 0, EventQueue::ORDERED);
 }
 
@@ -170,13 +166,11 @@ void initiateMemoryAccess(Core* core, UInt64 time, UInt32 access_id)
    Byte* buf = (Byte*) &_buf_list[core->getId()];
    UInt32 size = sizeof(_buf_list[core->getId()]);
 
-   UnstructuredBuffer* event_args = new UnstructuredBuffer();
-   (*event_args) << core
-                 << access_id
-                 << MemComponent::L1_DCACHE << lock_signal << mem_op_type
-                 << _address << buf << size
-                 << true;
-   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(time, event_args);
+   EventInitiateMemoryAccess* event = new EventInitiateMemoryAccess(time,
+                                                                    core, access_id,
+                                                                    MemComponent::L1_DCACHE, lock_signal, mem_op_type,
+                                                                    _address, buf, size,
+                                                                    true);
    Event::processInOrder(event, core->getId(), EventQueue::ORDERED);
 }
 
@@ -0,0 +1,158 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "tag_search.h"
+
+#define MAX_NUM_TAGS       64
+#define NUM_RANDOM_TRIALS  20
+
+UInt32 num_errors = 0;
+
+UInt32 scalarMatchTags(const IntPtr* tags, UInt32 num_tags, IntPtr tag)
+{
+   UInt32 mask = 0;
+   for (UInt32 i = 0; i < num_tags; i++)
+   {
+      if (tags[i] == tag)
+         mask |= (1U << i);
+   }
+   return mask;
+}
+
+SInt32 scalarFindFirstTag(const IntPtr* tags, UInt32 num_tags, IntPtr tag)
+{
+   for (UInt32 i = 0; i < num_tags; i++)
+   {
+      if (tags[i] == tag)
+         return i;
+   }
+   return -1;
+}
+
+SInt32 scalarFindLastTag(const IntPtr* tags, UInt32 num_tags, IntPtr tag)
+{
+   for (SInt32 i = num_tags - 1; i >= 0; i--)
+   {
+      if (tags[i] == tag)
+         return i;
+   }
+   return -1;
+}
+
+// Tag that differs from 'tag' in only one half (upper or lower 32 bits if
+// pointers are 64 bits wide), to catch compares that check only part of a tag
+IntPtr getNearMissTag(IntPtr tag)
+{
+   IntPtr flip_bits = (sizeof(IntPtr) == 8) ? (((rand() % 2) == 0) ? 0x1 : (IntPtr) (((UInt64) 1) << 32)) : 0x1;
+   return tag ^ (flip_bits << (rand() % 16));
+}
+
+void checkSearch(const IntPtr* tags, UInt32 num_tags, IntPtr tag, const char* pattern)
+{
+   if (num_tags <= 32)
+   {
+      UInt32 mask = matchTags(tags, num_tags, tag);
+      UInt32 scalar_mask = scalarMatchTags(tags, num_tags, tag);
+      if (mask != scalar_mask)
+      {
+         printf("matchTags(%u tags, %s): %#x, Expected(%#x)\n", num_tags, pattern, mask, scalar_mask);
+         num_errors ++;
+      }
+   }
+
+   SInt32 first = findFirstTag(tags, num_tags, tag);
+   SInt32 scalar_first = scalarFindFirstTag(tags, num_tags, tag);
+   if (first != scalar_first)
+   {
+      printf("findFirstTag(%u tags, %s): %i, Expected(%i)\n", num_tags, pattern, first, scalar_first);
+      num_errors ++;
+   }
+
+   SInt32 last = findLastTag(tags, num_tags, tag);
+   SInt32 scalar_last = scalarFindLastTag(tags, num_tags, tag);
+   if (last != scalar_last)
+   {
+      printf("findLastTag(%u tags, %s): %i, Expected(%i)\n", num_tags, pattern, last, scalar_last);
+      num_errors ++;
+   }
+}
+
+// Fills 'tags' with tags that do not match 'tag' (half of them near misses),
+// then sets the tags at 'match_list' to 'tag'
+void fillTags(IntPtr* tags, UInt32 num_tags, IntPtr tag, const vector<UInt32>& match_list)
+{
+   for (UInt32 i = 0; i < num_tags; i++)
+      tags[i] = ((rand() % 2) == 0) ? getNearMissTag(tag) : (tag + 1 + (rand() % 1000));
+   for (UInt32 i = 0; i < match_list.size(); i++)
+      tags[match_list[i]] = tag;
+}
+
+// Checks matchTags (up to 32 tags), findFirstTag and findLastTag against a
+// scalar loop for every number of tags from 1 to MAX_NUM_TAGS, with the
+// matching tags in the first, middle and last positions, several matches,
+// and no match. The tags start at an odd offset too (unaligned vector loads)
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+
+   srand(1);
+   IntPtr tag_array[MAX_NUM_TAGS + 1];
+
+   for (UInt32 offset = 0; offset < 2; offset++)
+   {
+      IntPtr* tags = tag_array + offset;
+      for (UInt32 num_tags = 1; num_tags <= MAX_NUM_TAGS; num_tags++)
+      {
+         IntPtr tag = (((IntPtr) rand()) << 6) ^ (IntPtr) (((UInt64) rand()) << 32);
+         vector<UInt32> match_list;
+
+         fillTags(tags, num_tags, tag, match_list);
+         checkSearch(tags, num_tags, tag, "none");
+
+         match_list.assign(1, 0);
+         fillTags(tags, num_tags, tag, match_list);
+         checkSearch(tags, num_tags, tag, "first");
+
+         match_list.assign(1, num_tags - 1);
+         fillTags(tags, num_tags, tag, match_list);
+         checkSearch(tags, num_tags, tag, "last");
+
+         match_list.assign(1, num_tags / 2);
+         fillTags(tags, num_tags, tag, match_list);
+         checkSearch(tags, num_tags, tag, "middle");
+
+         match_list.clear();
+         match_list.push_back(0);
+         match_list.push_back(num_tags - 1);
+         fillTags(tags, num_tags, tag, match_list);
+         checkSearch(tags, num_tags, tag, "first and last");
+
+         for (UInt32 trial = 0; trial < NUM_RANDOM_TRIALS; trial++)
+         {
+            match_list.clear();
+            UInt32 num_matches = 1 + (rand() % 4);
+            for (UInt32 i = 0; i < num_matches; i++)
+               match_list.push_back(rand() % num_tags);
+            fillTags(tags, num_tags, tag, match_list);
+            checkSearch(tags, num_tags, tag, "multiple");
+         }
+
+         // All tags match
+         match_list.clear();
+         for (UInt32 i = 0; i < num_tags; i++)
+            match_list.push_back(i);
+         fillTags(tags, num_tags, tag, match_list);
+         checkSearch(tags, num_tags, tag, "all");
+      }
+   }
+
+   printf("Tag Search Test: %s (%u errors)\n", (num_errors == 0) ? "PASSED" : "FAILED", num_errors);
+
+   CarbonStopSim();
+
+   return (num_errors == 0) ? 0 : -1;
+}